@@ -0,0 +1,389 @@
+/**
+ *  @ingroup    MemoryManagement
+ *  @addtogroup MemoryBenchmark MEM_bench
+ *  @{
+ *
+ *  @package    MEM_bench
+ *  @brief      Per-operation latency benchmark of the allocation strategies.
+ *
+ *  @file       bench_latency.c
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              Runs the same randomized malloc/free workload against every allocation strategy
+ *              and times each MEM_allocatorMalloc and MEM_allocatorFree call individually. The
+ *              report lists the p50, p99, p999 and worst-case latency of both operations, which
+ *              is what matters for soft-real-time users of the allocator.
+ *
+ *  @note
+ *              - Usage: bench_latency [operations] [live_slots]
+ *              - Debug output of the allocator is discarded while a strategy runs, the report is
+ *                printed once every strategy has finished.
+ *
+ *  @see        - libmemalloc.h
+ **/
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include <libmemalloc.h>
+
+/* =================================
+ *          PRIVATE DEFINES        *
+ * ================================*/
+
+/**
+ * @def BENCH_DEFAULT_OPERATIONS
+ * @package MEM_bench
+ *
+ * @brief Default number of timed operations per strategy.
+ */
+#define BENCH_DEFAULT_OPERATIONS (20000UL)
+
+/**
+ * @def BENCH_DEFAULT_SLOTS
+ * @package MEM_bench
+ *
+ * @brief Default number of slots that may hold a live allocation at the same time.
+ */
+#define BENCH_DEFAULT_SLOTS (1024UL)
+
+/**
+ * @def BENCH_MIN_SIZE
+ * @package MEM_bench
+ *
+ * @brief Smallest request size of the workload, in bytes.
+ */
+#define BENCH_MIN_SIZE (16UL)
+
+/**
+ * @def BENCH_MAX_SIZE
+ * @package MEM_bench
+ *
+ * @brief Largest request size of the workload, in bytes.
+ */
+#define BENCH_MAX_SIZE (512UL)
+
+/* =================================
+ *     PRIVATE DATA STRUCTURES     *
+ * ================================*/
+
+/**
+ * @struct  bench_result
+ * @package MEM_bench
+ *
+ * @typedef bench_result_t
+ *
+ * @brief   Latency percentiles of one operation type, in nanoseconds.
+ */
+typedef struct bench_result
+{
+    uint64_t p50;                                       /**< Median latency */
+    uint64_t p99;                                       /**< 99th percentile latency */
+    uint64_t p999;                                      /**< 99.9th percentile latency */
+    uint64_t max;                                       /**< Worst observed latency */
+    size_t samples;                                     /**< Number of timed operations */
+} bench_result_t;
+
+/* =================================
+ *     PRIVATE GLOBAL VARIABLE     *
+ * ================================*/
+
+/**
+ * @var     strategies
+ * @package MEM_bench
+ *
+ * @brief   Strategies exercised by the benchmark, in report order.
+ */
+static const allocation_strategy_t strategies[] = { FIRST_FIT, NEXT_FIT, BEST_FIT, SEGREGATED_FIT, TLSF_FIT };
+
+/**
+ * @var     strategy_names
+ * @package MEM_bench
+ *
+ * @brief   Printable names matching the strategies table.
+ */
+static const char *strategy_names[] = { "FIRST_FIT", "NEXT_FIT", "BEST_FIT", "SEGREGATED_FIT", "TLSF_FIT" };
+
+/* =================================
+ *   PRIVATE FUNCTION DEFINITION   *
+ * ================================*/
+
+/**
+ * @fn      BENCH_nowNs
+ * @package MEM_bench
+ *
+ * @brief   Reads the monotonic clock.
+ *
+ * @return  Current monotonic time in nanoseconds.
+ */
+static uint64_t BENCH_nowNs(void)
+{
+    /* Definition of Function Variables */
+    struct timespec ts;
+
+    /* Start Function Logic */
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    /* Function Return */
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @fn      BENCH_nextRandom
+ * @package MEM_bench
+ *
+ * @brief   Advances a xorshift64 generator.
+ *
+ * @param   [in/out] state Generator state, must not be zero.
+ *
+ * @return  Next pseudo-random value.
+ */
+static uint64_t BENCH_nextRandom(uint64_t *state)
+{
+    /* Start Function Logic */
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    /* Function Return */
+    return *state;
+}
+
+/**
+ * @fn      BENCH_compareU64
+ * @package MEM_bench
+ *
+ * @brief   qsort comparator for uint64_t samples.
+ */
+static int BENCH_compareU64(const void *lhs, const void *rhs)
+{
+    /* Definition of Function Variables */
+    uint64_t a = *(const uint64_t *)lhs;
+    uint64_t b = *(const uint64_t *)rhs;
+
+    /* Function Return */
+    return (a > b) - (a < b);
+}
+
+/**
+ * @fn      BENCH_summarize
+ * @package MEM_bench
+ *
+ * @brief   Sorts latency samples and extracts their percentiles.
+ *
+ * @param   [in/out] samples Latency samples, sorted in place.
+ * @param   [in]     count   Number of samples.
+ * @param   [out]    result  Percentiles of the samples.
+ */
+static void BENCH_summarize(uint64_t *samples, size_t count, bench_result_t *result)
+{
+    /* Assigning Initial Values for Variables */
+    memset(result, 0, sizeof(*result));
+    result->samples = count;
+
+    /* Check deference/argument boundaries */
+    if (count == 0u)
+    {
+        return;
+    }
+
+    /* Start Function Logic */
+    qsort(samples, count, sizeof(uint64_t), BENCH_compareU64);
+
+    result->p50     = samples[(count * 500u) / 1000u];
+    result->p99     = samples[(count * 990u) / 1000u];
+    result->p999    = samples[(count * 999u) / 1000u];
+    result->max     = samples[count - 1u];
+}
+
+/**
+ * @fn      BENCH_runStrategy
+ * @package MEM_bench
+ *
+ * @brief   Runs the randomized workload against one strategy.
+ *
+ * @details Picks a random slot per operation: an occupied slot is freed, an empty one gets
+ *          a new allocation of random size. Allocations that fail are counted but not timed.
+ *
+ * @param   [in]  strategy    Strategy under test.
+ * @param   [in]  operations  Number of operations to perform.
+ * @param   [in]  slot_count  Number of live-allocation slots.
+ * @param   [out] malloc_res  Percentiles of MEM_allocatorMalloc.
+ * @param   [out] free_res    Percentiles of MEM_allocatorFree.
+ * @param   [out] failures    Number of failed allocations.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int BENCH_runStrategy(allocation_strategy_t strategy, size_t operations, size_t slot_count,
+                             bench_result_t *malloc_res, bench_result_t *free_res, size_t *failures)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0;
+
+    mem_allocator_t allocator;
+
+    void **slots            = NULL;
+    uint64_t *malloc_ns     = NULL;
+    uint64_t *free_ns       = NULL;
+
+    size_t malloc_count     = 0u;
+    size_t free_count       = 0u;
+    size_t op               = 0u;
+    size_t slot             = 0u;
+    size_t size             = 0u;
+
+    uint64_t rng            = 0x9E3779B97F4A7C15ULL;
+    uint64_t start          = 0u;
+
+    /* Assigning Initial Values for Variables */
+    *failures   = 0u;
+    slots       = calloc(slot_count, sizeof(void *));
+    malloc_ns   = calloc(operations, sizeof(uint64_t));
+    free_ns     = calloc(operations, sizeof(uint64_t));
+
+    if (slots == NULL || malloc_ns == NULL || free_ns == NULL)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    ret = MEM_allocatorInit(&allocator);
+    if (ret != 0)
+    {
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    for (op = 0u; op < operations; ++op)
+    {
+        slot = (size_t)(BENCH_nextRandom(&rng) % slot_count);
+
+        if (slots[slot] != NULL)
+        {
+            start = BENCH_nowNs();
+            MEM_allocatorFree(&allocator, slots[slot], __FILE__, __LINE__, "slot");
+            free_ns[free_count++] = BENCH_nowNs() - start;
+
+            slots[slot] = NULL;
+            continue;
+        }
+
+        size = BENCH_MIN_SIZE + (size_t)(BENCH_nextRandom(&rng) % (BENCH_MAX_SIZE - BENCH_MIN_SIZE + 1u));
+
+        start = BENCH_nowNs();
+        slots[slot] = MEM_allocatorMalloc(&allocator, size, __FILE__, __LINE__, "slot", strategy);
+
+        if (slots[slot] == NULL)
+        {
+            ++(*failures);
+            continue;
+        }
+
+        malloc_ns[malloc_count++] = BENCH_nowNs() - start;
+    }
+
+    BENCH_summarize(malloc_ns, malloc_count, malloc_res);
+    BENCH_summarize(free_ns, free_count, free_res);
+
+    /* Function Return */
+end_of_function:
+    free(slots);
+    free(malloc_ns);
+    free(free_ns);
+
+    return ret;
+}
+
+/**
+ * @fn      main
+ * @package MEM_bench
+ *
+ * @brief   Benchmark entry point.
+ *
+ * @param   [in] argc Argument count.
+ * @param   [in] argv Optional operation count and slot count.
+ *
+ * @return  0 on success, 1 on failure.
+ */
+int main(int argc, char **argv)
+{
+    /* Definition of Function Variables */
+    int ret                     = 0;
+
+    size_t operations           = BENCH_DEFAULT_OPERATIONS;
+    size_t slot_count           = BENCH_DEFAULT_SLOTS;
+    size_t failures[sizeof(strategies) / sizeof(strategies[0])];
+    size_t index                = 0u;
+
+    bench_result_t malloc_res[sizeof(strategies) / sizeof(strategies[0])];
+    bench_result_t free_res[sizeof(strategies) / sizeof(strategies[0])];
+
+    /* Check deference/argument boundaries */
+    if (argc > 1)
+    {
+        operations = (size_t)strtoul(argv[1], NULL, 10);
+    }
+
+    if (argc > 2)
+    {
+        slot_count = (size_t)strtoul(argv[2], NULL, 10);
+    }
+
+    if (operations == 0u || slot_count == 0u)
+    {
+        fprintf(stderr, "usage: %s [operations] [live_slots]\n", argv[0]);
+        return 1;
+    }
+
+    /* Assigning Initial Values for Variables */
+    MEM_logSetHook(NULL, NULL);
+
+    /* Start Function Logic */
+    for (index = 0u; index < sizeof(strategies) / sizeof(strategies[0]); ++index)
+    {
+        ret |= BENCH_runStrategy(strategies[index], operations, slot_count,
+                                 &malloc_res[index], &free_res[index], &failures[index]);
+    }
+
+    MEM_logSetHook(MEM_logStdio, NULL);
+
+    if (ret != 0)
+    {
+        fprintf(stderr, "bench_latency: benchmark setup failed\n");
+        return 1;
+    }
+
+    printf("Latency benchmark: %zu operations, %zu live slots, sizes %lu..%lu bytes, heap %lu bytes\n",
+           operations, slot_count, BENCH_MIN_SIZE, BENCH_MAX_SIZE, (unsigned long)HEAP_SIZE);
+    printf("%-16s %-6s %10s %10s %10s %10s %10s %8s\n",
+           "Strategy", "Op", "Samples", "p50(ns)", "p99(ns)", "p999(ns)", "max(ns)", "Failed");
+
+    for (index = 0u; index < sizeof(strategies) / sizeof(strategies[0]); ++index)
+    {
+        printf("%-16s %-6s %10zu %10llu %10llu %10llu %10llu %8zu\n",
+               strategy_names[index], "malloc", malloc_res[index].samples,
+               (unsigned long long)malloc_res[index].p50, (unsigned long long)malloc_res[index].p99,
+               (unsigned long long)malloc_res[index].p999, (unsigned long long)malloc_res[index].max,
+               failures[index]);
+        printf("%-16s %-6s %10zu %10llu %10llu %10llu %10llu %8s\n",
+               strategy_names[index], "free", free_res[index].samples,
+               (unsigned long long)free_res[index].p50, (unsigned long long)free_res[index].p99,
+               (unsigned long long)free_res[index].p999, (unsigned long long)free_res[index].max,
+               "-");
+    }
+
+    /* Function Return */
+    return 0;
+}
+
+/*** end of file ***/
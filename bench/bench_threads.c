@@ -0,0 +1,1026 @@
+/**
+ *  @ingroup    MemoryManagement
+ *  @addtogroup MemoryBenchmark MEM_bench
+ *  @{
+ *
+ *  @package    MEM_bench
+ *  @brief      Multi-threaded scalability and contention benchmark of the thread-safe modes.
+ *
+ *  @file       bench_threads.c
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              Runs three allocation patterns with 1, 2, 4 and up to N threads. In the local
+ *              pattern each thread frees only what it allocated. In the cross-thread pattern
+ *              each thread hands every block to the next thread, which frees it. In the
+ *              shared-pool pattern all threads swap blocks in and out of one table of slots.
+ *              Each pattern runs against one thread-safe allocator (thread cache and
+ *              remote-free list), against an arena set with one arena per thread, and against
+ *              the process malloc. For each run the report lists the throughput, the scaling
+ *              over one thread, the heap lock acquisitions per operation, the share of them
+ *              that had to wait, the frees drained from remote-free lists and the peak RSS.
+ *
+ *  @note
+ *              - Usage: bench_threads [operations_per_thread] [max_threads]
+ *              - max_threads defaults to the number of online CPUs, and at least 4 so the
+ *                cross-thread paths always run with several threads.
+ *              - Peak RSS is reset through /proc/self/clear_refs before each run. Where that
+ *                is not available, it is the peak of the whole process so far.
+ *              - `make tsan` builds this benchmark in the debug configuration with
+ *                -fsanitize=thread and runs it with short parameters.
+ *
+ *  @see        - libmemalloc.h
+ **/
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include <libmemalloc.h>
+
+/* =================================
+ *          PRIVATE DEFINES        *
+ * ================================*/
+
+/**
+ * @def BENCH_DEFAULT_OPERATIONS
+ * @package MEM_bench
+ *
+ * @brief Default number of malloc and free calls per thread and run.
+ */
+#define BENCH_DEFAULT_OPERATIONS (100000UL)
+
+/**
+ * @def BENCH_MIN_THREADS
+ * @package MEM_bench
+ *
+ * @brief Smallest default for the highest thread count.
+ */
+#define BENCH_MIN_THREADS (4UL)
+
+/**
+ * @def BENCH_MAX_THREADS
+ * @package MEM_bench
+ *
+ * @brief Highest thread count accepted.
+ */
+#define BENCH_MAX_THREADS (64UL)
+
+/**
+ * @def BENCH_LOCAL_SLOTS
+ * @package MEM_bench
+ *
+ * @brief Slots that may hold a live allocation in each thread of the local pattern.
+ */
+#define BENCH_LOCAL_SLOTS (256UL)
+
+/**
+ * @def BENCH_RING_SIZE
+ * @package MEM_bench
+ *
+ * @brief Capacity of the hand-off ring of the cross-thread pattern, a power of two.
+ */
+#define BENCH_RING_SIZE (256UL)
+
+/**
+ * @def BENCH_POOL_SLOTS
+ * @package MEM_bench
+ *
+ * @brief Slots of the table shared by every thread in the shared-pool pattern.
+ */
+#define BENCH_POOL_SLOTS (4096UL)
+
+/**
+ * @def BENCH_MIN_SIZE
+ * @package MEM_bench
+ *
+ * @brief Smallest request, in bytes.
+ */
+#define BENCH_MIN_SIZE (16UL)
+
+/**
+ * @def BENCH_MAX_SIZE
+ * @package MEM_bench
+ *
+ * @brief Largest request, in bytes.
+ */
+#define BENCH_MAX_SIZE (512UL)
+
+/* =================================
+ *     PRIVATE DATA STRUCTURES     *
+ * ================================*/
+
+/**
+ * @enum    bench_backend
+ * @package MEM_bench
+ *
+ * @typedef bench_backend_t
+ *
+ * @brief   Allocators under test.
+ */
+typedef enum
+{
+    BENCH_SHARED    = (uint8_t)(0u),                    /**< One thread-safe mem_allocator_t */
+    BENCH_ARENAS    = (uint8_t)(1u),                    /**< A mem_arena_set_t with one arena per thread */
+    BENCH_LIBC      = (uint8_t)(2u)                     /**< The process malloc */
+} bench_backend_t;
+
+/**
+ * @enum    bench_pattern
+ * @package MEM_bench
+ *
+ * @typedef bench_pattern_t
+ *
+ * @brief   Allocation patterns run by every thread.
+ */
+typedef enum
+{
+    BENCH_LOCAL     = (uint8_t)(0u),                    /**< Each thread frees what it allocated */
+    BENCH_REMOTE    = (uint8_t)(1u),                    /**< Each block is freed by the next thread */
+    BENCH_POOL      = (uint8_t)(2u)                     /**< Blocks move through a table shared by all threads */
+} bench_pattern_t;
+
+/**
+ * @struct  bench_ring
+ * @package MEM_bench
+ *
+ * @typedef bench_ring_t
+ *
+ * @brief   Single-producer, single-consumer ring handing blocks to the next thread.
+ */
+typedef struct bench_ring
+{
+    _Alignas(MEM_CACHE_LINE_SIZE) size_t head;          /**< Next slot to pop, written by the consumer */
+    _Alignas(MEM_CACHE_LINE_SIZE) size_t tail;          /**< Next slot to push, written by the producer */
+    void *slots[BENCH_RING_SIZE];                       /**< Blocks in flight */
+} bench_ring_t;
+
+/**
+ * @struct  bench_thread
+ * @package MEM_bench
+ *
+ * @typedef bench_thread_t
+ *
+ * @brief   State of one benchmark thread.
+ */
+typedef struct bench_thread
+{
+    pthread_t thread;                                   /**< Thread handle */
+    size_t index;                                       /**< Position of the thread in the run */
+    uint64_t seed;                                      /**< Generator state, never zero */
+
+    uint64_t start_ns;                                  /**< Time the thread was released */
+    uint64_t end_ns;                                    /**< Time the thread finished its pattern */
+    uint64_t operations;                                /**< Malloc and free calls made */
+    size_t failures;                                    /**< Allocations that returned NULL */
+    int done;                                           /**< Set once the thread pushes no more blocks */
+
+    bench_ring_t inbox;                                 /**< Blocks handed over by the previous thread */
+} bench_thread_t;
+
+/**
+ * @struct  bench_result
+ * @package MEM_bench
+ *
+ * @typedef bench_result_t
+ *
+ * @brief   Measurements of one backend, pattern and thread count.
+ */
+typedef struct bench_result
+{
+    double ops_per_sec;                                 /**< Malloc and free calls per second of wall time */
+    double locks_per_op;                                /**< Heap lock acquisitions per call, negative if unknown */
+    double contended;                                   /**< Share of lock acquisitions that waited */
+    uint64_t remote_frees;                              /**< Frees drained from remote-free lists */
+    long peak_rss_kb;                                   /**< Peak resident set size during the run, in KB */
+    size_t failures;                                    /**< Allocations that returned NULL */
+} bench_result_t;
+
+/* =================================
+ *     PRIVATE GLOBAL VARIABLE     *
+ * ================================*/
+
+/**
+ * @var     backend_names
+ * @package MEM_bench
+ *
+ * @brief   Printable names of the backends, indexed by bench_backend_t.
+ */
+static const char *backend_names[] = { "thread-safe", "arena set", "libc malloc" };
+
+/**
+ * @var     pattern_names
+ * @package MEM_bench
+ *
+ * @brief   Printable names of the patterns, indexed by bench_pattern_t.
+ */
+static const char *pattern_names[] = { "local", "cross-thread free", "shared pool" };
+
+/**
+ * @var     bench_allocator
+ * @package MEM_bench
+ *
+ * @brief   Allocator of the BENCH_SHARED backend.
+ */
+static mem_allocator_t bench_allocator;
+
+/**
+ * @var     bench_arenas
+ * @package MEM_bench
+ *
+ * @brief   Arena set of the BENCH_ARENAS backend.
+ */
+static mem_arena_set_t bench_arenas;
+
+/**
+ * @var     bench_backend
+ * @package MEM_bench
+ *
+ * @brief   Backend of the current run.
+ */
+static bench_backend_t bench_backend;
+
+/**
+ * @var     bench_pattern
+ * @package MEM_bench
+ *
+ * @brief   Pattern of the current run, its thread count and its calls per thread.
+ */
+static bench_pattern_t bench_pattern;
+static size_t bench_thread_count;
+static size_t bench_operations;
+
+/**
+ * @var     bench_start
+ * @package MEM_bench
+ *
+ * @brief   Barrier releasing the threads of a run together.
+ */
+static pthread_barrier_t bench_start;
+
+/**
+ * @var     bench_threads
+ * @package MEM_bench
+ *
+ * @brief   State of the threads of the current run.
+ */
+static bench_thread_t bench_threads[BENCH_MAX_THREADS];
+
+/**
+ * @var     bench_pool
+ * @package MEM_bench
+ *
+ * @brief   Slots shared by every thread in the shared-pool pattern.
+ */
+static void *bench_pool[BENCH_POOL_SLOTS];
+
+/* =================================
+ *   PRIVATE FUNCTION DEFINITION   *
+ * ================================*/
+
+/**
+ * @fn      BENCH_nowNs
+ * @package MEM_bench
+ *
+ * @brief   Reads the monotonic clock.
+ *
+ * @return  Current time in nanoseconds.
+ */
+static uint64_t BENCH_nowNs(void)
+{
+    /* Definition of Function Variables */
+    struct timespec ts;
+
+    /* Start Function Logic */
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    /* Function Return */
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @fn      BENCH_nextRandom
+ * @package MEM_bench
+ *
+ * @brief   Advances a xorshift64 generator.
+ *
+ * @param   [in/out] state Generator state, must not be zero.
+ *
+ * @return  Next pseudo-random value.
+ */
+static uint64_t BENCH_nextRandom(uint64_t *state)
+{
+    /* Start Function Logic */
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    /* Function Return */
+    return *state;
+}
+
+/**
+ * @fn      BENCH_randomSize
+ * @package MEM_bench
+ *
+ * @brief   Draws a request size between BENCH_MIN_SIZE and BENCH_MAX_SIZE.
+ *
+ * @param   [in/out] state Generator state.
+ *
+ * @return  Size in bytes.
+ */
+static size_t BENCH_randomSize(uint64_t *state)
+{
+    /* Function Return */
+    return BENCH_MIN_SIZE + (size_t)(BENCH_nextRandom(state) % (BENCH_MAX_SIZE - BENCH_MIN_SIZE + 1u));
+}
+
+/**
+ * @fn      BENCH_malloc
+ * @package MEM_bench
+ *
+ * @brief   Allocates from the backend of the current run.
+ *
+ * @param   [in] size Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory, or NULL on failure.
+ */
+static void *BENCH_malloc(size_t size)
+{
+    /* Definition of Function Variables */
+    void *ptr = NULL;
+
+    /* Start Function Logic */
+    switch (bench_backend)
+    {
+        case BENCH_SHARED:
+            ptr = MEM_allocatorMallocTlsfFit(&bench_allocator, size);
+            break;
+        case BENCH_ARENAS:
+            ptr = MEM_arenaSetMalloc(&bench_arenas, size, __FILE__, __LINE__, "block", TLSF_FIT);
+            break;
+        default:
+            ptr = malloc(size);
+            break;
+    }
+
+    /* Function Return */
+    return ptr;
+}
+
+/**
+ * @fn      BENCH_free
+ * @package MEM_bench
+ *
+ * @brief   Frees a block of the backend of the current run.
+ *
+ * @param   [in] ptr Pointer returned by BENCH_malloc.
+ */
+static void BENCH_free(void *ptr)
+{
+    /* Start Function Logic */
+    switch (bench_backend)
+    {
+        case BENCH_SHARED:
+            (void)MEM_allocatorFree(&bench_allocator, ptr, __FILE__, __LINE__, "block");
+            break;
+        case BENCH_ARENAS:
+            (void)MEM_arenaSetFree(&bench_arenas, ptr, __FILE__, __LINE__, "block");
+            break;
+        default:
+            free(ptr);
+            break;
+    }
+}
+
+/**
+ * @fn      BENCH_ringPush
+ * @package MEM_bench
+ *
+ * @brief   Hands a block to the consumer of a ring.
+ *
+ * @param   [in/out] ring Ring of the next thread.
+ * @param   [in]     ptr  Block to hand over.
+ *
+ * @return  Non-zero when the block was queued, 0 when the ring is full.
+ */
+static int BENCH_ringPush(bench_ring_t *ring, void *ptr)
+{
+    /* Definition of Function Variables */
+    size_t tail = 0u;
+
+    /* Assigning Initial Values for Variables */
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+
+    /* Start Function Logic */
+    if (tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == BENCH_RING_SIZE)
+    {
+        return 0;
+    }
+
+    ring->slots[tail & (BENCH_RING_SIZE - 1u)] = ptr;
+    __atomic_store_n(&ring->tail, tail + 1u, __ATOMIC_RELEASE);
+
+    /* Function Return */
+    return 1;
+}
+
+/**
+ * @fn      BENCH_ringDrain
+ * @package MEM_bench
+ *
+ * @brief   Frees every block queued on the calling thread's ring.
+ *
+ * @param   [in/out] self State of the calling thread.
+ */
+static void BENCH_ringDrain(bench_thread_t *self)
+{
+    /* Definition of Function Variables */
+    size_t head = 0u;
+    size_t tail = 0u;
+
+    /* Assigning Initial Values for Variables */
+    head = __atomic_load_n(&self->inbox.head, __ATOMIC_RELAXED);
+    tail = __atomic_load_n(&self->inbox.tail, __ATOMIC_ACQUIRE);
+
+    /* Start Function Logic */
+    for (; head != tail; ++head)
+    {
+        BENCH_free(self->inbox.slots[head & (BENCH_RING_SIZE - 1u)]);
+        self->operations++;
+    }
+
+    __atomic_store_n(&self->inbox.head, head, __ATOMIC_RELEASE);
+}
+
+/**
+ * @fn      BENCH_runLocal
+ * @package MEM_bench
+ *
+ * @brief   Allocates and frees at random over slots private to the thread.
+ *
+ * @param   [in/out] self State of the calling thread.
+ */
+static void BENCH_runLocal(bench_thread_t *self)
+{
+    /* Definition of Function Variables */
+    void *slots[BENCH_LOCAL_SLOTS];
+    size_t slot = 0u;
+
+    /* Assigning Initial Values for Variables */
+    memset(slots, 0, sizeof(slots));
+
+    /* Start Function Logic */
+    while (self->operations < bench_operations)
+    {
+        slot = (size_t)(BENCH_nextRandom(&self->seed) % BENCH_LOCAL_SLOTS);
+
+        if (slots[slot] != NULL)
+        {
+            BENCH_free(slots[slot]);
+            slots[slot] = NULL;
+        }
+        else
+        {
+            slots[slot] = BENCH_malloc(BENCH_randomSize(&self->seed));
+            if (slots[slot] == NULL)
+            {
+                self->failures++;
+            }
+        }
+
+        self->operations++;
+    }
+
+    for (slot = 0u; slot < BENCH_LOCAL_SLOTS; ++slot)
+    {
+        if (slots[slot] != NULL)
+        {
+            BENCH_free(slots[slot]);
+            self->operations++;
+        }
+    }
+}
+
+/**
+ * @fn      BENCH_runRemote
+ * @package MEM_bench
+ *
+ * @brief   Hands every allocated block to the next thread, and frees those of the previous one.
+ *
+ * @details A thread that finds the next ring full frees its own queue while it waits, so the
+ *          chain of threads always makes progress. Once done, the thread keeps freeing until
+ *          the previous thread is done too.
+ *
+ * @param   [in/out] self State of the calling thread.
+ */
+static void BENCH_runRemote(bench_thread_t *self)
+{
+    /* Definition of Function Variables */
+    bench_thread_t *next        = NULL;
+    bench_thread_t *previous    = NULL;
+    uint64_t allocated          = 0u;
+    void *ptr                   = NULL;
+
+    /* Assigning Initial Values for Variables */
+    next        = &bench_threads[(self->index + 1u) % bench_thread_count];
+    previous    = &bench_threads[(self->index + bench_thread_count - 1u) % bench_thread_count];
+
+    /* Start Function Logic */
+    for (allocated = 0u; allocated < bench_operations / 2u; ++allocated)
+    {
+        ptr = BENCH_malloc(BENCH_randomSize(&self->seed));
+        self->operations++;
+
+        if (ptr == NULL)
+        {
+            self->failures++;
+            BENCH_ringDrain(self);
+            continue;
+        }
+
+        while (!BENCH_ringPush(&next->inbox, ptr))
+        {
+            BENCH_ringDrain(self);
+            sched_yield();
+        }
+
+        BENCH_ringDrain(self);
+    }
+
+    __atomic_store_n(&self->done, 1, __ATOMIC_RELEASE);
+
+    while (!__atomic_load_n(&previous->done, __ATOMIC_ACQUIRE))
+    {
+        BENCH_ringDrain(self);
+        sched_yield();
+    }
+
+    BENCH_ringDrain(self);
+}
+
+/**
+ * @fn      BENCH_runPool
+ * @package MEM_bench
+ *
+ * @brief   Swaps blocks in and out of the slots shared by every thread.
+ *
+ * @details Taking a slot is an atomic exchange, so the block freed is usually one allocated
+ *          by another thread. A block whose slot was refilled meanwhile is freed again.
+ *
+ * @param   [in/out] self State of the calling thread.
+ */
+static void BENCH_runPool(bench_thread_t *self)
+{
+    /* Definition of Function Variables */
+    size_t slot     = 0u;
+    void *ptr       = NULL;
+    void *expected  = NULL;
+
+    /* Start Function Logic */
+    while (self->operations < bench_operations)
+    {
+        slot    = (size_t)(BENCH_nextRandom(&self->seed) % BENCH_POOL_SLOTS);
+        ptr     = __atomic_exchange_n(&bench_pool[slot], NULL, __ATOMIC_ACQ_REL);
+
+        if (ptr != NULL)
+        {
+            BENCH_free(ptr);
+            self->operations++;
+            continue;
+        }
+
+        ptr = BENCH_malloc(BENCH_randomSize(&self->seed));
+        self->operations++;
+
+        if (ptr == NULL)
+        {
+            self->failures++;
+            continue;
+        }
+
+        expected = NULL;
+        if (!__atomic_compare_exchange_n(&bench_pool[slot], &expected, ptr, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            BENCH_free(ptr);
+            self->operations++;
+        }
+    }
+}
+
+/**
+ * @fn      BENCH_worker
+ * @package MEM_bench
+ *
+ * @brief   Thread entry point: waits for the start of the run and runs its pattern.
+ *
+ * @param   [in/out] arg State of the thread, a bench_thread_t.
+ *
+ * @return  NULL.
+ */
+static void *BENCH_worker(void *arg)
+{
+    /* Definition of Function Variables */
+    bench_thread_t *self = (bench_thread_t *)arg;
+
+    /* Start Function Logic */
+    (void)pthread_barrier_wait(&bench_start);
+    self->start_ns = BENCH_nowNs();
+
+    switch (bench_pattern)
+    {
+        case BENCH_LOCAL:
+            BENCH_runLocal(self);
+            break;
+        case BENCH_REMOTE:
+            BENCH_runRemote(self);
+            break;
+        default:
+            BENCH_runPool(self);
+            break;
+    }
+
+    self->end_ns = BENCH_nowNs();
+
+    /* Function Return */
+    return NULL;
+}
+
+/**
+ * @fn      BENCH_nextThreadCount
+ * @package MEM_bench
+ *
+ * @brief   Steps the thread count through the powers of two, ending on the highest count.
+ *
+ * @param   [in] threads     Current thread count.
+ * @param   [in] max_threads Highest thread count.
+ *
+ * @return  Next thread count, above max_threads once max_threads has run.
+ */
+static size_t BENCH_nextThreadCount(size_t threads, size_t max_threads)
+{
+    /* Function Return */
+    return (threads < max_threads && threads * 2u > max_threads) ? max_threads : threads * 2u;
+}
+
+/**
+ * @fn      BENCH_resetPeakRss
+ * @package MEM_bench
+ *
+ * @brief   Resets the peak RSS of the process to its current RSS, where the kernel allows it.
+ */
+static void BENCH_resetPeakRss(void)
+{
+    /* Definition of Function Variables */
+    FILE *file = NULL;
+
+    /* Start Function Logic */
+    file = fopen("/proc/self/clear_refs", "w");
+    if (file != NULL)
+    {
+        (void)fputs("5", file);
+        (void)fclose(file);
+    }
+}
+
+/**
+ * @fn      BENCH_peakRssKb
+ * @package MEM_bench
+ *
+ * @brief   Reads the peak RSS of the process.
+ *
+ * @details Uses VmHWM of /proc/self/status, which BENCH_resetPeakRss resets, and falls back to
+ *          getrusage.
+ *
+ * @return  Peak resident set size in KB.
+ */
+static long BENCH_peakRssKb(void)
+{
+    /* Definition of Function Variables */
+    FILE *file  = NULL;
+    long peak   = -1;
+
+    char line[128];
+    struct rusage usage;
+
+    /* Start Function Logic */
+    file = fopen("/proc/self/status", "r");
+    if (file != NULL)
+    {
+        while (peak < 0 && fgets(line, sizeof(line), file) != NULL)
+        {
+            if (sscanf(line, "VmHWM: %ld", &peak) != 1)
+            {
+                peak = -1;
+            }
+        }
+
+        (void)fclose(file);
+    }
+
+    if (peak < 0 && getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        peak = usage.ru_maxrss;
+    }
+
+    /* Function Return */
+    return peak;
+}
+
+/**
+ * @fn      BENCH_readStats
+ * @package MEM_bench
+ *
+ * @brief   Sums the lock and remote-free counters of the backend of the current run.
+ *
+ * @param   [out] result Measurements to complete.
+ */
+static void BENCH_readStats(bench_result_t *result)
+{
+    /* Definition of Function Variables */
+    mem_alloc_stats_t stats;
+    uint64_t acquisitions   = 0u;
+    uint64_t contended      = 0u;
+    uint64_t operations     = 0u;
+    size_t index            = 0u;
+    size_t count            = 0u;
+
+    /* Check deference/argument boundaries */
+    if (bench_backend == BENCH_LIBC)
+    {
+        result->locks_per_op = -1.0;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    count = (bench_backend == BENCH_SHARED) ? 1u : bench_arenas.count;
+
+    /* Start Function Logic */
+    for (index = 0u; index < count; ++index)
+    {
+        (void)MEM_allocatorGetStats((bench_backend == BENCH_SHARED) ? &bench_allocator : &bench_arenas.arenas[index], &stats);
+
+        acquisitions            += stats.lock_acquisitions;
+        contended               += stats.lock_contended;
+        result->remote_frees    += stats.remote_frees;
+    }
+
+    for (index = 0u; index < bench_thread_count; ++index)
+    {
+        operations += bench_threads[index].operations;
+    }
+
+    result->locks_per_op    = operations ? (double)acquisitions / (double)operations : 0.0;
+    result->contended       = acquisitions ? (double)contended / (double)acquisitions : 0.0;
+
+    /* Function Return */
+end_of_function:
+    return;
+}
+
+/**
+ * @fn      BENCH_run
+ * @package MEM_bench
+ *
+ * @brief   Runs one pattern with a number of threads against one backend.
+ *
+ * @details The backend is set up fresh for every run, so the counters cover the run alone.
+ *          The run lasts from the first thread released to the last one finished, as each
+ *          thread timed itself. Blocks left in the shared pool are freed afterwards, outside the timing.
+ *
+ * @param   [in]  backend     Backend under test.
+ * @param   [in]  pattern     Pattern every thread runs.
+ * @param   [in]  threads     Number of threads.
+ * @param   [in]  operations  Calls per thread.
+ * @param   [out] result      Measurements of the run.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int BENCH_run(bench_backend_t backend, bench_pattern_t pattern, size_t threads, size_t operations, bench_result_t *result)
+{
+    /* Definition of Function Variables */
+    int ret             = 0;
+
+    size_t index        = 0u;
+    size_t started      = 0u;
+    uint64_t start      = UINT64_MAX;
+    uint64_t end        = 0u;
+    uint64_t total      = 0u;
+
+    /* Assigning Initial Values for Variables */
+    memset(result, 0, sizeof(*result));
+    memset(bench_threads, 0, sizeof(bench_threads));
+    memset(bench_pool, 0, sizeof(bench_pool));
+
+    bench_backend       = backend;
+    bench_pattern       = pattern;
+    bench_thread_count  = threads;
+    bench_operations    = operations;
+
+    if (backend == BENCH_SHARED)
+    {
+        ret = MEM_allocatorInit(&bench_allocator);
+        if (ret == 0)
+        {
+            ret = MEM_allocatorSetThreadSafe(&bench_allocator, 1);
+        }
+    }
+    else if (backend == BENCH_ARENAS)
+    {
+        ret = MEM_arenaSetInit(&bench_arenas, (threads < MEM_ARENAS_MAX) ? threads : MEM_ARENAS_MAX, MEM_ARENA_ROUND_ROBIN);
+    }
+
+    if (ret != 0)
+    {
+        goto end_of_function;
+    }
+
+    ret = pthread_barrier_init(&bench_start, NULL, (unsigned)(threads + 1u));
+    if (ret != 0)
+    {
+        goto destroy_backend;
+    }
+
+    /* Start Function Logic */
+    for (started = 0u; started < threads; ++started)
+    {
+        bench_threads[started].index    = started;
+        bench_threads[started].seed     = 0x9E3779B97F4A7C15ULL * (started + 1u);
+
+        ret = pthread_create(&bench_threads[started].thread, NULL, BENCH_worker, &bench_threads[started]);
+        if (ret != 0)
+        {
+            /* The barrier cannot release the threads already waiting */
+            fprintf(stderr, "bench_threads: could not start thread %zu (%s)\n", started, strerror(ret));
+            exit(1);
+        }
+    }
+
+    BENCH_resetPeakRss();
+
+    (void)pthread_barrier_wait(&bench_start);
+
+    for (index = 0u; index < threads; ++index)
+    {
+        (void)pthread_join(bench_threads[index].thread, NULL);
+    }
+
+    result->peak_rss_kb = BENCH_peakRssKb();
+
+    for (index = 0u; index < threads; ++index)
+    {
+        total               += bench_threads[index].operations;
+        result->failures    += bench_threads[index].failures;
+
+        start   = (bench_threads[index].start_ns < start) ? bench_threads[index].start_ns : start;
+        end     = (bench_threads[index].end_ns > end) ? bench_threads[index].end_ns : end;
+    }
+
+    result->ops_per_sec = (end > start) ? ((double)total * 1e9) / (double)(end - start) : 0.0;
+    BENCH_readStats(result);
+
+    for (index = 0u; index < BENCH_POOL_SLOTS; ++index)
+    {
+        if (bench_pool[index] != NULL)
+        {
+            BENCH_free(bench_pool[index]);
+        }
+    }
+
+    (void)pthread_barrier_destroy(&bench_start);
+
+destroy_backend:
+    if (backend == BENCH_SHARED)
+    {
+        ret |= MEM_allocatorDestroy(&bench_allocator);
+    }
+    else if (backend == BENCH_ARENAS)
+    {
+        ret |= MEM_arenaSetDestroy(&bench_arenas);
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      main
+ * @package MEM_bench
+ *
+ * @brief   Benchmark entry point.
+ *
+ * @param   [in] argc Argument count.
+ * @param   [in] argv Optional calls per thread and highest thread count.
+ *
+ * @return  0 on success, 1 on failure.
+ */
+int main(int argc, char **argv)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0;
+
+    size_t operations       = BENCH_DEFAULT_OPERATIONS;
+    size_t max_threads      = 0u;
+    size_t threads          = 0u;
+    long cpus               = 0;
+    int pattern             = 0;
+    int backend             = 0;
+
+    bench_result_t result;
+    double single[BENCH_LIBC + 1];
+
+    char locks[16];
+    char contended[16];
+
+    /* Assigning Initial Values for Variables */
+    memset(single, 0, sizeof(single));
+
+    cpus        = sysconf(_SC_NPROCESSORS_ONLN);
+    max_threads = (cpus > (long)BENCH_MIN_THREADS) ? (size_t)cpus : BENCH_MIN_THREADS;
+
+    if (argc > 1)
+    {
+        operations = (size_t)strtoul(argv[1], NULL, 10);
+    }
+
+    if (argc > 2)
+    {
+        max_threads = (size_t)strtoul(argv[2], NULL, 10);
+    }
+
+    /* Check deference/argument boundaries */
+    if (operations < 2u || max_threads == 0u || max_threads > BENCH_MAX_THREADS)
+    {
+        fprintf(stderr, "usage: %s [operations_per_thread] [max_threads <= %lu]\n", argv[0], BENCH_MAX_THREADS);
+        return 1;
+    }
+
+    /* Start Function Logic */
+    printf("Thread benchmark: heap %lu bytes, %zu calls per thread, %ld online CPUs\n\n",
+           (unsigned long)HEAP_SIZE, operations, cpus);
+
+    for (pattern = BENCH_LOCAL; pattern <= BENCH_POOL; ++pattern)
+    {
+        printf("Pattern %s\n", pattern_names[pattern]);
+        printf("%-12s %7s %10s %8s %9s %9s %10s %11s %8s\n",
+               "Backend", "Threads", "Mops/s", "Scaling", "Locks/op", "Contended", "Remote", "PeakRSS(KB)", "Failed");
+
+        for (backend = BENCH_SHARED; backend <= BENCH_LIBC; ++backend)
+        {
+            for (threads = 1u; threads <= max_threads; threads = BENCH_nextThreadCount(threads, max_threads))
+            {
+                MEM_logSetHook(NULL, NULL);
+                ret = BENCH_run((bench_backend_t)backend, (bench_pattern_t)pattern, threads, operations, &result);
+                MEM_logSetHook(MEM_logStdio, NULL);
+
+                if (ret != 0)
+                {
+                    fprintf(stderr, "bench_threads: %s run failed (%s)\n", backend_names[backend], strerror(ret));
+                    goto end_of_function;
+                }
+
+                if (threads == 1u)
+                {
+                    single[backend] = result.ops_per_sec;
+                }
+
+                if (result.locks_per_op < 0.0)
+                {
+                    snprintf(locks, sizeof(locks), "%s", "-");
+                    snprintf(contended, sizeof(contended), "%s", "-");
+                }
+                else
+                {
+                    snprintf(locks, sizeof(locks), "%.3f", result.locks_per_op);
+                    snprintf(contended, sizeof(contended), "%.1f%%", result.contended * 100.0);
+                }
+
+                printf("%-12s %7zu %10.2f %7.2fx %9s %9s %10llu %11ld %8zu\n",
+                       backend_names[backend], threads, result.ops_per_sec / 1e6,
+                       single[backend] > 0.0 ? result.ops_per_sec / single[backend] : 0.0,
+                       locks, contended, (unsigned long long)result.remote_frees, result.peak_rss_kb,
+                       result.failures);
+            }
+        }
+
+        printf("\n");
+    }
+
+    /* Function Return */
+end_of_function:
+    return (ret != 0) ? 1 : 0;
+}
+
+/*** end of file ***/
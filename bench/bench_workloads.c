@@ -0,0 +1,1132 @@
+/**
+ *  @ingroup    MemoryManagement
+ *  @addtogroup MemoryBenchmark MEM_bench
+ *  @{
+ *
+ *  @package    MEM_bench
+ *  @brief      Synthetic and replayed workload benchmark of the allocation strategies.
+ *
+ *  @file       bench_workloads.c
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              Builds each workload once as a list of malloc and free operations on numbered
+ *              slots, then runs the same list against every allocation strategy and against the
+ *              process malloc as a baseline. Uniform sizes, a bimodal mix of small and large
+ *              objects, a producer/consumer queue that frees in allocation order, and an
+ *              optional replayed trace file are covered. For each run the report lists the
+ *              throughput, the p50 and p99 latency of both operations, the peak external
+ *              fragmentation, the peak footprint and the header overhead at peak usage.
+ *
+ *  @note
+ *              - Usage: bench_workloads [operations] [live_slots] [trace_file]
+ *              - A trace file holds one operation per line: "m <slot> <size>" allocates size
+ *                bytes into a slot, "f <slot>" frees it. Lines starting with '#' are skipped.
+ *              - A file written by MEM_recordStart is recognised by MEM_RECORD_MAGIC and
+ *                replayed in timestamp order, its pointers mapped onto reused slots.
+ *              - The baseline row measures whatever malloc the process resolves, so running the
+ *                benchmark under LD_PRELOAD with jemalloc or mimalloc compares against those.
+ *              - Fragmentation is read from MEM_allocatorGetStats and is not available for the
+ *                baseline; its overhead only counts the usable-size slack of each block.
+ *
+ *  @see        - libmemalloc.h
+ **/
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#if defined(__GLIBC__)
+    #include <malloc.h>
+#endif
+
+#include <libmemalloc.h>
+
+/* =================================
+ *          PRIVATE DEFINES        *
+ * ================================*/
+
+/**
+ * @def BENCH_DEFAULT_OPERATIONS
+ * @package MEM_bench
+ *
+ * @brief Default number of operations per synthetic workload.
+ */
+#define BENCH_DEFAULT_OPERATIONS (50000UL)
+
+/**
+ * @def BENCH_DEFAULT_SLOTS
+ * @package MEM_bench
+ *
+ * @brief Default number of slots that may hold a live allocation at the same time.
+ */
+#define BENCH_DEFAULT_SLOTS (1024UL)
+
+/**
+ * @def BENCH_UNIFORM_MIN
+ * @package MEM_bench
+ *
+ * @brief Smallest request of the uniform and producer/consumer workloads, in bytes.
+ */
+#define BENCH_UNIFORM_MIN (16UL)
+
+/**
+ * @def BENCH_UNIFORM_MAX
+ * @package MEM_bench
+ *
+ * @brief Largest request of the uniform and producer/consumer workloads, in bytes.
+ */
+#define BENCH_UNIFORM_MAX (512UL)
+
+/**
+ * @def BENCH_SMALL_MAX
+ * @package MEM_bench
+ *
+ * @brief Largest small request of the bimodal workload, in bytes.
+ */
+#define BENCH_SMALL_MAX (64UL)
+
+/**
+ * @def BENCH_LARGE_MIN
+ * @package MEM_bench
+ *
+ * @brief Smallest large request of the bimodal workload, in bytes.
+ */
+#define BENCH_LARGE_MIN (1024UL)
+
+/**
+ * @def BENCH_LARGE_MAX
+ * @package MEM_bench
+ *
+ * @brief Largest large request of the bimodal workload, in bytes.
+ */
+#define BENCH_LARGE_MAX (8192UL)
+
+/**
+ * @def BENCH_LARGE_PERCENT
+ * @package MEM_bench
+ *
+ * @brief Share of large requests in the bimodal workload.
+ */
+#define BENCH_LARGE_PERCENT (10UL)
+
+/**
+ * @def BENCH_FREE_OP
+ * @package MEM_bench
+ *
+ * @brief Size value marking a free operation in a workload.
+ */
+#define BENCH_FREE_OP (0UL)
+
+/**
+ * @def BENCH_BASELINE
+ * @package MEM_bench
+ *
+ * @brief Backend value selecting the process malloc instead of a strategy.
+ */
+#define BENCH_BASELINE (-1)
+
+/**
+ * @def BENCH_EMPTY_ID
+ * @package MEM_bench
+ *
+ * @brief Id of an unused entry of the recording replay map.
+ */
+#define BENCH_EMPTY_ID (0ULL)
+
+/**
+ * @def BENCH_DEAD_ID
+ * @package MEM_bench
+ *
+ * @brief Id of a replay map entry whose pointer was freed; no aligned pointer has this value.
+ */
+#define BENCH_DEAD_ID (1ULL)
+
+/* =================================
+ *     PRIVATE DATA STRUCTURES     *
+ * ================================*/
+
+/**
+ * @struct  bench_op
+ * @package MEM_bench
+ *
+ * @typedef bench_op_t
+ *
+ * @brief   One operation of a workload.
+ */
+typedef struct bench_op
+{
+    size_t slot;                                        /**< Slot the operation applies to */
+    size_t size;                                        /**< Bytes to allocate, BENCH_FREE_OP for a free */
+} bench_op_t;
+
+/**
+ * @struct  bench_workload
+ * @package MEM_bench
+ *
+ * @typedef bench_workload_t
+ *
+ * @brief   Operation list shared by every backend.
+ */
+typedef struct bench_workload
+{
+    const char *name;                                   /**< Printable name */
+    bench_op_t *ops;                                    /**< Operations, in execution order */
+    size_t count;                                       /**< Number of operations */
+    size_t slot_count;                                  /**< Number of slots referenced by the operations */
+} bench_workload_t;
+
+/**
+ * @struct  bench_result
+ * @package MEM_bench
+ *
+ * @typedef bench_result_t
+ *
+ * @brief   Measurements of one backend over one workload.
+ */
+typedef struct bench_result
+{
+    double ops_per_sec;                                 /**< Operations per second of time spent in the allocator */
+    uint64_t malloc_p50;                                /**< Median malloc latency, in nanoseconds */
+    uint64_t malloc_p99;                                /**< 99th percentile malloc latency, in nanoseconds */
+    uint64_t free_p50;                                  /**< Median free latency, in nanoseconds */
+    uint64_t free_p99;                                  /**< 99th percentile free latency, in nanoseconds */
+    double peak_fragmentation;                          /**< Highest 1 - largest_free / free_bytes seen, negative if unknown */
+    double overhead;                                    /**< Bytes beyond the requests at peak usage, over the bytes in use */
+    size_t peak_bytes;                                  /**< Highest bytes in use, headers or usable-size slack included */
+    size_t failures;                                    /**< Number of failed allocations */
+} bench_result_t;
+
+/* =================================
+ *     PRIVATE GLOBAL VARIABLE     *
+ * ================================*/
+
+/**
+ * @var     backends
+ * @package MEM_bench
+ *
+ * @brief   Strategies exercised by the benchmark, in report order, then the baseline.
+ */
+static const int backends[] = { FIRST_FIT, NEXT_FIT, BEST_FIT, SEGREGATED_FIT, TLSF_FIT, BENCH_BASELINE };
+
+/**
+ * @var     backend_names
+ * @package MEM_bench
+ *
+ * @brief   Printable names matching the backends table.
+ */
+static const char *backend_names[] = { "FIRST_FIT", "NEXT_FIT", "BEST_FIT", "SEGREGATED_FIT", "TLSF_FIT", "libc malloc" };
+
+/* =================================
+ *   PRIVATE FUNCTION DEFINITION   *
+ * ================================*/
+
+/**
+ * @fn      BENCH_nowNs
+ * @package MEM_bench
+ *
+ * @brief   Reads the monotonic clock.
+ *
+ * @return  Current monotonic time in nanoseconds.
+ */
+static uint64_t BENCH_nowNs(void)
+{
+    /* Definition of Function Variables */
+    struct timespec ts;
+
+    /* Start Function Logic */
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    /* Function Return */
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @fn      BENCH_nextRandom
+ * @package MEM_bench
+ *
+ * @brief   Advances a xorshift64 generator.
+ *
+ * @param   [in/out] state Generator state, must not be zero.
+ *
+ * @return  Next pseudo-random value.
+ */
+static uint64_t BENCH_nextRandom(uint64_t *state)
+{
+    /* Start Function Logic */
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    /* Function Return */
+    return *state;
+}
+
+/**
+ * @fn      BENCH_randomRange
+ * @package MEM_bench
+ *
+ * @brief   Draws a value in [low, high].
+ *
+ * @param   [in/out] state Generator state.
+ * @param   [in]     low   Smallest value.
+ * @param   [in]     high  Largest value.
+ *
+ * @return  Pseudo-random value in range.
+ */
+static size_t BENCH_randomRange(uint64_t *state, size_t low, size_t high)
+{
+    /* Function Return */
+    return low + (size_t)(BENCH_nextRandom(state) % (uint64_t)(high - low + 1u));
+}
+
+/**
+ * @fn      BENCH_compareU64
+ * @package MEM_bench
+ *
+ * @brief   qsort comparator for uint64_t samples.
+ */
+static int BENCH_compareU64(const void *lhs, const void *rhs)
+{
+    /* Definition of Function Variables */
+    uint64_t a = *(const uint64_t *)lhs;
+    uint64_t b = *(const uint64_t *)rhs;
+
+    /* Function Return */
+    return (a > b) - (a < b);
+}
+
+/**
+ * @fn      BENCH_percentile
+ * @package MEM_bench
+ *
+ * @brief   Reads a percentile from sorted samples.
+ *
+ * @param   [in] samples  Sorted latency samples.
+ * @param   [in] count    Number of samples.
+ * @param   [in] permille Percentile, in thousandths.
+ *
+ * @return  The sample at the percentile, 0 when there are none.
+ */
+static uint64_t BENCH_percentile(const uint64_t *samples, size_t count, size_t permille)
+{
+    /* Check deference/argument boundaries */
+    if (count == 0u)
+    {
+        return 0u;
+    }
+
+    /* Function Return */
+    return samples[(count * permille) / 1000u];
+}
+
+/**
+ * @fn      BENCH_usableSize
+ * @package MEM_bench
+ *
+ * @brief   Reads the usable size of a block of the process malloc.
+ *
+ * @param   [in] ptr Block returned by malloc.
+ *
+ * @return  Usable bytes of the block, 0 when the C library cannot tell.
+ */
+static size_t BENCH_usableSize(void *ptr)
+{
+    /* Function Return */
+#if defined(__GLIBC__)
+    return malloc_usable_size(ptr);
+#else
+    (void)ptr;
+    return 0u;
+#endif
+}
+
+/**
+ * @fn      BENCH_buildRandom
+ * @package MEM_bench
+ *
+ * @brief   Builds a workload that frees or fills a random slot per operation.
+ *
+ * @details An occupied slot is freed, an empty one gets a new allocation. With bimodal set,
+ *          BENCH_LARGE_PERCENT of the allocations are large and the rest small; otherwise sizes
+ *          are uniform in [BENCH_UNIFORM_MIN, BENCH_UNIFORM_MAX].
+ *
+ * @param   [out] workload   Workload to fill.
+ * @param   [in]  operations Number of operations.
+ * @param   [in]  slot_count Number of slots.
+ * @param   [in]  bimodal    Non-zero for the bimodal size mix.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int BENCH_buildRandom(bench_workload_t *workload, size_t operations, size_t slot_count, int bimodal)
+{
+    /* Definition of Function Variables */
+    int ret         = 0;
+
+    uint8_t *live   = NULL;
+    size_t op       = 0u;
+    size_t slot     = 0u;
+
+    uint64_t rng    = bimodal ? 0xD1B54A32D192ED03ULL : 0x9E3779B97F4A7C15ULL;
+
+    /* Assigning Initial Values for Variables */
+    workload->name          = bimodal ? "bimodal" : "uniform";
+    workload->count         = operations;
+    workload->slot_count    = slot_count;
+    workload->ops           = calloc(operations, sizeof(bench_op_t));
+    live                    = calloc(slot_count, sizeof(uint8_t));
+
+    if (workload->ops == NULL || live == NULL)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    for (op = 0u; op < operations; ++op)
+    {
+        slot                    = (size_t)(BENCH_nextRandom(&rng) % slot_count);
+        workload->ops[op].slot  = slot;
+
+        if (live[slot])
+        {
+            workload->ops[op].size = BENCH_FREE_OP;
+        }
+        else if (bimodal && (BENCH_nextRandom(&rng) % 100u) < BENCH_LARGE_PERCENT)
+        {
+            workload->ops[op].size = BENCH_randomRange(&rng, BENCH_LARGE_MIN, BENCH_LARGE_MAX);
+        }
+        else if (bimodal)
+        {
+            workload->ops[op].size = BENCH_randomRange(&rng, BENCH_UNIFORM_MIN, BENCH_SMALL_MAX);
+        }
+        else
+        {
+            workload->ops[op].size = BENCH_randomRange(&rng, BENCH_UNIFORM_MIN, BENCH_UNIFORM_MAX);
+        }
+
+        live[slot] = (uint8_t)!live[slot];
+    }
+
+    /* Function Return */
+end_of_function:
+    free(live);
+
+    return ret;
+}
+
+/**
+ * @fn      BENCH_buildQueue
+ * @package MEM_bench
+ *
+ * @brief   Builds a producer/consumer workload.
+ *
+ * @details The producer keeps a queue of up to slot_count objects; the consumer frees the
+ *          oldest one. Each step produces with a probability that falls as the queue fills, so
+ *          the depth wanders around half the slots and frees always come in allocation order.
+ *
+ * @param   [out] workload   Workload to fill.
+ * @param   [in]  operations Number of operations.
+ * @param   [in]  slot_count Queue capacity.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int BENCH_buildQueue(bench_workload_t *workload, size_t operations, size_t slot_count)
+{
+    /* Definition of Function Variables */
+    int ret         = 0;
+
+    size_t op       = 0u;
+    size_t head     = 0u;
+    size_t depth    = 0u;
+
+    uint64_t rng    = 0x94D049BB133111EBULL;
+
+    /* Assigning Initial Values for Variables */
+    workload->name          = "producer/consumer";
+    workload->count         = operations;
+    workload->slot_count    = slot_count;
+    workload->ops           = calloc(operations, sizeof(bench_op_t));
+
+    if (workload->ops == NULL)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    for (op = 0u; op < operations; ++op)
+    {
+        if (depth < slot_count && (BENCH_nextRandom(&rng) % slot_count) >= depth)
+        {
+            workload->ops[op].slot = (head + depth) % slot_count;
+            workload->ops[op].size = BENCH_randomRange(&rng, BENCH_UNIFORM_MIN, BENCH_UNIFORM_MAX);
+            ++depth;
+        }
+        else
+        {
+            workload->ops[op].slot = head;
+            workload->ops[op].size = BENCH_FREE_OP;
+            head                   = (head + 1u) % slot_count;
+            --depth;
+        }
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      BENCH_compareRecord
+ * @package MEM_bench
+ *
+ * @brief   qsort comparator putting allocation records in time order.
+ *
+ * @details A free sorts before a malloc with the same timestamp, which keeps the free and
+ *          malloc pair of an in-place realloc in order.
+ *
+ * @param   [in] lhs Pointer to the first mem_record_t.
+ * @param   [in] rhs Pointer to the second mem_record_t.
+ *
+ * @return  Negative, zero or positive as lhs is earlier, tied with or later than rhs.
+ */
+static int BENCH_compareRecord(const void *lhs, const void *rhs)
+{
+    /* Definition of Function Variables */
+    const mem_record_t *left    = (const mem_record_t *)lhs;
+    const mem_record_t *right   = (const mem_record_t *)rhs;
+
+    /* Start Function Logic */
+    if (left->timestamp != right->timestamp)
+    {
+        return (left->timestamp < right->timestamp) ? -1 : 1;
+    }
+
+    /* Function Return */
+    return (int)right->op - (int)left->op;
+}
+
+/**
+ * @fn      BENCH_loadRecord
+ * @package MEM_bench
+ *
+ * @brief   Reads a workload from a file written by MEM_recordStart.
+ *
+ * @details The records of all threads are sorted by timestamp. Each live pointer is mapped to
+ *          a slot through an open-addressing table, and the slot of a freed pointer is reused
+ *          by the next allocation, so the slot count is the peak number of live pointers. A
+ *          pointer allocated again without a recorded free, whose free was lost with a thread
+ *          buffer, is freed first; frees of pointers never seen are skipped. File name records
+ *          are skipped.
+ *
+ * @param   [out]    workload Workload to fill.
+ * @param   [in/out] file     Recording, positioned at its start.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int BENCH_loadRecord(bench_workload_t *workload, FILE *file)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0;
+
+    mem_record_header_t header;
+    mem_record_t record;
+
+    mem_record_t *records   = NULL;
+    mem_record_t *grown     = NULL;
+    uint64_t *ids           = NULL;
+    size_t *slots           = NULL;
+    size_t *spare           = NULL;
+
+    size_t count            = 0u;
+    size_t capacity         = 0u;
+    size_t map_size         = 1u;
+    size_t spare_count      = 0u;
+    size_t index            = 0u;
+    size_t entry            = 0u;
+    size_t target           = 0u;
+    size_t skip             = 0u;
+
+    /* Assigning Initial Values for Variables */
+    if (fread(&header, sizeof(header), 1u, file) != 1u ||
+        memcmp(header.magic, MEM_RECORD_MAGIC, sizeof(MEM_RECORD_MAGIC)) != 0 ||
+        header.version != 1u || header.record_size != sizeof(mem_record_t))
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    while (fread(&record, sizeof(record), 1u, file) == 1u)
+    {
+        if (record.op == MEM_RECORD_FILE)
+        {
+            for (skip = (size_t)((record.size + sizeof(record) - 1u) / sizeof(record)); skip > 0u; --skip)
+            {
+                if (fread(&record, sizeof(record), 1u, file) != 1u)
+                {
+                    ret = EINVAL;
+                    goto end_of_function;
+                }
+            }
+
+            continue;
+        }
+
+        if (record.op != MEM_RECORD_FREE && (record.op != MEM_RECORD_MALLOC || record.size == 0u))
+        {
+            ret = EINVAL;
+            goto end_of_function;
+        }
+
+        if (count == capacity)
+        {
+            capacity    = capacity ? capacity * 2u : 1024u;
+            grown       = realloc(records, capacity * sizeof(mem_record_t));
+            if (grown == NULL)
+            {
+                ret = ENOMEM;
+                goto end_of_function;
+            }
+
+            records = grown;
+        }
+
+        records[count++] = record;
+    }
+
+    if (count == 0u)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    qsort(records, count, sizeof(mem_record_t), BENCH_compareRecord);
+
+    while (map_size < count * 2u)
+    {
+        map_size *= 2u;
+    }
+
+    ids             = calloc(map_size, sizeof(uint64_t));
+    slots           = calloc(map_size, sizeof(size_t));
+    spare           = calloc(count, sizeof(size_t));
+    workload->ops   = calloc(count * 2u, sizeof(bench_op_t));
+
+    if (ids == NULL || slots == NULL || spare == NULL || workload->ops == NULL)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    for (index = 0u; index < count; ++index)
+    {
+        /* Find the live entry of the pointer, or the first reusable entry after it */
+        target  = map_size;
+        entry   = (size_t)((records[index].id * 0x9E3779B97F4A7C15ULL) >> 32) & (map_size - 1u);
+
+        while (ids[entry] != BENCH_EMPTY_ID && ids[entry] != records[index].id)
+        {
+            if (ids[entry] == BENCH_DEAD_ID && target == map_size)
+            {
+                target = entry;
+            }
+
+            entry = (entry + 1u) & (map_size - 1u);
+        }
+
+        if (ids[entry] == records[index].id)
+        {
+            workload->ops[workload->count].slot = slots[entry];
+            workload->ops[workload->count].size = BENCH_FREE_OP;
+            workload->count++;
+
+            if (records[index].op == MEM_RECORD_FREE)
+            {
+                ids[entry]              = BENCH_DEAD_ID;
+                spare[spare_count++]    = slots[entry];
+                continue;
+            }
+        }
+        else
+        {
+            if (records[index].op == MEM_RECORD_FREE)
+            {
+                continue;
+            }
+
+            entry           = (target != map_size) ? target : entry;
+            ids[entry]      = records[index].id;
+            slots[entry]    = (spare_count > 0u) ? spare[--spare_count] : workload->slot_count++;
+        }
+
+        workload->ops[workload->count].slot = slots[entry];
+        workload->ops[workload->count].size = (size_t)records[index].size;
+        workload->count++;
+    }
+
+    /* Function Return */
+end_of_function:
+    free(records);
+    free(ids);
+    free(slots);
+    free(spare);
+
+    return ret;
+}
+
+/**
+ * @fn      BENCH_loadTrace
+ * @package MEM_bench
+ *
+ * @brief   Reads a workload from a trace file.
+ *
+ * @details Each line is "m <slot> <size>" or "f <slot>". The slot count is the highest slot
+ *          referenced plus one. Malformed lines are rejected. A file starting with
+ *          MEM_RECORD_MAGIC is read by BENCH_loadRecord instead.
+ *
+ * @param   [out] workload Workload to fill.
+ * @param   [in]  path     Path of the trace file.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int BENCH_loadTrace(bench_workload_t *workload, const char *path)
+{
+    /* Definition of Function Variables */
+    int ret             = 0;
+
+    FILE *file          = NULL;
+    bench_op_t *grown   = NULL;
+
+    char line[128];
+    char magic[sizeof(MEM_RECORD_MAGIC)];
+    char kind           = 0;
+    unsigned long slot  = 0u;
+    unsigned long size  = 0u;
+    size_t capacity     = 0u;
+    int fields          = 0;
+
+    /* Assigning Initial Values for Variables */
+    memset(workload, 0, sizeof(*workload));
+    workload->name  = "trace";
+    file            = fopen(path, "rb");
+
+    if (file == NULL)
+    {
+        ret = errno;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    if (fread(magic, sizeof(magic), 1u, file) == 1u && memcmp(magic, MEM_RECORD_MAGIC, sizeof(magic)) == 0)
+    {
+        rewind(file);
+
+        workload->name  = "recording";
+        ret             = BENCH_loadRecord(workload, file);
+        goto end_of_function;
+    }
+
+    rewind(file);
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (line[0] == '#' || line[0] == '\n')
+        {
+            continue;
+        }
+
+        fields = sscanf(line, " %c %lu %lu", &kind, &slot, &size);
+        if (!((kind == 'm' && fields == 3 && size > 0u) || (kind == 'f' && fields >= 2)))
+        {
+            ret = EINVAL;
+            goto end_of_function;
+        }
+
+        if (workload->count == capacity)
+        {
+            capacity    = capacity ? capacity * 2u : 1024u;
+            grown       = realloc(workload->ops, capacity * sizeof(bench_op_t));
+            if (grown == NULL)
+            {
+                ret = ENOMEM;
+                goto end_of_function;
+            }
+
+            workload->ops = grown;
+        }
+
+        workload->ops[workload->count].slot = (size_t)slot;
+        workload->ops[workload->count].size = (kind == 'm') ? (size_t)size : BENCH_FREE_OP;
+        workload->count++;
+
+        if ((size_t)slot >= workload->slot_count)
+        {
+            workload->slot_count = (size_t)slot + 1u;
+        }
+    }
+
+    if (workload->count == 0u)
+    {
+        ret = EINVAL;
+    }
+
+    /* Function Return */
+end_of_function:
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+
+    return ret;
+}
+
+/**
+ * @fn      BENCH_runBackend
+ * @package MEM_bench
+ *
+ * @brief   Runs a workload against one backend and measures it.
+ *
+ * @details Each malloc and free call is timed on its own. The throughput is the number of
+ *          timed calls over the time spent in them. After every allocation the allocator
+ *          counters are read, which is O(1) and outside the timed calls, to track the peak
+ *          fragmentation and the overhead at peak usage. Allocations that fail leave their slot
+ *          empty, and the matching free is skipped.
+ *
+ * @param   [in]  workload Workload to run.
+ * @param   [in]  backend  Strategy under test, or BENCH_BASELINE.
+ * @param   [out] result   Measurements of the run.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int BENCH_runBackend(const bench_workload_t *workload, int backend, bench_result_t *result)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0;
+
+    mem_allocator_t allocator;
+    mem_alloc_stats_t stats;
+
+    void **slots            = NULL;
+    size_t *sizes           = NULL;
+    uint64_t *malloc_ns     = NULL;
+    uint64_t *free_ns       = NULL;
+
+    size_t malloc_count     = 0u;
+    size_t free_count       = 0u;
+    size_t op               = 0u;
+    size_t slot             = 0u;
+    size_t requested        = 0u;
+    size_t in_use           = 0u;
+    size_t peak_in_use      = 0u;
+
+    uint64_t start          = 0u;
+    uint64_t elapsed        = 0u;
+    uint64_t total_ns       = 0u;
+
+    double fragmentation    = 0.0;
+
+    /* Assigning Initial Values for Variables */
+    memset(result, 0, sizeof(*result));
+    result->peak_fragmentation = (backend == BENCH_BASELINE) ? -1.0 : 0.0;
+
+    slots       = calloc(workload->slot_count, sizeof(void *));
+    sizes       = calloc(workload->slot_count, sizeof(size_t));
+    malloc_ns   = calloc(workload->count, sizeof(uint64_t));
+    free_ns     = calloc(workload->count, sizeof(uint64_t));
+
+    if (slots == NULL || sizes == NULL || malloc_ns == NULL || free_ns == NULL)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    if (backend != BENCH_BASELINE)
+    {
+        ret = MEM_allocatorInit(&allocator);
+        if (ret != 0)
+        {
+            goto end_of_function;
+        }
+    }
+
+    /* Start Function Logic */
+    for (op = 0u; op < workload->count; ++op)
+    {
+        slot = workload->ops[op].slot;
+
+        if (workload->ops[op].size == BENCH_FREE_OP)
+        {
+            if (slots[slot] == NULL)
+            {
+                continue;
+            }
+
+            if (backend == BENCH_BASELINE)
+            {
+                in_use -= BENCH_usableSize(slots[slot]);
+            }
+
+            start = BENCH_nowNs();
+            if (backend == BENCH_BASELINE)
+            {
+                free(slots[slot]);
+            }
+            else
+            {
+                MEM_allocatorFree(&allocator, slots[slot], __FILE__, __LINE__, "slot");
+            }
+            elapsed = BENCH_nowNs() - start;
+
+            free_ns[free_count++]   = elapsed;
+            total_ns                += elapsed;
+            requested               -= sizes[slot];
+            slots[slot]             = NULL;
+            continue;
+        }
+
+        if (slots[slot] != NULL)
+        {
+            ret = EINVAL;
+            goto end_of_function;
+        }
+
+        start = BENCH_nowNs();
+        if (backend == BENCH_BASELINE)
+        {
+            slots[slot] = malloc(workload->ops[op].size);
+        }
+        else
+        {
+            slots[slot] = MEM_allocatorMalloc(&allocator, workload->ops[op].size, __FILE__, __LINE__, "slot",
+                                              (allocation_strategy_t)backend);
+        }
+        elapsed = BENCH_nowNs() - start;
+
+        if (slots[slot] == NULL)
+        {
+            result->failures++;
+            continue;
+        }
+
+        malloc_ns[malloc_count++]   = elapsed;
+        total_ns                    += elapsed;
+
+        sizes[slot] = workload->ops[op].size;
+        requested   += sizes[slot];
+
+        if (backend == BENCH_BASELINE)
+        {
+            in_use += BENCH_usableSize(slots[slot]);
+            if (in_use > peak_in_use)
+            {
+                peak_in_use         = in_use;
+                result->overhead    = (double)(in_use - requested) / (double)in_use;
+            }
+            continue;
+        }
+
+        (void)MEM_allocatorGetStats(&allocator, &stats);
+
+        if (stats.free_bytes > 0u)
+        {
+            fragmentation = 1.0 - ((double)stats.largest_free_block / (double)stats.free_bytes);
+            if (fragmentation > result->peak_fragmentation)
+            {
+                result->peak_fragmentation = fragmentation;
+            }
+        }
+
+        if (stats.bytes_in_use > peak_in_use)
+        {
+            peak_in_use         = stats.bytes_in_use;
+            result->overhead    = (double)(stats.bytes_in_use - requested) / (double)stats.bytes_in_use;
+        }
+    }
+
+    result->peak_bytes = peak_in_use;
+
+    qsort(malloc_ns, malloc_count, sizeof(uint64_t), BENCH_compareU64);
+    qsort(free_ns, free_count, sizeof(uint64_t), BENCH_compareU64);
+
+    result->malloc_p50  = BENCH_percentile(malloc_ns, malloc_count, 500u);
+    result->malloc_p99  = BENCH_percentile(malloc_ns, malloc_count, 990u);
+    result->free_p50    = BENCH_percentile(free_ns, free_count, 500u);
+    result->free_p99    = BENCH_percentile(free_ns, free_count, 990u);
+    result->ops_per_sec = total_ns ? ((double)(malloc_count + free_count) * 1e9) / (double)total_ns : 0.0;
+
+    /* Function Return */
+end_of_function:
+    if (backend == BENCH_BASELINE && slots != NULL)
+    {
+        for (slot = 0u; slot < workload->slot_count; ++slot)
+        {
+            free(slots[slot]);
+        }
+    }
+
+    free(slots);
+    free(sizes);
+    free(malloc_ns);
+    free(free_ns);
+
+    return ret;
+}
+
+/**
+ * @fn      BENCH_report
+ * @package MEM_bench
+ *
+ * @brief   Runs one workload against every backend and prints the results.
+ *
+ * @param   [in] workload Workload to run.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int BENCH_report(const bench_workload_t *workload)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0;
+
+    bench_result_t results[sizeof(backends) / sizeof(backends[0])];
+    size_t index            = 0u;
+
+    char fragmentation[16];
+
+    /* Start Function Logic */
+    MEM_logSetHook(NULL, NULL);
+
+    for (index = 0u; index < sizeof(backends) / sizeof(backends[0]); ++index)
+    {
+        ret |= BENCH_runBackend(workload, backends[index], &results[index]);
+    }
+
+    MEM_logSetHook(MEM_logStdio, NULL);
+
+    if (ret != 0)
+    {
+        goto end_of_function;
+    }
+
+    printf("Workload %s: %zu operations, %zu slots\n", workload->name, workload->count, workload->slot_count);
+    printf("%-16s %12s %10s %10s %10s %10s %8s %9s %9s %8s\n",
+           "Backend", "ops/s", "m p50(ns)", "m p99(ns)", "f p50(ns)", "f p99(ns)", "PeakFrag", "Peak(KB)", "Overhead",
+           "Failed");
+
+    for (index = 0u; index < sizeof(backends) / sizeof(backends[0]); ++index)
+    {
+        if (results[index].peak_fragmentation < 0.0)
+        {
+            snprintf(fragmentation, sizeof(fragmentation), "%s", "-");
+        }
+        else
+        {
+            snprintf(fragmentation, sizeof(fragmentation), "%.1f%%", results[index].peak_fragmentation * 100.0);
+        }
+
+        printf("%-16s %12.0f %10llu %10llu %10llu %10llu %8s %9zu %8.1f%% %8zu\n",
+               backend_names[index], results[index].ops_per_sec,
+               (unsigned long long)results[index].malloc_p50, (unsigned long long)results[index].malloc_p99,
+               (unsigned long long)results[index].free_p50, (unsigned long long)results[index].free_p99,
+               fragmentation, results[index].peak_bytes / 1024u, results[index].overhead * 100.0,
+               results[index].failures);
+    }
+
+    printf("\n");
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      main
+ * @package MEM_bench
+ *
+ * @brief   Benchmark entry point.
+ *
+ * @param   [in] argc Argument count.
+ * @param   [in] argv Optional operation count, slot count and trace file.
+ *
+ * @return  0 on success, 1 on failure.
+ */
+int main(int argc, char **argv)
+{
+    /* Definition of Function Variables */
+    int ret                     = 0;
+
+    size_t operations           = BENCH_DEFAULT_OPERATIONS;
+    size_t slot_count           = BENCH_DEFAULT_SLOTS;
+    size_t index                = 0u;
+
+    bench_workload_t workloads[4];
+    size_t workload_count       = 0u;
+
+    /* Check deference/argument boundaries */
+    if (argc > 1)
+    {
+        operations = (size_t)strtoul(argv[1], NULL, 10);
+    }
+
+    if (argc > 2)
+    {
+        slot_count = (size_t)strtoul(argv[2], NULL, 10);
+    }
+
+    if (operations == 0u || slot_count == 0u)
+    {
+        fprintf(stderr, "usage: %s [operations] [live_slots] [trace_file]\n", argv[0]);
+        return 1;
+    }
+
+    /* Assigning Initial Values for Variables */
+    memset(workloads, 0, sizeof(workloads));
+
+    ret |= BENCH_buildRandom(&workloads[workload_count++], operations, slot_count, 0);
+    ret |= BENCH_buildRandom(&workloads[workload_count++], operations, slot_count, 1);
+    ret |= BENCH_buildQueue(&workloads[workload_count++], operations, slot_count);
+
+    if (argc > 3)
+    {
+        ret |= BENCH_loadTrace(&workloads[workload_count++], argv[3]);
+    }
+
+    if (ret != 0)
+    {
+        fprintf(stderr, "bench_workloads: could not build the workloads (%s)\n", strerror(ret));
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    printf("Workload benchmark: heap %lu bytes\n\n", (unsigned long)HEAP_SIZE);
+
+    for (index = 0u; index < workload_count; ++index)
+    {
+        ret = BENCH_report(&workloads[index]);
+        if (ret != 0)
+        {
+            fprintf(stderr, "bench_workloads: %s workload failed (%s)\n", workloads[index].name, strerror(ret));
+            goto end_of_function;
+        }
+    }
+
+    /* Function Return */
+end_of_function:
+    for (index = 0u; index < workload_count; ++index)
+    {
+        free(workloads[index].ops);
+    }
+
+    return (ret != 0) ? 1 : 0;
+}
+
+/*** end of file ***/
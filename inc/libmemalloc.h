@@ -24,8 +24,8 @@
  *
  *  @note       
  *              - Ensure that the allocator is initialized before performing any allocation or deallocation.
- *              - The module is designed for single-threaded environments. For multi-threaded applications,
- *                synchronization mechanisms should be implemented to ensure thread safety.
+ *              - Allocators are single-threaded by default. MEM_allocatorSetThreadSafe enables a mode with
+ *                per-thread caches in front of a mutex-protected shared heap.
  *
  *  @see        - MEM_allocatorInit
  *              - MEM_allocatorMalloc 
@@ -42,7 +42,10 @@
 
 /* dependencies: */
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
+#include <pthread.h>
 
 /* =================================
  *          PUBLIC DEFINES         *
@@ -79,7 +82,7 @@
 #elif defined(__arm__) || defined(_M_ARM)
     #define ARCH_ALIGNMENT (uint8_t)(8U)                    /**< 32-bit ARM uses 8-byte alignment */
 #else
-    #define ARCH_ALIGNMENT ALIGNMENT                        /**< Default alignment for other architectures */
+    #define ARCH_ALIGNMENT (uint8_t)(2U * sizeof(size_t))   /**< Other architectures: one block header, so headers never straddle a cache line */
 #endif
 
 /**
@@ -98,6 +101,446 @@
  */
 #define ALIGN(size) (((size_t)(size) + ((size_t)ARCH_ALIGNMENT - 1)) & ~((size_t)ARCH_ALIGNMENT - 1))
 
+/**
+ * @def MEM_CACHE_LINE_SIZE
+ * @package MEM_alloc
+ * 
+ * @brief Size of a cache line of the target, in bytes.
+ *
+ * @details Used by MEM_allocatorMallocShared to keep objects shared between threads on lines
+ *          of their own. Blocks start on ARCH_ALIGNMENT boundaries and a header is exactly
+ *          ARCH_ALIGNMENT bytes, so a header never straddles two lines whatever the strategy.
+ */
+#ifndef MEM_CACHE_LINE_SIZE
+    #if defined(__aarch64__) && defined(__APPLE__)
+        #define MEM_CACHE_LINE_SIZE (128U)                  /**< Apple silicon uses 128-byte lines */
+    #else
+        #define MEM_CACHE_LINE_SIZE (64U)                   /**< x86 and most ARM cores use 64-byte lines */
+    #endif
+#endif
+
+/**
+ * @def MEM_CACHE_LINE_ALIGN
+ * @package MEM_alloc
+ * 
+ * @brief Rounds a size up to a whole number of cache lines.
+ *
+ * @param size [in]: The size to be rounded.
+ *
+ * @return The rounded size.
+ */
+#define MEM_CACHE_LINE_ALIGN(size) (((size_t)(size) + ((size_t)MEM_CACHE_LINE_SIZE - 1)) & ~((size_t)MEM_CACHE_LINE_SIZE - 1))
+
+/**
+ * @def MEM_SIZE_CLASS_MIN_SHIFT
+ * @package MEM_alloc
+ *
+ * @brief Log2 of the granularity of the smallest segregated size classes.
+ *
+ * @details Blocks smaller than 2^(MEM_SIZE_CLASS_MIN_SHIFT + MEM_SIZE_SUBCLASS_SHIFT) all
+ *          belong to size class 0, whose sub-classes are 2^MEM_SIZE_CLASS_MIN_SHIFT bytes wide.
+ */
+#define MEM_SIZE_CLASS_MIN_SHIFT (4U)
+
+/**
+ * @def MEM_NUM_SIZE_CLASSES
+ * @package MEM_alloc
+ *
+ * @brief Number of first-level (power-of-two) size classes of the segregated free lists.
+ *
+ * @details Each class owns one bit of the allocator's first-level bitmap, so the value
+ *          must not exceed the bit width of that bitmap (32). The last class also collects
+ *          every block larger than its lower bound.
+ */
+#define MEM_NUM_SIZE_CLASSES (32U)
+
+/**
+ * @def MEM_SIZE_SUBCLASS_SHIFT
+ * @package MEM_alloc
+ *
+ * @brief Log2 of the number of second-level sub-classes per size class.
+ *
+ * @details Every power-of-two class is split linearly into 2^MEM_SIZE_SUBCLASS_SHIFT free
+ *          lists, which bounds the internal waste of TLSF-Fit to 1 / 2^MEM_SIZE_SUBCLASS_SHIFT.
+ */
+#define MEM_SIZE_SUBCLASS_SHIFT (4U)
+
+/**
+ * @def MEM_NUM_SIZE_SUBCLASSES
+ * @package MEM_alloc
+ *
+ * @brief Number of second-level free lists per size class.
+ */
+#define MEM_NUM_SIZE_SUBCLASSES (1U << MEM_SIZE_SUBCLASS_SHIFT)
+
+/**
+ * @def MEM_SIZE_TREE_MIN
+ * @package MEM_alloc
+ *
+ * @brief Smallest free block, header included, kept in the Best-Fit size tree.
+ *
+ * @details Below this size every sub-class of size class 0 holds a single block size, so the
+ *          free lists alone already give an exact best fit.
+ */
+#define MEM_SIZE_TREE_MIN ((size_t)1U << (MEM_SIZE_CLASS_MIN_SHIFT + MEM_SIZE_SUBCLASS_SHIFT))
+
+/**
+ * @def MEM_BLOCK_FREE
+ * @package MEM_alloc
+ *
+ * @brief Flag bit of block_header_t::size set while the block is free.
+ *
+ * @details Block sizes are multiples of ARCH_ALIGNMENT, so the low bits of the size field are
+ *          always zero and can carry the block status flags.
+ */
+#define MEM_BLOCK_FREE ((size_t)1U)
+
+/**
+ * @def MEM_BLOCK_PREV_FREE
+ * @package MEM_alloc
+ *
+ * @brief Flag bit of block_header_t::size set while the previous physical block is free.
+ *
+ * @details When set, block_header_t::prev_size is the boundary tag of the previous block and
+ *          holds its size, which locates that block in O(1).
+ */
+#define MEM_BLOCK_PREV_FREE ((size_t)2U)
+
+/**
+ * @def MEM_BLOCK_FLAGS
+ * @package MEM_alloc
+ *
+ * @brief Mask of every flag bit packed into block_header_t::size.
+ */
+#define MEM_BLOCK_FLAGS (MEM_BLOCK_FREE | MEM_BLOCK_PREV_FREE)
+
+/**
+ * @def MEM_BLOCK_SIZE
+ * @package MEM_alloc
+ *
+ * @brief Extracts the size of a block, header included, without its flag bits.
+ *
+ * @param block [in]: Pointer to the block header.
+ *
+ * @return The block size in bytes.
+ */
+#define MEM_BLOCK_SIZE(block) ((block)->size & ~MEM_BLOCK_FLAGS)
+
+/**
+ * @def MEM_BLOCK_IS_FREE
+ * @package MEM_alloc
+ *
+ * @brief Tells whether a block is free.
+ *
+ * @param block [in]: Pointer to the block header.
+ *
+ * @return Non-zero if the block is free, 0 if it is allocated.
+ */
+#define MEM_BLOCK_IS_FREE(block) (((block)->size & MEM_BLOCK_FREE) != 0U)
+
+/**
+ * @def MEM_DEBUG_TABLE_SIZE
+ * @package MEM_alloc
+ *
+ * @brief Capacity of the allocation-source side table of debug builds.
+ *
+ * @details Debug builds (_DEBUG_) record the file, line and variable name of every live block
+ *          in an open-addressing table of this many entries, which must be a power of two.
+ *          Blocks allocated while the table is full are reported without source information.
+ */
+#ifndef MEM_DEBUG_TABLE_SIZE
+    #define MEM_DEBUG_TABLE_SIZE (4096U)
+#endif
+
+/**
+ * @def MEM_PROFILE_SITES
+ * @package MEM_alloc
+ *
+ * @brief Number of distinct (file, line) allocation sites the profiler can aggregate.
+ *
+ * @details Must be a power of two. Samples from new sites are dropped once the table is full.
+ */
+#ifndef MEM_PROFILE_SITES
+    #define MEM_PROFILE_SITES (1024U)
+#endif
+
+/**
+ * @def MEM_PROFILE_BLOCKS
+ * @package MEM_alloc
+ *
+ * @brief Number of sampled blocks the profiler can track at the same time.
+ *
+ * @details Must be a power of two. Samples are dropped while the table is full, so profiling
+ *          every allocation of a large heap needs a bigger table or a sample rate above 1.
+ */
+#ifndef MEM_PROFILE_BLOCKS
+    #define MEM_PROFILE_BLOCKS (16384U)
+#endif
+
+/**
+ * @def MEM_TCACHE_MAX_SIZE
+ * @package MEM_alloc
+ *
+ * @brief Largest payload size, in bytes, served by the per-thread caches.
+ *
+ * @details Must be a multiple of ARCH_ALIGNMENT. Larger requests always go through the
+ *          locked shared heap.
+ */
+#ifndef MEM_TCACHE_MAX_SIZE
+    #define MEM_TCACHE_MAX_SIZE (512U)
+#endif
+
+/**
+ * @def MEM_TCACHE_BINS
+ * @package MEM_alloc
+ *
+ * @brief Number of per-thread cache bins, one per ARCH_ALIGNMENT payload step.
+ */
+#define MEM_TCACHE_BINS (MEM_TCACHE_MAX_SIZE / ARCH_ALIGNMENT)
+
+/**
+ * @def MEM_TCACHE_COUNT
+ * @package MEM_alloc
+ *
+ * @brief Maximum number of blocks a thread keeps in each cache bin.
+ */
+#ifndef MEM_TCACHE_COUNT
+    #define MEM_TCACHE_COUNT (16U)
+#endif
+
+/**
+ * @def MEM_FASTBIN_MAX_SIZE
+ * @package MEM_alloc
+ *
+ * @brief Largest payload size, in bytes, whose frees are deferred in deferred coalescing mode.
+ *
+ * @details Must be a multiple of ARCH_ALIGNMENT.
+ */
+#ifndef MEM_FASTBIN_MAX_SIZE
+    #define MEM_FASTBIN_MAX_SIZE (256U)
+#endif
+
+/**
+ * @def MEM_FASTBINS
+ * @package MEM_alloc
+ *
+ * @brief Number of fast bins of an allocator, one per ARCH_ALIGNMENT payload step.
+ */
+#define MEM_FASTBINS (MEM_FASTBIN_MAX_SIZE / ARCH_ALIGNMENT)
+
+/**
+ * @def MEM_FASTBIN_LIMIT
+ * @package MEM_alloc
+ *
+ * @brief Number of blocks the fast bins of an allocator hold before frees start coalescing them.
+ */
+#ifndef MEM_FASTBIN_LIMIT
+    #define MEM_FASTBIN_LIMIT (256U)
+#endif
+
+/**
+ * @def MEM_FASTBIN_STEP
+ * @package MEM_alloc
+ *
+ * @brief Number of fast bin blocks a free coalesces while the bins are over MEM_FASTBIN_LIMIT.
+ */
+#ifndef MEM_FASTBIN_STEP
+    #define MEM_FASTBIN_STEP (4U)
+#endif
+
+/**
+ * @def MEM_TRIM_ADVICE
+ * @package MEM_alloc
+ *
+ * @brief madvise(2) advice giving the free pages of a heap back to the kernel.
+ *
+ * @details MADV_DONTNEED drops them at once, so the resident set shrinks immediately.
+ *          MADV_FREE is cheaper but only lets the kernel reclaim them under memory pressure.
+ */
+#ifndef MEM_TRIM_ADVICE
+    #define MEM_TRIM_ADVICE MADV_DONTNEED
+#endif
+
+/**
+ * @def MEM_ARENAS_MAX
+ * @package MEM_alloc
+ *
+ * @brief Maximum number of arenas in a mem_arena_set_t.
+ */
+#ifndef MEM_ARENAS_MAX
+    #define MEM_ARENAS_MAX (8U)
+#endif
+
+/**
+ * @def MEM_CHUNKS_MAX
+ * @package MEM_alloc
+ *
+ * @brief Maximum number of chunks a growable allocator can add to its heap.
+ */
+#ifndef MEM_CHUNKS_MAX
+    #define MEM_CHUNKS_MAX (32U)
+#endif
+
+/**
+ * @def MEM_HUGE_PAGE_SIZE
+ * @package MEM_alloc
+ *
+ * @brief Size of the huge pages requested by MEM_PAGES_THP and MEM_PAGES_HUGETLB backings.
+ */
+#ifndef MEM_HUGE_PAGE_SIZE
+    #define MEM_HUGE_PAGE_SIZE (2UL * 1024UL * 1024UL)
+#endif
+
+/**
+ * @def MEM_NODE_ANY
+ * @package MEM_alloc
+ *
+ * @brief Node of a mem_backing_t that leaves the placement to the kernel's default policy.
+ */
+#define MEM_NODE_ANY (-1)
+
+/**
+ * @def MEM_NUM_STRATEGIES
+ * @package MEM_alloc
+ *
+ * @brief Number of allocation strategies, the size of the per-strategy counters.
+ */
+#define MEM_NUM_STRATEGIES (5U)
+
+/**
+ * @def MEM_FRAG_BINS
+ * @package MEM_alloc
+ *
+ * @brief Number of power-of-two bins of the free-block size histogram.
+ */
+#define MEM_FRAG_BINS (32U)
+
+/**
+ * @def MEM_HEAPMAP_MAGIC
+ * @package MEM_alloc
+ *
+ * @brief First eight bytes of a binary heap map.
+ */
+#define MEM_HEAPMAP_MAGIC "MEMHMAP1"
+
+/**
+ * @def MEM_LOG_LEVEL_NONE
+ * @package MEM_alloc
+ *
+ * @brief Log levels, from most to least severe. MEM_LOG_LEVEL_NONE disables logging.
+ */
+#define MEM_LOG_LEVEL_NONE  (0)
+#define MEM_LOG_LEVEL_ERROR (1)
+#define MEM_LOG_LEVEL_WARN  (2)
+#define MEM_LOG_LEVEL_INFO  (3)
+#define MEM_LOG_LEVEL_DEBUG (4)
+
+/**
+ * @def MEM_LOG_LEVEL
+ * @package MEM_alloc
+ *
+ * @brief Most verbose log level compiled into the library.
+ *
+ * @details Messages above this level are removed at compile time, format string and
+ *          arguments included. Release builds keep errors only, so the allocation and free
+ *          paths carry no logging code; debug builds (_DEBUG_) keep everything.
+ */
+#ifndef MEM_LOG_LEVEL
+    #if defined(_DEBUG_)
+        #define MEM_LOG_LEVEL MEM_LOG_LEVEL_DEBUG
+    #else
+        #define MEM_LOG_LEVEL MEM_LOG_LEVEL_ERROR
+    #endif
+#endif
+
+/**
+ * @def MEM_TRACE_ENABLED
+ * @package MEM_alloc
+ *
+ * @brief Enables the binary trace ring, on by default in debug builds (_DEBUG_).
+ */
+#ifndef MEM_TRACE_ENABLED
+    #if defined(_DEBUG_)
+        #define MEM_TRACE_ENABLED (1)
+    #else
+        #define MEM_TRACE_ENABLED (0)
+    #endif
+#endif
+
+/**
+ * @def MEM_TRACE_RING_SIZE
+ * @package MEM_alloc
+ *
+ * @brief Number of events kept by the trace ring, a power of two.
+ */
+#ifndef MEM_TRACE_RING_SIZE
+    #define MEM_TRACE_RING_SIZE (1024U)
+#endif
+
+/**
+ * @def MEM_TRACK_CALLERS
+ * @package MEM_alloc
+ *
+ * @brief Makes the MEM_ALLOC_* macros pass file, line and variable name, on by default in debug
+ *        builds (_DEBUG_).
+ *
+ * @details When 0 the macros call the specialized entry points, MEM_allocatorMallocFirstFit and
+ *          its siblings, which take no tracking arguments and reach their strategy's finder
+ *          without the strategy switch. The profiler and the recorder then see every such call
+ *          as MEM_UNTRACKED.
+ */
+#ifndef MEM_TRACK_CALLERS
+    #if defined(_DEBUG_)
+        #define MEM_TRACK_CALLERS (1)
+    #else
+        #define MEM_TRACK_CALLERS (0)
+    #endif
+#endif
+
+/**
+ * @def MEM_UNTRACKED
+ * @package MEM_alloc
+ *
+ * @brief File and variable name reported for allocations made without call-site tracking.
+ */
+#define MEM_UNTRACKED "untracked"
+
+/**
+ * @def MEM_RECORD_BUFFER
+ * @package MEM_alloc
+ *
+ * @brief Number of allocation records each thread buffers before writing them out.
+ */
+#ifndef MEM_RECORD_BUFFER
+    #define MEM_RECORD_BUFFER (256U)
+#endif
+
+/**
+ * @def MEM_RECORD_FILES
+ * @package MEM_alloc
+ *
+ * @brief Number of distinct source files an allocation recording can name, a power of two.
+ */
+#ifndef MEM_RECORD_FILES
+    #define MEM_RECORD_FILES (256U)
+#endif
+
+/**
+ * @def MEM_RECORD_MAGIC
+ * @package MEM_alloc
+ *
+ * @brief First bytes of an allocation recording, terminator included.
+ */
+#define MEM_RECORD_MAGIC "MEMREC1"
+
+/**
+ * @def MEM_RECORD_NO_FILE
+ * @package MEM_alloc
+ *
+ * @brief File index of a record whose call site is unknown.
+ */
+#define MEM_RECORD_NO_FILE (0xFFFFU)
+
 /* =================================
  *      PUBLIC DATA STRUCTURES     *
  * ================================*/
@@ -114,176 +557,1232 @@
  */
 typedef enum 
 {
-    FIRST_FIT   = (uint8_t)(0u),                         /**< Allocates the first suitable free block */
-    NEXT_FIT    = (uint8_t)(1u),                         /**< Allocates the next suitable free block after the last allocated block */
-    BEST_FIT    = (uint8_t)(2u)                          /**< Allocates the smallest suitable free block */
+    FIRST_FIT       = (uint8_t)(0u),                     /**< Allocates the first suitable free block */
+    NEXT_FIT        = (uint8_t)(1u),                     /**< Allocates the next suitable free block after the last allocated block */
+    BEST_FIT        = (uint8_t)(2u),                     /**< Allocates the smallest suitable free block */
+    SEGREGATED_FIT  = (uint8_t)(3u),                     /**< Allocates from per-size-class free lists indexed by a bitmap */
+    TLSF_FIT        = (uint8_t)(4u)                      /**< Allocates in constant time from the two-level segregated free lists */
 } allocation_strategy_t;
 
 /**
- * @struct  block_header
+ * @enum    mem_arena_policy
  * @package MEM_alloc
  * 
- * @typedef block_header_t
+ * @typedef mem_arena_policy_t
  * 
- * @brief   Represents the header of a memory block in the heap.
- *
- * @details This structure contains metadata about each memory block, including its size,
- *          allocation status, pointers to adjacent blocks, and debug information.
+ * @brief   Defines how threads are assigned to the arenas of a mem_arena_set_t.
  */
-typedef struct block_header 
+typedef enum
 {
-    size_t size;                                        /**< Size of the block, including the header */
-    int free;                                           /**< Allocation status: 1 if free, 0 if allocated */
-
-    const char *file;                                   /**< Source file requesting the allocation */
-    int line;                                           /**< Line number in the source file */
-
-    const char *var_name;                               /**< Name of the variable associated with the allocation */
-
-    struct block_header *next;                          /**< Pointer to the next block in the free list */
-    struct block_header *prev;                          /**< Pointer to the previous block in the free list */
-} block_header_t;
+    MEM_ARENA_ROUND_ROBIN   = (uint8_t)(0u),            /**< Each thread gets the next arena on its first allocation and keeps it */
+    MEM_ARENA_BY_CPU        = (uint8_t)(1u),            /**< Each allocation uses the arena of the CPU the thread runs on */
+    MEM_ARENA_BY_NODE       = (uint8_t)(2u)             /**< Each allocation uses the arena of the NUMA node the thread runs on */
+} mem_arena_policy_t;
 
 /**
- * @struct  mem_allocator
+ * @enum    mem_page_mode
  * @package MEM_alloc
  * 
- * @typedef mem_allocator_t
+ * @typedef mem_page_mode_t
  * 
- * @brief   Represents the memory allocator's state.
- *
- * @details This structure maintains the free list, the heap's starting address, and
- *          the last allocated block for Next-Fit allocation.
+ * @brief   Page sizes a mem_backing_t maps its memory with.
  */
-typedef struct mem_allocator 
+typedef enum
 {
-    block_header_t *free_list;                          /**< Pointer to the first free block in the heap */
-    block_header_t *last_allocated;                     /**< Pointer to the last allocated block (used for Next-Fit) */
+    MEM_PAGES_DEFAULT       = (uint8_t)(0u),            /**< Base pages, as plain anonymous mmap */
+    MEM_PAGES_THP           = (uint8_t)(1u),            /**< Mapping aligned to MEM_HUGE_PAGE_SIZE and marked MADV_HUGEPAGE for transparent huge pages */
+    MEM_PAGES_HUGETLB       = (uint8_t)(2u)             /**< MAP_HUGETLB huge pages, falling back to MEM_PAGES_THP when none are reserved */
+} mem_page_mode_t;
+
+/**
+ * @enum    mem_trace_op
+ * @package MEM_alloc
+ * 
+ * @typedef mem_trace_op_t
+ * 
+ * @brief   Heap operations recorded by the trace ring.
+ */
+typedef enum
+{
+    MEM_TRACE_MALLOC    = (uint8_t)(0u),                /**< Block handed out by the shared heap, aux is the strategy */
+    MEM_TRACE_FREE      = (uint8_t)(1u),                /**< Block returned to the shared heap */
+    MEM_TRACE_SPLIT     = (uint8_t)(2u),                /**< Remainder split off an allocated block */
+    MEM_TRACE_MERGE     = (uint8_t)(3u),                /**< Free block merged with a physical neighbour */
+    MEM_TRACE_GROW      = (uint8_t)(4u),                /**< Chunk added to the heap */
+    MEM_TRACE_SHRINK    = (uint8_t)(5u),                /**< Chunk released from the heap */
+    MEM_TRACE_REALLOC   = (uint8_t)(6u)                 /**< Block resized, aux is 1 in place and 0 when moved */
+} mem_trace_op_t;
+
+/**
+ * @enum    mem_record_op
+ * @package MEM_alloc
+ * 
+ * @typedef mem_record_op_t
+ * 
+ * @brief   Kinds of records in an allocation recording.
+ */
+typedef enum
+{
+    MEM_RECORD_MALLOC   = (uint8_t)(0u),                /**< Pointer id handed out with size bytes */
+    MEM_RECORD_FREE     = (uint8_t)(1u),                /**< Pointer id released */
+    MEM_RECORD_FILE     = (uint8_t)(2u)                 /**< Name of file index, size bytes padded to whole records follow */
+} mem_record_op_t;
+
+/**
+ * @enum    mem_heapmap_format
+ * @package MEM_alloc
+ * 
+ * @typedef mem_heapmap_format_t
+ * 
+ * @brief   Encodings written by MEM_allocatorExportHeapMap.
+ */
+typedef enum
+{
+    MEM_HEAPMAP_JSON    = (uint8_t)(0u),                /**< One JSON object listing every segment and block */
+    MEM_HEAPMAP_BINARY  = (uint8_t)(1u)                 /**< Native-endian 64-bit words, one per block */
+} mem_heapmap_format_t;
+
+/**
+ * @struct  block_header
+ * @package MEM_alloc
+ * 
+ * @typedef block_header_t
+ * 
+ * @brief   Represents the header of a memory block in the heap.
+ *
+ * @details The header only holds the boundary tag of the previous block and the size of
+ *          this block with its status flags packed in, i.e. two words (16 bytes on 64-bit
+ *          targets). Physical neighbours need no pointers: the next block starts
+ *          MEM_BLOCK_SIZE bytes further, and a free previous block is found through prev_size.
+ *          Free-list links live in the payload of free blocks (see free_links_t), and the
+ *          allocation source information is kept in a side table by debug builds only.
+ */
+typedef struct block_header 
+{
+    size_t prev_size;                                   /**< Size of the previous physical block while MEM_BLOCK_PREV_FREE is set, the cookie of the allocated previous block otherwise */
+    size_t size;                                        /**< Size of the block, including the header; low bits hold MEM_BLOCK_FREE and MEM_BLOCK_PREV_FREE */
+} block_header_t;
+
+/**
+ * @struct  free_links
+ * @package MEM_alloc
+ * 
+ * @typedef free_links_t
+ * 
+ * @brief   Segregated free-list links stored in the payload of a free block.
+ *
+ * @details A free block has no user data, so its first payload bytes hold the links of the
+ *          free list it belongs to. This is why every block payload is at least
+ *          MEM_MIN_PAYLOAD_SIZE bytes long.
+ */
+typedef struct free_links
+{
+    struct block_header *next_free;                     /**< Pointer to the next block in the same segregated free list */
+    struct block_header *prev_free;                     /**< Pointer to the previous block in the same segregated free list */
+} free_links_t;
+
+/**
+ * @struct  mem_tcache_stats
+ * @package MEM_alloc
+ * 
+ * @typedef mem_tcache_stats_t
+ * 
+ * @brief   Counters of the per-thread caches.
+ *
+ * @details Each thread counts locally, without atomics; the counts are added to the owning
+ *          allocator whenever the thread's cache is flushed (explicitly or at thread exit).
+ */
+typedef struct mem_tcache_stats
+{
+    uint64_t hits;                                      /**< Allocations served from a thread cache */
+    uint64_t misses;                                    /**< Cacheable allocations that had to take the locked path */
+    uint64_t cached_frees;                              /**< Frees absorbed by a thread cache */
+    uint64_t spilled_frees;                             /**< Cacheable frees passed to the heap because the bin was full */
+    uint64_t flushes;                                   /**< Number of cache flushes */
+} mem_tcache_stats_t;
+
+/**
+ * @struct  mem_trace_event
+ * @package MEM_alloc
+ * 
+ * @typedef mem_trace_event_t
+ * 
+ * @brief   One fixed-size record of the trace ring.
+ */
+typedef struct mem_trace_event
+{
+    uint64_t sequence;                                  /**< Position of the event in the trace, starting at 1 */
+    void *ptr;                                          /**< Block header the operation applied to */
+    size_t size;                                        /**< Block size after the operation, in bytes */
+    uint32_t op;                                        /**< Operation, a mem_trace_op_t */
+    uint32_t aux;                                       /**< Operation-specific detail */
+} mem_trace_event_t;
+
+/**
+ * @struct  mem_record_header
+ * @package MEM_alloc
+ * 
+ * @typedef mem_record_header_t
+ * 
+ * @brief   Start of an allocation recording.
+ */
+typedef struct mem_record_header
+{
+    char magic[8];                                      /**< MEM_RECORD_MAGIC */
+    uint32_t version;                                   /**< Format version, 1 */
+    uint32_t record_size;                               /**< sizeof(mem_record_t) of the writer */
+} mem_record_header_t;
+
+/**
+ * @struct  mem_record
+ * @package MEM_alloc
+ * 
+ * @typedef mem_record_t
+ * 
+ * @brief   One fixed-size record of an allocation recording.
+ */
+typedef struct mem_record
+{
+    uint64_t timestamp;                                 /**< Nanoseconds since MEM_recordStart */
+    uint64_t id;                                        /**< Address of the user pointer */
+    uint64_t size;                                      /**< Requested bytes of a malloc, name length of a file record */
+    uint32_t line;                                      /**< Line of the call site */
+    uint16_t op;                                        /**< Record kind, a mem_record_op_t */
+    uint16_t file;                                      /**< Index of the call site file, MEM_RECORD_NO_FILE if unknown */
+} mem_record_t;
+
+/**
+ * @typedef mem_log_hook_t
+ * @package MEM_alloc
+ *
+ * @brief   Sink receiving every log message compiled into the library.
+ */
+typedef void (*mem_log_hook_t)(int level, const char *format, va_list args, void *context);
+
+/**
+ * @struct  mem_alloc_stats
+ * @package MEM_alloc
+ * 
+ * @typedef mem_alloc_stats_t
+ * 
+ * @brief   Counters of an allocator, maintained as it runs and read by MEM_allocatorGetStats.
+ *
+ * @details Byte counts include block headers. Blocks held in thread caches count as in use,
+ *          and the allocation and free counters only see the shared heap; thread cache hits
+ *          are reported by MEM_tcacheGetStats.
+ */
+typedef struct mem_alloc_stats
+{
+    size_t bytes_in_use;                                /**< Bytes of allocated blocks */
+    size_t peak_bytes_in_use;                           /**< Highest bytes_in_use seen after an allocation */
+    size_t free_bytes;                                  /**< Bytes of free blocks */
+    size_t largest_free_block;                          /**< Largest payload allocatable without growing the heap */
+    size_t free_blocks;                                 /**< Number of free blocks */
+
+    uint64_t mallocs[MEM_NUM_STRATEGIES];               /**< Blocks handed out by the shared heap, per strategy */
+    uint64_t frees;                                     /**< Blocks returned to the shared heap */
+    uint64_t remote_frees;                              /**< Frees of other threads drained from the remote-free list, included in frees */
+    uint64_t splits;                                    /**< Blocks split in two */
+    uint64_t merges;                                    /**< Free blocks merged with a neighbour */
+    uint64_t failed_allocations;                        /**< Allocation calls that could not be fully served */
+    uint64_t lock_acquisitions;                         /**< Times the heap lock was taken in thread-safe mode */
+    uint64_t lock_contended;                            /**< Lock acquisitions that had to wait for another thread */
+} mem_alloc_stats_t;
+
+/**
+ * @struct  mem_frag_report
+ * @package MEM_alloc
+ * 
+ * @typedef mem_frag_report_t
+ * 
+ * @brief   Fragmentation of a heap, computed by MEM_allocatorFragmentation.
+ *
+ * @details Byte counts of free blocks are payload sizes. Bin i of the histogram counts the free
+ *          blocks whose payload is in [2^i, 2^(i+1)), the last bin also holds everything larger.
+ *          requested_bytes and padding_bytes need the allocation records of debug builds and
+ *          stay 0 otherwise.
+ */
+typedef struct mem_frag_report
+{
+    size_t free_bytes;                                  /**< Payload bytes of all free blocks */
+    size_t largest_free;                                /**< Payload of the largest free block */
+    size_t free_blocks;                                 /**< Number of free blocks */
+    double external_fragmentation;                      /**< 1 - largest_free / free_bytes, 0 when nothing is free */
+    size_t free_histogram[MEM_FRAG_BINS];               /**< Free blocks per power-of-two payload bin */
+
+    size_t used_blocks;                                 /**< Number of allocated blocks */
+    size_t used_bytes;                                  /**< Payload bytes of all allocated blocks */
+    size_t header_bytes;                                /**< Bytes taken by the headers of allocated blocks */
+    size_t requested_bytes;                             /**< Bytes the callers asked for, debug builds only */
+    size_t padding_bytes;                               /**< used_bytes beyond the requests, from ALIGN and minimum sizes, debug builds only */
+} mem_frag_report_t;
+
+/**
+ * @struct  mem_profile_site
+ * @package MEM_alloc
+ * 
+ * @typedef mem_profile_site_t
+ * 
+ * @brief   Aggregated allocations of one (file, line) site, read by MEM_profileSnapshot.
+ *
+ * @details Only sampled allocations are counted. With a sample rate of N, multiplying by N
+ *          estimates the real figures.
+ */
+typedef struct mem_profile_site
+{
+    const char *file;                                   /**< Source file of the allocation site */
+    int line;                                           /**< Line number in the source file */
+
+    size_t live_bytes;                                  /**< Requested bytes of the sampled blocks still allocated */
+    size_t live_count;                                  /**< Number of sampled blocks still allocated */
+    size_t peak_bytes;                                  /**< Highest live_bytes seen */
+    uint64_t allocations;                               /**< Sampled allocations since the last reset */
+} mem_profile_site_t;
+
+/**
+ * @struct  mem_chunk_provider
+ * @package MEM_alloc
+ * 
+ * @typedef mem_chunk_provider_t
+ * 
+ * @brief   Backing store a growable allocator takes extra chunks from.
+ *
+ * @details acquire returns at least size writable bytes, or NULL when no memory is left;
+ *          release gives back a chunk previously returned by acquire, with the same size.
+ */
+typedef struct mem_chunk_provider
+{
+    void *(*acquire)(size_t size, void *context);       /**< Obtains a chunk of size bytes */
+    void (*release)(void *base, size_t size, void *context); /**< Returns a chunk obtained by acquire */
+    void *context;                                      /**< Opaque pointer passed to both callbacks */
+} mem_chunk_provider_t;
+
+/**
+ * @struct  mem_chunk
+ * @package MEM_alloc
+ * 
+ * @typedef mem_chunk_t
+ * 
+ * @brief   Extra heap segment obtained from a mem_chunk_provider_t.
+ *
+ * @details Blocks run from start to end, where a fencepost header of size 0 closes the chunk.
+ *          The descriptors live in the allocator rather than in the chunks, so a released
+ *          chunk never leaves a dangling descriptor behind.
+ */
+typedef struct mem_chunk
+{
+    uint8_t *start;                                     /**< First block of the chunk, NULL for an unused slot */
+    uint8_t *end;                                       /**< Fencepost header closing the chunk */
+
+    void *base;                                         /**< Address returned by the provider */
+    size_t length;                                      /**< Size passed to the provider */
+} mem_chunk_t;
+
+/**
+ * @struct  mem_backing
+ * @package MEM_alloc
+ * 
+ * @typedef mem_backing_t
+ * 
+ * @brief   Page size and NUMA placement of the memory behind a heap.
+ *
+ * @details Passed to MEM_allocatorInitBacked, and usable as the context of MEM_backingAcquire
+ *          and MEM_backingRelease in a mem_chunk_provider_t.
+ */
+typedef struct mem_backing
+{
+    mem_page_mode_t pages;                              /**< Page size of the mappings */
+    int node;                                           /**< NUMA node the mappings are bound to with mbind, or MEM_NODE_ANY */
+} mem_backing_t;
+
+/**
+ * @struct  mem_allocator
+ * @package MEM_alloc
+ * 
+ * @typedef mem_allocator_t
+ * 
+ * @brief   Represents the memory allocator's state.
+ *
+ * @details This structure maintains the heap's starting address,
+ *          the last allocated block for Next-Fit allocation and the two-level
+ *          segregated free lists used by Segregated-Fit and TLSF-Fit allocation.
+ */
+typedef struct mem_allocator 
+{
+    block_header_t *last_allocated;                     /**< Pointer to the last allocated block (used for Next-Fit) */
+
+    block_header_t *free_lists[MEM_NUM_SIZE_CLASSES][MEM_NUM_SIZE_SUBCLASSES];  /**< Heads of the two-level segregated free lists */
+    uint32_t fl_bitmap;                                 /**< Bit i set when size class i has a non-empty sub-class */
+    uint32_t sl_bitmap[MEM_NUM_SIZE_CLASSES];           /**< Bit j of entry i set when free_lists[i][j] is not empty */
+    block_header_t *size_tree;                          /**< Root of the (size, address) ordered tree of large free blocks used by Best-Fit */
+    block_header_t *size_tree_max;                      /**< Largest block of the size tree */
+    int size_tree_built;                                /**< Non-zero once the first Best-Fit search built the size tree, which is maintained from then on */
 
     uint8_t *heap;                                      /**< Pointer to the beginning of the heap memory */
+    size_t heap_size;                                   /**< Size of the heap memory in bytes */
+    size_t mapped_size;                                 /**< Length of the mapping backing the heap, 0 unless set up by MEM_allocatorInitMmap or MEM_allocatorInitBacked */
+    uintptr_t cookie;                                   /**< Secret key of the cookies sealing allocated blocks */
+
+    mem_chunk_t chunks[MEM_CHUNKS_MAX];                 /**< Chunks added by heap growth */
+    size_t chunk_count;                                 /**< Slots of chunks ever used; slots past it are all empty */
+    mem_chunk_provider_t provider;                      /**< Backing store of the grown chunks */
+    mem_backing_t backing;                              /**< Placement of the heap set by MEM_allocatorInitBacked, context of its chunk provider */
+    size_t chunk_size;                                  /**< Minimum size of a grown chunk, 0 when growth is disabled */
+    size_t release_threshold;                           /**< Bytes of fully empty chunks kept before they are released */
+    size_t trim_threshold;                              /**< Free block size from which frees give their pages back, 0 when off */
+
+    pthread_mutex_t lock;                               /**< Serializes the shared heap when thread_safe is set */
+    int thread_safe;                                    /**< Non-zero once MEM_allocatorSetThreadSafe enabled the thread-safe mode */
+    block_header_t *remote_free;                        /**< Lock-free list of blocks freed by threads that do not cache this allocator */
+
+    int deferred_coalescing;                            /**< Non-zero once MEM_allocatorSetDeferredCoalescing enabled the fast bins */
+    block_header_t *fastbins[MEM_FASTBINS];             /**< Heads of the per-size lists of freed blocks waiting to be coalesced */
+    size_t fastbin_count;                               /**< Number of blocks held by the fast bins */
+    size_t fastbin_cursor;                              /**< Next bin the incremental coalescing looks at */
+    mem_tcache_stats_t tcache_stats;                    /**< Thread cache counters merged from flushed caches */
+
+    size_t heap_bytes;                                  /**< Bytes of all segments, fenceposts excluded */
+    mem_alloc_stats_t stats;                            /**< Incremental counters; bytes_in_use and largest_free_block are derived on read */
 } mem_allocator_t;
 
+/**
+ * @struct  mem_arena_set
+ * @package MEM_alloc
+ * 
+ * @typedef mem_arena_set_t
+ * 
+ * @brief   Group of independent thread-safe allocators sharing the static heap.
+ *
+ * @details Each arena owns its own slice of the heap, with its own free lists and lock, so
+ *          threads working in different arenas share neither metadata nor locks.
+ */
+typedef struct mem_arena_set
+{
+    mem_allocator_t arenas[MEM_ARENAS_MAX];             /**< The arenas, only the first count are in use */
+    size_t count;                                       /**< Number of arenas in use */
+
+    mem_arena_policy_t policy;                          /**< Thread-to-arena assignment policy */
+    size_t next_arena;                                  /**< Round-robin counter, updated atomically */
+} mem_arena_set_t;
+
+/**
+ * @def MEM_FREE_LINKS
+ * @package MEM_alloc
+ *
+ * @brief Accesses the free-list links stored in the payload of a free block.
+ *
+ * @param block [in]: Pointer to the block header.
+ *
+ * @return Pointer to the block's free_links_t.
+ */
+#define MEM_FREE_LINKS(block) ((free_links_t *)((uint8_t *)(block) + sizeof(block_header_t)))
+
+/**
+ * @def MEM_MIN_PAYLOAD_SIZE
+ * @package MEM_alloc
+ *
+ * @brief Smallest payload a block can have, so that it can hold its free-list links once freed.
+ */
+#define MEM_MIN_PAYLOAD_SIZE ALIGN(sizeof(free_links_t))
+
 /* =================================
  *   PUBLIC  FUNCTION PROTOTYPES   *
  * ================================*/
 
 /**
- * @fn      MEM_printd
+ * @fn      MEM_logWrite
+ * @package MEM_alloc
+ * 
+ * @brief   Sends a message to the log hook.
+ *
+ * @details Library code logs through the MEM_LOG_* macros, which drop messages above
+ *          MEM_LOG_LEVEL at compile time. This function always emits.
+ *
+ * @param   [in] level  Level of the message.
+ * @param   [in] format Format string.
+ * @param   [in] ...    Variable arguments corresponding to the format string.
+ */
+void MEM_logWrite(int level, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @fn      MEM_logSetHook
+ * @package MEM_alloc
+ * 
+ * @brief   Replaces the log hook.
+ *
+ * @details The default hook, MEM_logStdio, writes errors and warnings to stderr and the
+ *          other levels to stdout. A NULL hook discards every message. Set the hook before
+ *          allocators are shared between threads.
+ *
+ * @param   [in] hook    New log hook, or NULL.
+ * @param   [in] context Opaque pointer passed to the hook.
+ */
+void MEM_logSetHook(mem_log_hook_t hook, void *context);
+
+/**
+ * @fn      MEM_logStdio
+ * @package MEM_alloc
+ * 
+ * @brief   Default log hook, writing to stderr or stdout depending on the level.
+ *
+ * @param   [in] level   Level of the message.
+ * @param   [in] format  Format string.
+ * @param   [in] args    Arguments corresponding to the format string.
+ * @param   [in] context Unused.
+ */
+void MEM_logStdio(int level, const char *format, va_list args, void *context);
+
+/**
+ * @fn      MEM_printd
+ * @package MEM_alloc
+ * 
+ * @brief   Prints debug messages.
+ *
+ * @details Sends the message to the log hook at MEM_LOG_LEVEL_DEBUG, whatever MEM_LOG_LEVEL
+ *          the library was built with.
+ *
+ * @param   [in] format Format string.
+ * @param   [in] ...    Variable arguments corresponding to the format string.
+ */
+void MEM_printd(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @fn      MEM_traceSnapshot
+ * @package MEM_alloc
+ * 
+ * @brief   Copies the most recent events of the trace ring.
+ *
+ * @details Events are copied oldest first. Events being overwritten during the copy are
+ *          skipped. Returns 0 when the library was built without MEM_TRACE_ENABLED.
+ *
+ * @param   [out] events     Destination array.
+ * @param   [in]  max_events Capacity of the destination array.
+ *
+ * @return  Number of events copied.
+ */
+size_t MEM_traceSnapshot(mem_trace_event_t *events, size_t max_events);
+
+/**
+ * @fn      MEM_recordStart
+ * @package MEM_alloc
+ * 
+ * @brief   Starts recording every allocation and free to a binary file.
+ *
+ * @details Each MEM_allocatorMalloc that succeeds and each MEM_allocatorFree of a non-NULL
+ *          pointer, and so every call built on them, appends a mem_record_t with a timestamp,
+ *          the pointer, the size and the file:line site to a buffer of the calling thread. Appending takes no lock and
+ *          formats nothing; a full buffer is written out with one write(2), and a thread's
+ *          buffer is also written when the thread exits and by MEM_recordStop. A realloc done in place is recorded
+ *          as a free and an allocation of the same pointer. The file starts with a
+ *          mem_record_header_t and is replayed by bench_workloads.
+ *
+ * @param   [in] path File to create or truncate.
+ *
+ * @return  0 on success, EBUSY while a recording runs, other error code on failure.
+ */
+int MEM_recordStart(const char *path);
+
+/**
+ * @fn      MEM_recordFlush
+ * @package MEM_alloc
+ * 
+ * @brief   Writes out the records buffered by the calling thread.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_recordFlush(void);
+
+/**
+ * @fn      MEM_recordStop
+ * @package MEM_alloc
+ * 
+ * @brief   Ends the recording and closes its file.
+ *
+ * @details Writes out the records buffered by every thread, running or not, after waiting
+ *          for the records and writes in progress, appends a MEM_RECORD_FILE record per source
+ *          file seen and closes the file.
+ *
+ * @return  0 on success, EINVAL when no recording runs, other error code on failure.
+ */
+int MEM_recordStop(void);
+
+/**
+ * @fn      MEM_allocatorInit
+ * @package MEM_alloc
+ * 
+ * @brief   Initializes the memory allocator.
+ *
+ * @details Sets up the memory allocator by creating the initial free block that spans the
+ *          entire heap. Only the block headers are written; the heap is not cleared, so its
+ *          pages are only committed once allocations touch them. Memory returned by
+ *          MEM_allocatorMalloc is therefore uninitialized; use MEM_allocatorCalloc for
+ *          zeroed memory.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure to be initialized.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorInit(mem_allocator_t *allocator);
+
+/**
+ * @fn      MEM_allocatorInitRegion
+ * @package MEM_alloc
+ * 
+ * @brief   Initializes the memory allocator over a caller-supplied memory region.
+ *
+ * @details The region is trimmed to ARCH_ALIGNMENT at both ends and stays owned by the caller,
+ *          which must keep it alive while the allocator is in use. Any number of allocators may
+ *          run side by side over disjoint regions, e.g. hugepage-backed ones.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure to be initialized.
+ * @param   [in]     base      First byte of the region.
+ * @param   [in]     size      Size of the region in bytes.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorInitRegion(mem_allocator_t *allocator, void *base, size_t size);
+
+/**
+ * @fn      MEM_allocatorInitMmap
+ * @package MEM_alloc
+ * 
+ * @brief   Initializes the memory allocator over an anonymous private mapping.
+ *
+ * @details Maps size bytes, rounded up to the page size, so the heap can be sized at run
+ *          time. The mapping is released by MEM_allocatorDestroy.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure to be initialized.
+ * @param   [in]     size      Requested heap size in bytes.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorInitMmap(mem_allocator_t *allocator, size_t size);
+
+/**
+ * @fn      MEM_allocatorInitBacked
+ * @package MEM_alloc
+ * 
+ * @brief   Initializes the memory allocator over a mapping with a given page size and node.
+ *
+ * @details Maps the heap with MEM_backingAcquire and keeps a copy of backing in the allocator.
+ *          Growth stays off until MEM_allocatorSetGrowth; passing a provider of
+ *          MEM_backingAcquire and MEM_backingRelease with &allocator->backing as context makes
+ *          grown chunks follow the same placement.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure to be initialized.
+ * @param   [in]     size      Requested heap size in bytes, rounded up to the page size used.
+ * @param   [in]     backing   Page size and node of the heap.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorInitBacked(mem_allocator_t *allocator, size_t size, const mem_backing_t *backing);
+
+/**
+ * @fn      MEM_backingAcquire
+ * @package MEM_alloc
+ * 
+ * @brief   Chunk provider mapping memory with the page size and node of a mem_backing_t.
+ *
+ * @details Huge page mappings are rounded up to MEM_HUGE_PAGE_SIZE. MEM_PAGES_THP maps the
+ *          region aligned to a huge page and advises MADV_HUGEPAGE; MEM_PAGES_HUGETLB tries
+ *          MAP_HUGETLB first. A node other than MEM_NODE_ANY binds the pages to it with mbind
+ *          before they are touched, so they never land on the node of the first toucher. A
+ *          failing hint is ignored, only a failing mapping fails.
+ *
+ * @param   [in] size    Size of the chunk in bytes.
+ * @param   [in] context Pointer to a mem_backing_t, or NULL for base pages on any node.
+ *
+ * @return  Pointer to the chunk, or NULL on failure.
+ */
+void *MEM_backingAcquire(size_t size, void *context);
+
+/**
+ * @fn      MEM_backingRelease
+ * @package MEM_alloc
+ * 
+ * @brief   Returns a chunk obtained from MEM_backingAcquire.
+ *
+ * @param   [in] base    Chunk returned by MEM_backingAcquire.
+ * @param   [in] size    Size passed to MEM_backingAcquire.
+ * @param   [in] context Same mem_backing_t as given to MEM_backingAcquire.
+ */
+void MEM_backingRelease(void *base, size_t size, void *context);
+
+/**
+ * @fn      MEM_numaNodeCount
+ * @package MEM_alloc
+ * 
+ * @brief   Returns the number of NUMA nodes of the machine.
+ *
+ * @return  Highest online node plus one, 1 when the topology cannot be read.
+ */
+size_t MEM_numaNodeCount(void);
+
+/**
+ * @fn      MEM_allocatorDestroy
+ * @package MEM_alloc
+ * 
+ * @brief   Tears an allocator down.
+ *
+ * @details Flushes the calling thread's cache for the allocator, releases every grown chunk,
+ *          unmaps a heap created by MEM_allocatorInitMmap and destroys the allocator lock. Every pointer served by the
+ *          allocator becomes invalid.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorDestroy(mem_allocator_t *allocator);
+
+/**
+ * @fn      MEM_allocatorSetGrowth
+ * @package MEM_alloc
+ * 
+ * @brief   Lets an allocator grow when its heap is exhausted.
+ *
+ * @details When no free block fits a request, the allocator takes a chunk of at least
+ *          chunk_size bytes from the provider, links it into its heap and retries; at most
+ *          MEM_CHUNKS_MAX chunks can be live at a time. Chunks that become fully empty are
+ *          handed back once the empty chunks add up to more than release_threshold bytes.
+ *          The initial heap is never released. The settings can only change while no grown
+ *          chunk is live.
+ *
+ * @param   [in/out] allocator         Pointer to the memory allocator structure.
+ * @param   [in]     provider          Backing store, or NULL for anonymous mmap.
+ * @param   [in]     chunk_size        Minimum size of a chunk, 0 to disable growth.
+ * @param   [in]     release_threshold Bytes of empty chunks to keep for later reuse.
+ *
+ * @return  0 on success, EBUSY while grown chunks are live, other error code on failure.
+ */
+int MEM_allocatorSetGrowth(mem_allocator_t *allocator, const mem_chunk_provider_t *provider, size_t chunk_size, size_t release_threshold);
+
+/**
+ * @fn      MEM_allocatorSetThreadSafe
+ * @package MEM_alloc
+ * 
+ * @brief   Enables or disables the thread-safe mode of an allocator.
+ *
+ * @details In thread-safe mode every thread keeps a bounded cache of recently freed small
+ *          blocks (up to MEM_TCACHE_MAX_SIZE bytes) and serves matching allocations from it
+ *          without locks or atomics. Misses, large requests and overflowing frees take the
+ *          allocator's mutex. A thread caches blocks of a single allocator, the first
+ *          thread-safe one it uses. Must be called before the allocator is shared.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     enable    Non-zero to enable the thread-safe mode, 0 to disable it.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorSetThreadSafe(mem_allocator_t *allocator, int enable);
+
+/**
+ * @fn      MEM_allocatorSetDeferredCoalescing
+ * @package MEM_alloc
+ * 
+ * @brief   Enables or disables deferred coalescing of small blocks.
+ *
+ * @details While enabled, freed blocks of up to MEM_FASTBIN_MAX_SIZE bytes are not merged but
+ *          pushed on per-size fast bins, still marked allocated, and an allocation of the same
+ *          size pops them back without a search or a split. Coalescing happens lazily: all
+ *          bins when an allocation finds no free block, and MEM_FASTBIN_STEP blocks per free
+ *          while the bins hold more than MEM_FASTBIN_LIMIT. Disabling coalesces every bin.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     enable    Non-zero to enable deferred coalescing, 0 to disable it.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorSetDeferredCoalescing(mem_allocator_t *allocator, int enable);
+
+/**
+ * @fn      MEM_allocatorTrim
+ * @package MEM_alloc
+ * 
+ * @brief   Gives the free memory of a heap back to the operating system.
+ *
+ * @details Coalesces the deferred and remotely freed blocks, releases every fully empty chunk
+ *          regardless of the release threshold, then walks each segment in physical order and
+ *          advises MEM_TRIM_ADVICE on the whole pages inside every free block. The header and
+ *          free-list node of a block, the pad bytes after them and the next block's header
+ *          stay resident. The address space is kept, so trimmed pages come back zero-filled
+ *          on their next use. Blocks cached by threads stay cached.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     pad       Bytes of each free block kept resident after its metadata.
+ *
+ * @return  Number of bytes given back, 0 with errno set to EINVAL for invalid arguments.
+ */
+size_t MEM_allocatorTrim(mem_allocator_t *allocator, size_t pad);
+
+/**
+ * @fn      MEM_allocatorSetTrimThreshold
+ * @package MEM_alloc
+ * 
+ * @brief   Makes frees give the pages of large free blocks back as they happen.
+ *
+ * @details Incremental trimming: whenever a free leaves a free block of at least threshold
+ *          bytes, the whole pages of the freed block inside it are advised MEM_TRIM_ADVICE.
+ *          A free costs at most one madvise(2), over the bytes it freed.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     threshold Smallest free block size trimmed on free, 0 to disable.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorSetTrimThreshold(mem_allocator_t *allocator, size_t threshold);
+
+/**
+ * @fn      MEM_tcacheFlush
+ * @package MEM_alloc
+ * 
+ * @brief   Returns every block cached by the calling thread to its allocator.
+ *
+ * @details Also merges the thread's cache counters into the allocator. Happens automatically
+ *          at thread exit; call it explicitly before re-initializing an allocator that the
+ *          thread has used in thread-safe mode.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_tcacheFlush(void);
+
+/**
+ * @fn      MEM_tcacheGetStats
+ * @package MEM_alloc
+ * 
+ * @brief   Reads the thread cache counters of an allocator.
+ *
+ * @details Returns the counters merged from flushed caches plus the live counters of the
+ *          calling thread's cache when it belongs to this allocator.
+ *
+ * @param   [in]  allocator Pointer to the memory allocator structure.
+ * @param   [out] stats     Output parameter receiving the counters.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_tcacheGetStats(mem_allocator_t *allocator, mem_tcache_stats_t *stats);
+
+/**
+ * @fn      MEM_findFirstFit
+ * @package MEM_alloc
+ * 
+ * @brief   Finds the first free block that can accommodate the requested size.
+ *
+ * @details Implements the First-Fit allocation strategy by walking the heap in address order and
+ *          returning the first free block that is large enough to satisfy the allocation request.
+ *
+ * @param   [in]      allocator Pointer to the memory allocator structure.
+ * @param   [in]      size      Requested memory size.
+ * @param   [out]     fit_block Output parameter to store the found free block.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int MEM_findFirstFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block);
+
+/**
+ * @fn      MEM_findNextFit
+ * @package MEM_alloc
+ * 
+ * @brief   Finds the next suitable free block starting from the last allocated block.
+ *
+ * @details Implements the Next-Fit allocation strategy by continuing the search from where the last
+ *          allocation occurred, potentially improving allocation distribution and reducing fragmentation.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Requested memory size.
+ * @param   [out]    fit_block Output parameter to store the found free block.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int MEM_findNextFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block);
+
+/**
+ * @fn      MEM_findBestFit
+ * @package MEM_alloc
+ * 
+ * @brief   Finds the best-fit free block for the requested size.
+ *
+ * @details Implements the Best-Fit allocation strategy by selecting the smallest free block that is
+ *          large enough to satisfy the allocation request, the lowest-addressed one among equals,
+ *          aiming to minimize fragmentation. Blocks of at least MEM_SIZE_TREE_MIN bytes are found by a
+ *          lower-bound search of the size tree in expected O(log n); smaller requests first check the
+ *          exact-size lists of size class 0 through its bitmap and scan the smallest non-empty one
+ *          for its lowest address. The first call builds the tree, which the free list updates
+ *          maintain from then on.
+ *
+ * @param   [in]      allocator Pointer to the memory allocator structure.
+ * @param   [in]      size      Requested memory size.
+ * @param   [out]     best_fit  Output parameter to store the best-fit free block.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int MEM_findBestFit(mem_allocator_t *allocator, size_t size, block_header_t **best_fit);
+
+/**
+ * @fn      MEM_findSegregatedFit
+ * @package MEM_alloc
+ * 
+ * @brief   Finds a free block through the segregated size-class free lists.
+ *
+ * @details Implements the Segregated-Fit allocation strategy. The free list matching the
+ *          request is scanned first; when it holds no suitable block, the bitmaps yield
+ *          the next non-empty larger list, whose head fits by construction.
+ *
+ * @param   [in]      allocator Pointer to the memory allocator structure.
+ * @param   [in]      size      Requested memory size.
+ * @param   [out]     fit_block Output parameter to store the found free block.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int MEM_findSegregatedFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block);
+
+/**
+ * @fn      MEM_findTlsfFit
+ * @package MEM_alloc
+ * 
+ * @brief   Finds a free block in constant time with the Two-Level Segregated Fit strategy.
+ *
+ * @details Rounds the request up to the next sub-class boundary so that any block of the
+ *          resulting list fits, then locates the first non-empty list at or above it with
+ *          two bitmap lookups (find-first-set on the second and first level).
+ *
+ * @param   [in]      allocator Pointer to the memory allocator structure.
+ * @param   [in]      size      Requested memory size.
+ * @param   [out]     fit_block Output parameter to store the found free block.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int MEM_findTlsfFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block);
+
+/**
+ * @fn      MEM_splitBlock
+ * @package MEM_alloc
+ * 
+ * @brief   Splits a free block into two if possible.
+ *
+ * @details Divides a larger free block into an allocated block and a smaller free b
+ *          lock while maintaining alignment constraints. Updates the free lists and boundary tags accordingly.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Pointer to the block to be split.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_splitBlock(mem_allocator_t *allocator, block_header_t *block, size_t size);
+
+/**
+ * @fn      MEM_allocatorMalloc
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory using the custom allocator.
+ *
+ * @details Allocates a block of memory of the specified size from the allocator's heap. It aligns the size,
+ *          selects the allocation strategy, finds the appropriate-fit block, splits it if necessary,
+ *          and updates the block's metadata with the allocation source information.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variable being allocated.
+ * @param   [in]     strategy  Allocation strategy to use (FIRST_FIT, NEXT_FIT, BEST_FIT, SEGREGATED_FIT, TLSF_FIT).
+ *
+ * @return Pointer to the allocated memory on success, or NULL with errno set to EINVAL for invalid
+ *         arguments and to ENOMEM when no block fits, even after the heap grew.
+ */
+void *MEM_allocatorMalloc(mem_allocator_t *allocator, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy);
+
+/**
+ * @fn      MEM_allocatorMallocFirstFit
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory with the First-Fit strategy, without call-site tracking.
+ *
+ * @details Same result as MEM_allocatorMalloc with FIRST_FIT. The allocation path is
+ *          compiled for this strategy alone: the strategy switch and its unknown-strategy
+ *          check are gone and the finder is called directly.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMallocFirstFit(mem_allocator_t *allocator, size_t size);
+
+/**
+ * @fn      MEM_allocatorMallocNextFit
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory with the Next-Fit strategy, without call-site tracking.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMallocNextFit(mem_allocator_t *allocator, size_t size);
+
+/**
+ * @fn      MEM_allocatorMallocBestFit
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory with the Best-Fit strategy, without call-site tracking.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMallocBestFit(mem_allocator_t *allocator, size_t size);
+
+/**
+ * @fn      MEM_allocatorMallocSegregatedFit
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory with the Segregated-Fit strategy, without call-site tracking.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMallocSegregatedFit(mem_allocator_t *allocator, size_t size);
+
+/**
+ * @fn      MEM_allocatorMallocTlsfFit
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory with the TLSF-Fit strategy, without call-site tracking.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMallocTlsfFit(mem_allocator_t *allocator, size_t size);
+
+/**
+ * @fn      MEM_allocatorCalloc
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates zero-initialized memory for an array using the custom allocator.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     nmemb     Number of elements.
+ * @param   [in]     size      Size of each element.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variable being allocated.
+ * @param   [in]     strategy  Allocation strategy to use.
+ *
+ * @return  Pointer to the zeroed memory on success, or NULL on failure (errno is ENOMEM when
+ *          nmemb * size overflows).
+ */
+void *MEM_allocatorCalloc(mem_allocator_t *allocator, size_t nmemb, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy);
+
+/**
+ * @fn      MEM_allocatorRealloc
+ * @package MEM_alloc
+ * 
+ * @brief   Changes the size of an allocated block, in place when possible.
+ *
+ * @details Shrinking splits the tail off the block. Growing absorbs a free physical successor.
+ *          Only when neither applies is the payload copied to a new block allocated with the
+ *          given strategy. On failure the original block is left untouched. A NULL ptr
+ *          allocates; a size of 0 frees ptr and returns NULL.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     ptr       Pointer to the memory to resize, or NULL.
+ * @param   [in]     size      New size in bytes.
+ * @param   [in]     file      Name of the file requesting the reallocation.
+ * @param   [in]     line      Line number in the file requesting the reallocation.
+ * @param   [in]     var_name  Name of the variable being reallocated.
+ * @param   [in]     strategy  Allocation strategy used when the block has to move.
+ *
+ * @return  Pointer to the resized memory on success, or NULL on failure.
+ */
+void *MEM_allocatorRealloc(mem_allocator_t *allocator, void *ptr, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy);
+
+/**
+ * @fn      MEM_allocatorMemalign
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory whose address is a multiple of alignment.
+ *
+ * @details The leading slack of the fit block is split off as a free block, so no memory is
+ *          lost to over-allocation. The result is freed with MEM_allocatorFree. A block moved
+ *          by MEM_allocatorRealloc only keeps ARCH_ALIGNMENT.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     alignment Required alignment, a power of two.
+ * @param   [in]     size      Size of memory to allocate.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variable being allocated.
+ * @param   [in]     strategy  Allocation strategy to use.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMemalign(mem_allocator_t *allocator, size_t alignment, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy);
+
+/**
+ * @fn      MEM_allocatorMallocShared
  * @package MEM_alloc
  * 
- * @brief   Prints debug messages.
+ * @brief   Allocates memory for an object shared between threads, on cache lines of its own.
  *
- * @details Formats and prints debug messages to the standard output using variable arguments.
+ * @details The payload starts on a MEM_CACHE_LINE_SIZE boundary and is padded to whole lines,
+ *          so no other object shares a line with it and writes from different cores do not
+ *          ping-pong the line. Costs up to one line of padding plus the alignment slack, which
+ *          is returned to the free lists. Free it with MEM_allocatorFree; a block moved by
+ *          MEM_allocatorRealloc only keeps ARCH_ALIGNMENT.
  *
- * @param   [in] format Format string.
- * @param   [in] ...    Variable arguments corresponding to the format string.
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variable being allocated.
+ * @param   [in]     strategy  Allocation strategy to use.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
  */
-void MEM_printd(const char *format, ...);
+void *MEM_allocatorMallocShared(mem_allocator_t *allocator, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy);
 
 /**
- * @fn      MEM_allocatorInit
+ * @fn      MEM_allocatorMallocBatch
  * @package MEM_alloc
  * 
- * @brief   Initializes the memory allocator.
+ * @brief   Allocates count blocks of the same size in one call.
  *
- * @details Sets up the memory allocator by zero-initializing the heap and creating 
- *          the initial free block that spans the entire heap.    
+ * @details Validation, locking and the strategy search are paid once per fit block instead of
+ *          once per allocation: each fit block is cut into as many consecutive blocks as it
+ *          holds, in a single pass.
  *
- * @param   [in/out] allocator Pointer to the memory allocator structure to be initialized.
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of each block.
+ * @param   [in]     count     Number of blocks to allocate.
+ * @param   [out]    out_ptrs  Receives the allocated pointers.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variables being allocated.
+ * @param   [in]     strategy  Allocation strategy to use.
  *
- * @return  0 on success, error code on failure.
+ * @return  Number of pointers stored in out_ptrs; fewer than count when the heap ran out.
  */
-int MEM_allocatorInit(mem_allocator_t *allocator);
+size_t MEM_allocatorMallocBatch(mem_allocator_t *allocator, size_t size, size_t count, void **out_ptrs, const char *file, int line, const char *var_name, allocation_strategy_t strategy);
 
 /**
- * @fn      MEM_findFirstFit
+ * @fn      MEM_allocatorFreeBatch
  * @package MEM_alloc
  * 
- * @brief   Finds the first free block that can accommodate the requested size.
+ * @brief   Frees count blocks in one call.
  *
- * @details Implements the First-Fit allocation strategy by searching the free list and returning
- *          the first block that is large enough to satisfy the allocation request.
+ * @details Sorts ptrs by address, then fuses each run of physically adjacent blocks so it is
+ *          merged and linked into the free lists once. Invalid pointers and double frees are
+ *          reported and skipped.
  *
- * @param   [in]      allocator Pointer to the memory allocator structure.
- * @param   [in]      size      Requested memory size.
- * @param   [out]     fit_block Output parameter to store the found free block.
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] ptrs      Pointers to free, reordered by the call.
+ * @param   [in]     count     Number of pointers.
+ * @param   [in]     file      Name of the file requesting the free operation.
+ * @param   [in]     line      Line number in the file requesting the free operation.
+ * @param   [in]     var_name  Name of the variables being freed.
  *
- * @return 0 on success, error code on failure.
+ * @return  0 on success, EINVAL if any pointer was rejected.
  */
-int MEM_findFirstFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block);
+int MEM_allocatorFreeBatch(mem_allocator_t *allocator, void **ptrs, size_t count, const char *file, int line, const char *var_name);
 
 /**
- * @fn      MEM_findNextFit
+ * @fn      MEM_allocatorGetStats
  * @package MEM_alloc
  * 
- * @brief   Finds the next suitable free block starting from the last allocated block.
+ * @brief   Reads the counters of an allocator.
  *
- * @details Implements the Next-Fit allocation strategy by continuing the search from where the last
- *          allocation occurred, potentially improving allocation distribution and reducing fragmentation.
+ * @details Every counter is maintained incrementally by the allocation and free paths, so the
+ *          read is O(1) whatever the heap size. It takes the allocator lock in thread-safe mode.
  *
  * @param   [in/out] allocator Pointer to the memory allocator structure.
- * @param   [in]     size      Requested memory size.
- * @param   [out]    fit_block Output parameter to store the found free block.
+ * @param   [out]    stats     Receives the counters.
  *
- * @return 0 on success, error code on failure.
+ * @return  0 on success, error code on failure.
  */
-int MEM_findNextFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block);
+int MEM_allocatorGetStats(mem_allocator_t *allocator, mem_alloc_stats_t *stats);
 
 /**
- * @fn      MEM_findBestFit
+ * @fn      MEM_allocatorFragmentation
  * @package MEM_alloc
  * 
- * @brief   Finds the best-fit free block for the requested size.
+ * @brief   Measures how fragmented a heap is.
  *
- * @details Implements the Best-Fit allocation strategy by searching the free list and selecting
- *          the smallest block that is large enough to satisfy the allocation request, aiming to
- *          minimize fragmentation.
+ * @details Walks every block of the heap and its chunks in physical order, so the cost is
+ *          linear in the number of blocks. It takes the allocator lock in thread-safe mode.
  *
- * @param   [in]      allocator Pointer to the memory allocator structure.
- * @param   [in]      size      Requested memory size.
- * @param   [out]     best_fit  Output parameter to store the best-fit free block.
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [out]    report    Receives the fragmentation figures.
  *
- * @return 0 on success, error code on failure.
+ * @return  0 on success, error code on failure.
  */
-int MEM_findBestFit(mem_allocator_t *allocator, size_t size, block_header_t **best_fit);
+int MEM_allocatorFragmentation(mem_allocator_t *allocator, mem_frag_report_t *report);
 
 /**
- * @fn      MEM_splitBlock
+ * @fn      MEM_allocatorExportHeapMap
  * @package MEM_alloc
  * 
- * @brief   Splits a free block into two if possible.
+ * @brief   Writes the layout of a heap for external tooling.
  *
- * @details Divides a larger free block into an allocated block and a smaller free b
- *          lock while maintaining alignment constraints. Updates the free list accordingly.
+ * @details Both formats list the segments (the heap, then each chunk) with their base address
+ *          and length, and the blocks of each segment in physical order; block offsets follow
+ *          from the sizes.
+ *
+ *          - MEM_HEAPMAP_JSON writes {"segments":[{"base":"0x..","size":N,"blocks":[[size,free],..]}]},
+ *            sizes including the block header.
+ *          - MEM_HEAPMAP_BINARY writes MEM_HEAPMAP_MAGIC and then, per segment, the base, the
+ *            length and one word per block holding its size with bit 0 set when free,
+ *            terminated by a zero word. Every field is a native-endian uint64_t.
  *
  * @param   [in/out] allocator Pointer to the memory allocator structure.
- * @param   [in/out] block     Pointer to the block to be split.
- * @param   [in]     size      Size of memory to allocate.
+ * @param   [in]     stream    Stream the map is written to.
+ * @param   [in]     format    Encoding of the map.
  *
  * @return  0 on success, error code on failure.
  */
-int MEM_splitBlock(mem_allocator_t *allocator, block_header_t *block, size_t size);
+int MEM_allocatorExportHeapMap(mem_allocator_t *allocator, FILE *stream, mem_heapmap_format_t format);
 
 /**
- * @fn      MEM_allocatorMalloc
+ * @fn      MEM_profileSetRate
  * @package MEM_alloc
  * 
- * @brief   Allocates memory using the custom allocator.
+ * @brief   Starts, tunes or stops the allocation-site profiler.
  *
- * @details Allocates a block of memory of the specified size from the allocator's heap. It aligns the size,
- *          selects the allocation strategy, finds the appropriate-fit block, splits it if necessary,
- *          and updates the block's metadata with the allocation source information.
+ * @details Each thread samples one allocation out of every rate it makes, through any
+ *          allocator of the process. Sampled blocks are aggregated per (file, line) and removed
+ *          from their site when freed. While nothing is sampled, allocations and frees cost one
+ *          relaxed load each.
  *
- * @param   [in/out] allocator Pointer to the memory allocator structure.
- * @param   [in]     size      Size of memory to allocate.
- * @param   [in]     file      Name of the file requesting the allocation.
- * @param   [in]     line      Line number in the file requesting the allocation.
- * @param   [in]     var_name  Name of the variable being allocated.
- * @param   [in]     strategy  Allocation strategy to use (FIRST_FIT, NEXT_FIT, BEST_FIT).
+ * @param   [in] rate 0 to stop sampling, 1 to profile every allocation, N for one in N.
+ */
+void MEM_profileSetRate(uint32_t rate);
+
+/**
+ * @fn      MEM_profileSnapshot
+ * @package MEM_alloc
+ * 
+ * @brief   Copies the profiled allocation sites, largest live bytes first.
+ *
+ * @param   [out] sites     Buffer that receives the sites.
+ * @param   [in]  max_sites Capacity of sites.
  *
- * @return Pointer to the allocated memory on success, or NULL on failure.
+ * @return  Number of sites copied.
  */
-void *MEM_allocatorMalloc(mem_allocator_t *allocator, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy);
+size_t MEM_profileSnapshot(mem_profile_site_t *sites, size_t max_sites);
+
+/**
+ * @fn      MEM_profileReset
+ * @package MEM_alloc
+ * 
+ * @brief   Forgets every profiled site and sampled block, keeping the sample rate.
+ */
+void MEM_profileReset(void);
 
 /**
  * @fn      MEM_validPointerCheck
@@ -291,8 +1790,10 @@ void *MEM_allocatorMalloc(mem_allocator_t *allocator, size_t size, const char *f
  * 
  * @brief   Validates if a pointer is within the allocator's heap.
  *
- * @details Checks whether a given pointer falls within the allocator's heap range, is properly aligned,
- *          has a valid block header, and is marked as allocated.
+ * @details Checks whether a given pointer falls within one of the allocator's heap segments, is properly aligned,
+ *          has a valid block header, and is marked as allocated. The header is not trusted on its own: the
+ *          block must also carry its cookie, written into the following header when it was allocated, so interior,
+ *          stale and foreign pointers are rejected in constant time.
  *
  * @param   [in]  allocator Pointer to the memory allocator structure.
  * @param   [in]  ptr       Pointer to validate.
@@ -301,14 +1802,32 @@ void *MEM_allocatorMalloc(mem_allocator_t *allocator, size_t size, const char *f
  */
 int MEM_validPointerCheck(mem_allocator_t *allocator, void *ptr);
 
+/**
+ * @fn      MEM_allocatorUsableSize
+ * @package MEM_alloc
+ * 
+ * @brief   Returns the number of bytes usable in an allocated block.
+ *
+ * @details The payload of the block, which can be larger than the size originally requested
+ *          because of alignment and of split remainders too small to stand alone.
+ *
+ * @param   [in]  allocator Pointer to the memory allocator structure.
+ * @param   [in]  ptr       Pointer returned by one of the allocator's allocation functions.
+ *
+ * @return  Usable size in bytes, or 0 with errno set to EINVAL for an invalid pointer.
+ */
+size_t MEM_allocatorUsableSize(mem_allocator_t *allocator, void *ptr);
+
 /**
  * @fn      MEM_mergeBlocks
  * @package MEM_alloc
  * 
  * @brief   Merges adjacent free blocks to reduce fragmentation.
  *
- * @details Combines a free block with its neighboring free blocks (if any) to create a larger contiguous free block.
- *          Updates the free list accordingly.
+ * @details Combines a free block with its physical neighbours (if free) to create a larger contiguous free block.
+ *          The next block is found by address arithmetic and the previous one through its boundary tag, so both
+ *          merges are O(1). The resulting block gets its boundary tag and is linked into its segregated free list.
+ *          The block must already be marked free and must not be linked in a free list yet.
  *
  * @param   [in/out] allocator Pointer to the memory allocator structure.
  * @param   [in/out] block     Pointer to the block to be merged.
@@ -351,6 +1870,116 @@ int MEM_allocatorFree(mem_allocator_t *allocator, void *ptr, const char *file, i
  */
 int MEM_allocatorPrintAll(mem_allocator_t *allocator);
 
+/**
+ * @fn      MEM_arenaSetInit
+ * @package MEM_alloc
+ * 
+ * @brief   Splits the static heap into independent arenas.
+ *
+ * @details Creates count thread-safe allocators, each initialized over an equal, aligned
+ *          slice of the heap. The set takes the whole static heap, so it cannot be used
+ *          together with an allocator set up by MEM_allocatorInit.
+ *
+ * @param   [out] set    Pointer to the arena set to initialize.
+ * @param   [in]  count  Number of arenas, between 1 and MEM_ARENAS_MAX.
+ * @param   [in]  policy Thread-to-arena assignment policy.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_arenaSetInit(mem_arena_set_t *set, size_t count, mem_arena_policy_t policy);
+
+/**
+ * @fn      MEM_arenaSetSelect
+ * @package MEM_alloc
+ * 
+ * @brief   Returns the arena the calling thread allocates from.
+ *
+ * @param   [in/out] set Pointer to the arena set.
+ *
+ * @return  Pointer to the arena, or NULL if set is NULL or empty.
+ */
+mem_allocator_t *MEM_arenaSetSelect(mem_arena_set_t *set);
+
+/**
+ * @fn      MEM_arenaSetInitNodes
+ * @package MEM_alloc
+ * 
+ * @brief   Initializes one arena per NUMA node, each on memory bound to its node.
+ *
+ * @details Arena i is mapped with MEM_allocatorInitBacked on node i and grows by chunks of
+ *          arena_size bytes bound to the same node. The set uses MEM_ARENA_BY_NODE, so every
+ *          allocation is served from memory local to the calling thread. Machines with more
+ *          nodes than MEM_ARENAS_MAX fold the extra nodes onto the existing arenas.
+ *
+ * @param   [out] set        Pointer to the arena set to initialize.
+ * @param   [in]  arena_size Initial heap size and growth chunk size of each arena.
+ * @param   [in]  pages      Page size of every mapping.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_arenaSetInitNodes(mem_arena_set_t *set, size_t arena_size, mem_page_mode_t pages);
+
+/**
+ * @fn      MEM_arenaSetDestroy
+ * @package MEM_alloc
+ * 
+ * @brief   Tears every arena of a set down, see MEM_allocatorDestroy.
+ *
+ * @param   [in/out] set Pointer to the arena set.
+ *
+ * @return  0 on success, the first error code met otherwise.
+ */
+int MEM_arenaSetDestroy(mem_arena_set_t *set);
+
+/**
+ * @fn      MEM_arenaSetOwner
+ * @package MEM_alloc
+ * 
+ * @brief   Finds the arena whose heap contains a pointer.
+ *
+ * @details Constant time for pointers into the initial slices of the arenas, bounded by the
+ *          arena and chunk counts for pointers into grown chunks.
+ *
+ * @param   [in] set Pointer to the arena set.
+ * @param   [in] ptr Pointer returned by MEM_arenaSetMalloc.
+ *
+ * @return  Pointer to the owning arena, or NULL when no arena contains ptr.
+ */
+mem_allocator_t *MEM_arenaSetOwner(mem_arena_set_t *set, const void *ptr);
+
+/**
+ * @fn      MEM_arenaSetMalloc
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory from the calling thread's arena.
+ *
+ * @param   [in/out] set       Pointer to the arena set.
+ * @param   [in]     size      Size of memory to allocate.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variable being allocated.
+ * @param   [in]     strategy  Allocation strategy to use.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_arenaSetMalloc(mem_arena_set_t *set, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy);
+
+/**
+ * @fn      MEM_arenaSetFree
+ * @package MEM_alloc
+ * 
+ * @brief   Frees memory into the arena that owns it, whichever thread calls.
+ *
+ * @param   [in/out] set       Pointer to the arena set.
+ * @param   [in]     ptr       Pointer to the memory to free.
+ * @param   [in]     file      Name of the file requesting the free operation.
+ * @param   [in]     line      Line number in the file requesting the free operation.
+ * @param   [in]     var_name  Name of the variable being freed.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_arenaSetFree(mem_arena_set_t *set, void *ptr, const char *file, int line, const char *var_name);
+
 /**
  * @def MEM_ALLOCATOR
  * @package MEM_alloc
@@ -358,7 +1987,9 @@ int MEM_allocatorPrintAll(mem_allocator_t *allocator);
  * @brief Allocates memory using the custom allocator with file and line information.
  *
  * @details This macro simplifies memory allocation by automatically passing the current file name and line number
- *          to the allocator, aiding in debugging.
+ *          to the allocator, aiding in debugging. Without MEM_TRACK_CALLERS it calls
+ *          MEM_allocatorMallocFirstFit and var_name is not evaluated, as for the MEM_ALLOC_*
+ *          macros.
  *
  * @param allocator Pointer to the memory allocator structure.
  * @param size      The size of memory to allocate.
@@ -366,8 +1997,13 @@ int MEM_allocatorPrintAll(mem_allocator_t *allocator);
  *
  * @return Pointer to the allocated memory.
  */
-#define MEM_ALLOCATOR(allocator, size, var_name) \
-    MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, var_name, FIRST_FIT)
+#if MEM_TRACK_CALLERS
+    #define MEM_ALLOCATOR(allocator, size, var_name) \
+        MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, var_name, FIRST_FIT)
+#else
+    #define MEM_ALLOCATOR(allocator, size, var_name) \
+        MEM_allocatorMallocFirstFit(allocator, size)
+#endif
 
 /**
  * @def MEM_ALLOC_FIRST_FIT
@@ -381,8 +2017,13 @@ int MEM_allocatorPrintAll(mem_allocator_t *allocator);
  *
  * @return Pointer to the allocated memory.
  */
-#define MEM_ALLOC_FIRST_FIT(allocator, size, var_name) \
-    MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, var_name, FIRST_FIT)
+#if MEM_TRACK_CALLERS
+    #define MEM_ALLOC_FIRST_FIT(allocator, size, var_name) \
+        MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, var_name, FIRST_FIT)
+#else
+    #define MEM_ALLOC_FIRST_FIT(allocator, size, var_name) \
+        MEM_allocatorMallocFirstFit(allocator, size)
+#endif
 
 /**
  * @def MEM_ALLOC_NEXT_FIT
@@ -396,8 +2037,13 @@ int MEM_allocatorPrintAll(mem_allocator_t *allocator);
  *
  * @return Pointer to the allocated memory.
  */
-#define MEM_ALLOC_NEXT_FIT(allocator, size, var_name) \
-    MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, var_name, NEXT_FIT)
+#if MEM_TRACK_CALLERS
+    #define MEM_ALLOC_NEXT_FIT(allocator, size, var_name) \
+        MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, var_name, NEXT_FIT)
+#else
+    #define MEM_ALLOC_NEXT_FIT(allocator, size, var_name) \
+        MEM_allocatorMallocNextFit(allocator, size)
+#endif
 
 /**
  * @def MEM_ALLOC_BEST_FIT
@@ -411,8 +2057,133 @@ int MEM_allocatorPrintAll(mem_allocator_t *allocator);
  *
  * @return Pointer to the allocated memory.
  */
-#define MEM_ALLOC_BEST_FIT(allocator, size, var_name) \
-    MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, var_name, BEST_FIT)
+#if MEM_TRACK_CALLERS
+    #define MEM_ALLOC_BEST_FIT(allocator, size, var_name) \
+        MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, var_name, BEST_FIT)
+#else
+    #define MEM_ALLOC_BEST_FIT(allocator, size, var_name) \
+        MEM_allocatorMallocBestFit(allocator, size)
+#endif
+
+/**
+ * @def MEM_ALLOC_SEGREGATED_FIT
+ * @package MEM_alloc
+ * 
+ * @brief Allocates memory using the Segregated-Fit strategy.
+ *
+ * @param allocator Pointer to the memory allocator structure.
+ * @param size      The size of memory to allocate.
+ * @param var_name  The name of the variable being allocated.
+ *
+ * @return Pointer to the allocated memory.
+ */
+#if MEM_TRACK_CALLERS
+    #define MEM_ALLOC_SEGREGATED_FIT(allocator, size, var_name) \
+        MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, var_name, SEGREGATED_FIT)
+#else
+    #define MEM_ALLOC_SEGREGATED_FIT(allocator, size, var_name) \
+        MEM_allocatorMallocSegregatedFit(allocator, size)
+#endif
+
+/**
+ * @def MEM_ALLOC_TLSF_FIT
+ * @package MEM_alloc
+ * 
+ * @brief Allocates memory using the TLSF-Fit strategy.
+ *
+ * @param allocator Pointer to the memory allocator structure.
+ * @param size      The size of memory to allocate.
+ * @param var_name  The name of the variable being allocated.
+ *
+ * @return Pointer to the allocated memory.
+ */
+#if MEM_TRACK_CALLERS
+    #define MEM_ALLOC_TLSF_FIT(allocator, size, var_name) \
+        MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, var_name, TLSF_FIT)
+#else
+    #define MEM_ALLOC_TLSF_FIT(allocator, size, var_name) \
+        MEM_allocatorMallocTlsfFit(allocator, size)
+#endif
+
+/**
+ * @def MEM_CALLOC
+ * @package MEM_alloc
+ * 
+ * @brief Allocates zero-initialized memory with file and line information, using the First-Fit strategy.
+ *
+ * @param allocator Pointer to the memory allocator structure.
+ * @param nmemb     Number of elements.
+ * @param size      Size of each element.
+ * @param var_name  The name of the variable being allocated.
+ *
+ * @return Pointer to the allocated memory.
+ */
+#define MEM_CALLOC(allocator, nmemb, size, var_name) \
+    MEM_allocatorCalloc(allocator, nmemb, size, __FILE__, __LINE__, var_name, FIRST_FIT)
+
+/**
+ * @def MEM_MEMALIGN
+ * @package MEM_alloc
+ * 
+ * @brief Allocates aligned memory with file and line information, using the First-Fit strategy.
+ *
+ * @param allocator Pointer to the memory allocator structure.
+ * @param alignment Required alignment, a power of two.
+ * @param size      The size of memory to allocate.
+ * @param var_name  The name of the variable being allocated.
+ *
+ * @return Pointer to the allocated memory.
+ */
+#define MEM_MEMALIGN(allocator, alignment, size, var_name) \
+    MEM_allocatorMemalign(allocator, alignment, size, __FILE__, __LINE__, var_name, FIRST_FIT)
+
+/**
+ * @def MEM_MALLOC_SHARED
+ * @package MEM_alloc
+ * 
+ * @brief Allocates cache-line isolated memory with file and line information, using the First-Fit strategy.
+ *
+ * @param allocator Pointer to the memory allocator structure.
+ * @param size      The size of memory to allocate.
+ * @param var_name  The name of the variable being allocated.
+ *
+ * @return Pointer to the allocated memory.
+ */
+#define MEM_MALLOC_SHARED(allocator, size, var_name) \
+    MEM_allocatorMallocShared(allocator, size, __FILE__, __LINE__, var_name, FIRST_FIT)
+
+/**
+ * @def MEM_REALLOC
+ * @package MEM_alloc
+ * 
+ * @brief Resizes memory with file and line information, using the First-Fit strategy when it moves.
+ *
+ * @param allocator Pointer to the memory allocator structure.
+ * @param ptr       Pointer to the memory to resize, or NULL.
+ * @param size      The new size in bytes.
+ * @param var_name  The name of the variable being reallocated.
+ *
+ * @return Pointer to the resized memory.
+ */
+#define MEM_REALLOC(allocator, ptr, size, var_name) \
+    MEM_allocatorRealloc(allocator, ptr, size, __FILE__, __LINE__, var_name, FIRST_FIT)
+
+/**
+ * @def MEM_MALLOC_BATCH
+ * @package MEM_alloc
+ * 
+ * @brief Allocates a batch of same-sized blocks with file and line information, using the First-Fit strategy.
+ *
+ * @param allocator Pointer to the memory allocator structure.
+ * @param size      The size of each block.
+ * @param count     Number of blocks to allocate.
+ * @param out_ptrs  Array receiving the allocated pointers.
+ * @param var_name  The name of the variables being allocated.
+ *
+ * @return Number of blocks allocated.
+ */
+#define MEM_MALLOC_BATCH(allocator, size, count, out_ptrs, var_name) \
+    MEM_allocatorMallocBatch(allocator, size, count, out_ptrs, __FILE__, __LINE__, var_name, FIRST_FIT)
 
 /**
  * @def MEM_FREE
@@ -432,6 +2203,53 @@ int MEM_allocatorPrintAll(mem_allocator_t *allocator);
 #define MEM_FREE(allocator, ptr, var_name) \
     MEM_allocatorFree(allocator, ptr, __FILE__, __LINE__, var_name)
 
+/**
+ * @def MEM_FREE_BATCH
+ * @package MEM_alloc
+ * 
+ * @brief Frees a batch of blocks with file and line information.
+ *
+ * @param allocator Pointer to the memory allocator structure.
+ * @param ptrs      Array of pointers to free, reordered by the call.
+ * @param count     Number of pointers.
+ * @param var_name  The name of the variables being freed.
+ *
+ * @return 0 on success, error code on failure.
+ */
+#define MEM_FREE_BATCH(allocator, ptrs, count, var_name) \
+    MEM_allocatorFreeBatch(allocator, ptrs, count, __FILE__, __LINE__, var_name)
+
+/**
+ * @def MEM_LOG
+ * @package MEM_alloc
+ * 
+ * @brief Logs a message at a level, compiled out when the level is above MEM_LOG_LEVEL.
+ *
+ * @details The arguments stay type-checked but are never evaluated for disabled levels.
+ *
+ * @param level Level of the message.
+ * @param ...   Format string and arguments.
+ */
+#define MEM_LOG(level, ...)                             \
+    do                                                  \
+    {                                                   \
+        if ((level) <= MEM_LOG_LEVEL)                   \
+        {                                               \
+            MEM_logWrite((level), __VA_ARGS__);         \
+        }                                               \
+    } while (0)
+
+/**
+ * @def MEM_LOG_ERROR
+ * @package MEM_alloc
+ *
+ * @brief Per-level shorthands of MEM_LOG.
+ */
+#define MEM_LOG_ERROR(...)  MEM_LOG(MEM_LOG_LEVEL_ERROR, __VA_ARGS__)
+#define MEM_LOG_WARN(...)   MEM_LOG(MEM_LOG_LEVEL_WARN, __VA_ARGS__)
+#define MEM_LOG_INFO(...)   MEM_LOG(MEM_LOG_LEVEL_INFO, __VA_ARGS__)
+#define MEM_LOG_DEBUG(...)  MEM_LOG(MEM_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
 /* end of header*/
 #endif /* MEM_ALLOCATOR_H_ */
 /**@}*/
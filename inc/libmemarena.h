@@ -0,0 +1,147 @@
+ /**
+ *  @addtogroup MemoryManagement
+ *  @{
+ *  @addtogroup MemoryManagement MEM_arena
+ *  @{
+ *
+ *  @package    MEM_arena
+ *  @brief      Scoped bump-pointer arena for short-lived objects, built on top of MEM_alloc.
+ *
+ *  @file       libmemarena.h
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              A scoped arena serves the temporaries of one unit of work, such as a request
+ *              handler, from a single block of a mem_allocator_t. Allocation moves a pointer
+ *              forward, objects carry no header and are never freed one by one. Checkpoints
+ *              taken with MEM_arenaMark can be rolled back with MEM_arenaRewind, and
+ *              MEM_arenaReset hands the whole block back to the allocator with one free.
+ *
+ *  @note
+ *              - An arena belongs to one thread at a time; only the allocator calls that take and
+ *                return its block are serialized by the allocator.
+ *              - Not to be confused with mem_arena_set_t, which splits the heap into independent
+ *                allocators.
+ *
+ *  @see        - MEM_arenaInit
+ *              - MEM_arenaAlloc
+ *              - MEM_arenaReset
+ **/
+
+/* Header Include Protection */
+#ifndef MEM_ARENA_H_
+#define MEM_ARENA_H_
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <libmemalloc.h>
+
+/* =================================
+ *      PUBLIC DATA STRUCTURES     *
+ * ================================*/
+
+/**
+ * @struct  mem_scope_arena
+ * @package MEM_arena
+ *
+ * @typedef mem_scope_arena_t
+ *
+ * @brief   State of a scoped arena.
+ */
+typedef struct mem_scope_arena
+{
+    mem_allocator_t *allocator;                         /**< Allocator the block comes from and returns to */
+
+    uint8_t *base;                                      /**< Block serving the arena, NULL until the first allocation */
+    size_t capacity;                                    /**< Usable bytes of the block */
+    size_t offset;                                      /**< Bytes handed out since the block was taken */
+    size_t peak;                                        /**< Highest offset reached, kept across resets */
+} mem_scope_arena_t;
+
+/* =================================
+ *   PUBLIC  FUNCTION PROTOTYPES   *
+ * ================================*/
+
+/**
+ * @fn      MEM_arenaInit
+ * @package MEM_arena
+ *
+ * @brief   Prepares a scoped arena of capacity bytes over an allocator.
+ *
+ * @details No memory is taken yet: the block is allocated by the first MEM_arenaAlloc after
+ *          the init or after each reset, so an idle arena holds nothing.
+ *
+ * @param   [out]    arena     Pointer to the arena to initialize.
+ * @param   [in/out] allocator Initialized allocator backing the arena.
+ * @param   [in]     capacity  Bytes the arena can hand out before it is reset.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_arenaInit(mem_scope_arena_t *arena, mem_allocator_t *allocator, size_t capacity);
+
+/**
+ * @fn      MEM_arenaAlloc
+ * @package MEM_arena
+ *
+ * @brief   Allocates size bytes from the arena.
+ *
+ * @details The result is aligned to ARCH_ALIGNMENT. It stays valid until a rewind to an
+ *          earlier mark or a reset, and is never freed on its own.
+ *
+ * @param   [in/out] arena Pointer to the arena.
+ * @param   [in]     size  Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory, or NULL with errno set to ENOMEM when the arena is
+ *          full, or EINVAL for invalid arguments.
+ */
+void *MEM_arenaAlloc(mem_scope_arena_t *arena, size_t size);
+
+/**
+ * @fn      MEM_arenaMark
+ * @package MEM_arena
+ *
+ * @brief   Takes a checkpoint of the arena.
+ *
+ * @param   [in] arena Pointer to the arena.
+ *
+ * @return  Mark to pass to MEM_arenaRewind.
+ */
+size_t MEM_arenaMark(const mem_scope_arena_t *arena);
+
+/**
+ * @fn      MEM_arenaRewind
+ * @package MEM_arena
+ *
+ * @brief   Releases everything allocated since a checkpoint.
+ *
+ * @param   [in/out] arena Pointer to the arena.
+ * @param   [in]     mark  Mark returned by MEM_arenaMark since the last reset.
+ *
+ * @return  0 on success, EINVAL when the mark lies past the current position.
+ */
+int MEM_arenaRewind(mem_scope_arena_t *arena, size_t mark);
+
+/**
+ * @fn      MEM_arenaReset
+ * @package MEM_arena
+ *
+ * @brief   Releases every object of the arena and returns its block to the allocator.
+ *
+ * @details One MEM_allocatorFree, whatever the number of objects. The arena stays usable and
+ *          takes a new block on its next allocation.
+ *
+ * @param   [in/out] arena Pointer to the arena.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_arenaReset(mem_scope_arena_t *arena);
+
+/* end of header*/
+#endif /* MEM_ARENA_H_ */
+/**@}*/
+/**@}*/
@@ -0,0 +1,207 @@
+ /**
+ *  @addtogroup MemoryManagement
+ *  @{
+ *  @addtogroup MemoryManagement MEM_slab
+ *  @{
+ *
+ *  @package    MEM_slab
+ *  @brief      Fixed-size slab sub-allocator for small objects, built on top of MEM_alloc.
+ *
+ *  @file       libmemslab.h
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              A slab cache takes one contiguous region from a mem_allocator_t and carves it into
+ *              pages of MEM_SLAB_PAGE_SIZE bytes. Each page serves a single power-of-two size class
+ *              and tracks its slots with a bitmap, so objects carry no header, allocation and free
+ *              are O(1), and same-size objects are packed densely. Requests larger than
+ *              MEM_SLAB_MAX_SIZE, or made while every page is taken, fall through to the
+ *              underlying allocator.
+ *
+ *  @note
+ *              - The cache is thread-safe when its allocator is in thread-safe mode.
+ *
+ *  @see        - MEM_slabInit
+ *              - MEM_slabMalloc
+ *              - MEM_slabFree
+ **/
+
+/* Header Include Protection */
+#ifndef MEM_SLAB_H_
+#define MEM_SLAB_H_
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <libmemalloc.h>
+
+/* =================================
+ *          PUBLIC DEFINES         *
+ * ================================*/
+
+/**
+ * @def MEM_SLAB_PAGE_SIZE
+ * @package MEM_slab
+ *
+ * @brief Size in bytes of a slab page, a power of two.
+ */
+#ifndef MEM_SLAB_PAGE_SIZE
+    #define MEM_SLAB_PAGE_SIZE (4096U)
+#endif
+
+/**
+ * @def MEM_SLAB_MIN_SHIFT
+ * @package MEM_slab
+ *
+ * @brief Log2 of the smallest slab class (16 bytes).
+ */
+#define MEM_SLAB_MIN_SHIFT (4U)
+
+/**
+ * @def MEM_SLAB_NUM_CLASSES
+ * @package MEM_slab
+ *
+ * @brief Number of power-of-two slab classes (16, 32, 64 and 128 bytes by default).
+ */
+#ifndef MEM_SLAB_NUM_CLASSES
+    #define MEM_SLAB_NUM_CLASSES (4U)
+#endif
+
+/**
+ * @def MEM_SLAB_MAX_SIZE
+ * @package MEM_slab
+ *
+ * @brief Largest request served by the slab pages.
+ */
+#define MEM_SLAB_MAX_SIZE ((size_t)1U << (MEM_SLAB_MIN_SHIFT + MEM_SLAB_NUM_CLASSES - 1U))
+
+/* =================================
+ *      PUBLIC DATA STRUCTURES     *
+ * ================================*/
+
+/**
+ * @struct  mem_slab_cache
+ * @package MEM_slab
+ *
+ * @typedef mem_slab_cache_t
+ *
+ * @brief   State of a slab cache.
+ */
+typedef struct mem_slab_cache
+{
+    mem_allocator_t *allocator;                         /**< Allocator the region and all fall-through requests come from */
+
+    uint8_t *region;                                    /**< First page, aligned to MEM_SLAB_PAGE_SIZE */
+    size_t page_count;                                  /**< Number of pages in the region */
+
+    struct mem_slab_page *pages;                        /**< One descriptor per page */
+    struct mem_slab_page *free_pages;                   /**< Pages not assigned to any class */
+    struct mem_slab_page *partial[MEM_SLAB_NUM_CLASSES]; /**< Pages of each class with at least one free slot */
+
+    pthread_mutex_t lock;                               /**< Serializes the cache when the allocator is thread-safe */
+} mem_slab_cache_t;
+
+/* =================================
+ *   PUBLIC  FUNCTION PROTOTYPES   *
+ * ================================*/
+
+/**
+ * @fn      MEM_slabInit
+ * @package MEM_slab
+ *
+ * @brief   Creates a slab cache over page_count pages taken from an allocator.
+ *
+ * @param   [out]    cache      Pointer to the slab cache to initialize.
+ * @param   [in/out] allocator  Initialized allocator backing the cache.
+ * @param   [in]     page_count Number of MEM_SLAB_PAGE_SIZE pages to reserve.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_slabInit(mem_slab_cache_t *cache, mem_allocator_t *allocator, size_t page_count);
+
+/**
+ * @fn      MEM_slabDestroy
+ * @package MEM_slab
+ *
+ * @brief   Returns the pages of a slab cache to its allocator.
+ *
+ * @details Every object served from the pages becomes invalid. Objects that fell through to
+ *          the allocator stay valid.
+ *
+ * @param   [in/out] cache Pointer to the slab cache.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_slabDestroy(mem_slab_cache_t *cache);
+
+/**
+ * @fn      MEM_slabMalloc
+ * @package MEM_slab
+ *
+ * @brief   Allocates memory from the slab class fitting size, or from the allocator.
+ *
+ * @param   [in/out] cache    Pointer to the slab cache.
+ * @param   [in]     size     Size of memory to allocate.
+ * @param   [in]     file     Name of the file requesting the allocation.
+ * @param   [in]     line     Line number in the file requesting the allocation.
+ * @param   [in]     var_name Name of the variable being allocated.
+ * @param   [in]     strategy Strategy used when the request falls through to the allocator.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_slabMalloc(mem_slab_cache_t *cache, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy);
+
+/**
+ * @fn      MEM_slabFree
+ * @package MEM_slab
+ *
+ * @brief   Frees memory returned by MEM_slabMalloc.
+ *
+ * @param   [in/out] cache    Pointer to the slab cache.
+ * @param   [in]     ptr      Pointer to the memory to free.
+ * @param   [in]     file     Name of the file requesting the free operation.
+ * @param   [in]     line     Line number in the file requesting the free operation.
+ * @param   [in]     var_name Name of the variable being freed.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_slabFree(mem_slab_cache_t *cache, void *ptr, const char *file, int line, const char *var_name);
+
+/**
+ * @def MEM_SLAB_ALLOC
+ * @package MEM_slab
+ *
+ * @brief Allocates memory from a slab cache with file and line information.
+ *
+ * @param cache    Pointer to the slab cache.
+ * @param size     The size of memory to allocate.
+ * @param var_name The name of the variable being allocated.
+ *
+ * @return Pointer to the allocated memory.
+ */
+#define MEM_SLAB_ALLOC(cache, size, var_name) \
+    MEM_slabMalloc(cache, size, __FILE__, __LINE__, var_name, TLSF_FIT)
+
+/**
+ * @def MEM_SLAB_FREE
+ * @package MEM_slab
+ *
+ * @brief Frees slab cache memory with file and line information.
+ *
+ * @param cache    Pointer to the slab cache.
+ * @param ptr      Pointer to the memory to free.
+ * @param var_name The name of the variable being freed.
+ *
+ * @return 0 on success, error code on failure.
+ */
+#define MEM_SLAB_FREE(cache, ptr, var_name) \
+    MEM_slabFree(cache, ptr, __FILE__, __LINE__, var_name)
+
+/* end of header*/
+#endif /* MEM_SLAB_H_ */
+/**@}*/
+/**@}*/
@@ -23,8 +23,8 @@
  *
  *  @note       
  *              - Ensure that the allocator is initialized before performing any allocation or deallocation.
- *              - The module is designed for single-threaded environments. For multi-threaded applications,
- *                synchronization mechanisms should be implemented to ensure thread safety.
+ *              - Allocators are single-threaded by default. MEM_allocatorSetThreadSafe enables a mode with
+ *                per-thread caches in front of a mutex-protected shared heap.
  *
  *  @see        - libmemalloc.h
  *              - MEM_allocatorInit
@@ -36,99 +36,6737 @@
  *       PRIVATE INCLUDE FILES     *
  * ================================*/
 
+/* sched_getcpu: */
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
 /* dependencies: */
+#include <sched.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <string.h>
 #include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/auxv.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+/* implements: */
+#include <libmemalloc.h>
+
+/* =================================
+ *     PRIVATE DATA STRUCTURES     *
+ * ================================*/
+
+#if defined(_DEBUG_)
+/**
+ * @struct  debug_entry
+ * @package MEM_alloc
+ * 
+ * @typedef debug_entry_t
+ * 
+ * @brief   Allocation source information of one live block (debug builds only).
+ */
+typedef struct debug_entry
+{
+    const block_header_t *block;                        /**< Block the entry describes, NULL for an empty slot */
+
+    const char *file;                                   /**< Source file requesting the allocation */
+    int line;                                           /**< Line number in the source file */
+
+    const char *var_name;                               /**< Name of the variable associated with the allocation */
+
+    size_t size;                                        /**< Bytes requested by the caller */
+} debug_entry_t;
+#endif
+
+/**
+ * @struct  profile_block
+ * @package MEM_alloc
+ * 
+ * @typedef profile_block_t
+ * 
+ * @brief   One block sampled by the allocation-site profiler.
+ */
+typedef struct profile_block
+{
+    const block_header_t *block;                        /**< Sampled block, NULL for an empty slot */
+    size_t size;                                        /**< Bytes requested by the caller */
+    uint32_t site;                                      /**< Index of the allocation site in profile_sites */
+} profile_block_t;
+
+/**
+ * @struct  mem_tcache
+ * @package MEM_alloc
+ * 
+ * @typedef mem_tcache_t
+ * 
+ * @brief   Per-thread cache of recently freed small blocks.
+ *
+ * @details Bin i holds blocks whose payload is exactly (i + 1) * ARCH_ALIGNMENT bytes, singly
+ *          linked through MEM_FREE_LINKS()->next_free. Cached blocks stay marked allocated in
+ *          the heap, so no other thread ever touches them, and prev_free carries the address
+ *          of the owning cache as a double-free marker.
+ */
+typedef struct mem_tcache
+{
+    mem_allocator_t *owner;                             /**< Allocator the cached blocks belong to, NULL while unbound */
+
+    block_header_t *bins[MEM_TCACHE_BINS];              /**< Heads of the per-size bins */
+    uint32_t counts[MEM_TCACHE_BINS];                   /**< Number of blocks held by each bin */
+
+    mem_tcache_stats_t stats;                           /**< Counters not yet merged into the owner */
+} mem_tcache_t;
+
+/**
+ * @struct  free_node
+ * @package MEM_alloc
+ * 
+ * @typedef free_node_t
+ * 
+ * @brief   Links of a free block in the size tree, following its free-list links.
+ *
+ * @details Only blocks of at least MEM_SIZE_TREE_MIN bytes are in the tree, so the node always
+ *          fits in their payload. The tree is a treap ordered by (size, address) whose heap
+ *          priorities are a hash of the block address, which keeps it balanced in expectation
+ *          without storing anything else.
+ */
+typedef struct free_node
+{
+    free_links_t links;                                 /**< Segregated free-list links, always first */
+
+    struct block_header *left;                          /**< Subtree of smaller (size, address) keys */
+    struct block_header *right;                         /**< Subtree of larger (size, address) keys */
+    struct block_header *parent;                        /**< Parent node, NULL at the root */
+} free_node_t;
+
+/**
+ * @struct  mem_arena_affinity
+ * @package MEM_alloc
+ * 
+ * @typedef mem_arena_affinity_t
+ * 
+ * @brief   Round-robin arena assigned to a thread.
+ */
+typedef struct mem_arena_affinity
+{
+    const mem_arena_set_t *set;                         /**< Arena set the assignment belongs to */
+    size_t index;                                       /**< Index of the assigned arena in the set */
+} mem_arena_affinity_t;
+
+/**
+ * @struct  record_buffer
+ * @package MEM_alloc
+ * 
+ * @typedef record_buffer_t
+ * 
+ * @brief   Allocation records of one thread waiting to be written out.
+ *
+ * @details Buffers are mapped once, linked into record_buffers for good and handed to a new
+ *          thread when their owner exits, so MEM_recordStop can walk them at any time.
+ */
+typedef struct record_buffer
+{
+    struct record_buffer *next;                         /**< Next registered buffer */
+    uint32_t owned;                                     /**< 1 while a thread records into the buffer */
+    uint32_t busy;                                      /**< 1 while its owner or MEM_recordStop uses the records */
+    uint64_t generation;                                /**< Recording the records belong to */
+    size_t count;                                       /**< Records held */
+    mem_record_t records[MEM_RECORD_BUFFER];            /**< Records, oldest first */
+} record_buffer_t;
+
+/* =================================
+ *     PRIVATE GLOBAL VARIABLE     *
+ * ================================*/
+
+/**
+ * @var     heap_memory
+ * @package MEM_alloc
+ * 
+ * @brief   Heap memory aligned and placed in a specific memory section.
+ *
+ * @details Ensures that the heap is properly aligned based on the architecture for optimal memory access and performance.
+ */
+static uint8_t heap_memory[HEAP_SIZE] __attribute__((section(".heap"), aligned(ARCH_ALIGNMENT)));
+
+/**
+ * @var     cookie_seed
+ * @package MEM_alloc
+ * 
+ * @brief   Process-wide random value the block cookie key of every allocator derives from.
+ *
+ * @details Drawn once from the kernel-supplied AT_RANDOM bytes, see MEM_cookieSeed.
+ */
+static uintptr_t cookie_seed;
+
+_Static_assert((HEAP_SIZE % ARCH_ALIGNMENT) == 0, "HEAP_SIZE must be a multiple of ARCH_ALIGNMENT");
+_Static_assert((sizeof(block_header_t) % ARCH_ALIGNMENT) == 0, "block_header_t must keep payloads aligned");
+_Static_assert(sizeof(block_header_t) == ARCH_ALIGNMENT && (MEM_CACHE_LINE_SIZE % ARCH_ALIGNMENT) == 0, "block headers must never straddle a cache line");
+_Static_assert(MEM_SIZE_TREE_MIN >= sizeof(block_header_t) + sizeof(free_node_t), "MEM_SIZE_TREE_MIN blocks must hold a size tree node");
+
+#if defined(_DEBUG_)
+_Static_assert((MEM_DEBUG_TABLE_SIZE & (MEM_DEBUG_TABLE_SIZE - 1u)) == 0, "MEM_DEBUG_TABLE_SIZE must be a power of two");
+
+/**
+ * @var     debug_table
+ * @package MEM_alloc
+ * 
+ * @brief   Side table holding the allocation source of live blocks (debug builds only).
+ *
+ * @details Keyed by block address, so a single table serves every allocator of the process
+ *          and keeps the allocation source out of the block headers.
+ */
+static debug_entry_t debug_table[MEM_DEBUG_TABLE_SIZE];
+
+/**
+ * @var     debug_lock
+ * @package MEM_alloc
+ * 
+ * @brief   Serializes the side table, which is shared by every allocator and thread.
+ */
+static pthread_mutex_t debug_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+_Static_assert((MEM_PROFILE_SITES & (MEM_PROFILE_SITES - 1u)) == 0, "MEM_PROFILE_SITES must be a power of two");
+_Static_assert((MEM_PROFILE_BLOCKS & (MEM_PROFILE_BLOCKS - 1u)) == 0, "MEM_PROFILE_BLOCKS must be a power of two");
+
+/**
+ * @var     profile_sites
+ * @package MEM_alloc
+ * 
+ * @brief   Open-addressing table of the allocation sites seen by the profiler.
+ *
+ * @details Entries are only added, so a site keeps its slot until MEM_profileReset.
+ */
+static mem_profile_site_t profile_sites[MEM_PROFILE_SITES];
+
+/**
+ * @var     profile_blocks
+ * @package MEM_alloc
+ * 
+ * @brief   Open-addressing table of the sampled blocks, keyed by block address.
+ *
+ * @details Entries change under profile_lock, but the block field is also read without it: an
+ *          empty home slot proves a block was not sampled, which keeps unsampled frees, the
+ *          lock-free thread-cache path included, off the lock.
+ */
+static profile_block_t profile_blocks[MEM_PROFILE_BLOCKS];
+
+/**
+ * @var     profile_lock
+ * @package MEM_alloc
+ * 
+ * @brief   Serializes both profiler tables, which are shared by every allocator and thread.
+ */
+static pthread_mutex_t profile_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @var     profile_live
+ * @package MEM_alloc
+ * 
+ * @brief   Number of entries in profile_blocks, read without the lock to skip an empty table.
+ */
+static size_t profile_live;
+
+/**
+ * @var     profile_rate
+ * @package MEM_alloc
+ * 
+ * @brief   Sample rate set by MEM_profileSetRate, 0 while the profiler is stopped.
+ */
+static uint32_t profile_rate;
+
+/**
+ * @var     profile_countdown
+ * @package MEM_alloc
+ * 
+ * @brief   Allocations left before the calling thread takes its next sample.
+ */
+static _Thread_local uint32_t profile_countdown;
+
+/**
+ * @var     tcache
+ * @package MEM_alloc
+ * 
+ * @brief   Block cache of the calling thread.
+ */
+static _Thread_local mem_tcache_t tcache;
+
+/**
+ * @var     tcache_key
+ * @package MEM_alloc
+ * 
+ * @brief   Thread-specific key whose destructor flushes a thread's cache at exit.
+ */
+static pthread_key_t tcache_key;
+
+/**
+ * @var     tcache_key_once
+ * @package MEM_alloc
+ * 
+ * @brief   Guards the creation of tcache_key.
+ */
+static pthread_once_t tcache_key_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @var     arena_affinity
+ * @package MEM_alloc
+ * 
+ * @brief   Round-robin arena of the calling thread.
+ */
+static _Thread_local mem_arena_affinity_t arena_affinity;
+
+/**
+ * @var     log_hook
+ * @package MEM_alloc
+ * 
+ * @brief   Sink of the messages compiled in under MEM_LOG_LEVEL, and its context.
+ */
+static mem_log_hook_t log_hook = MEM_logStdio;
+static void *log_context;
+
+#if MEM_TRACE_ENABLED
+_Static_assert((MEM_TRACE_RING_SIZE & (MEM_TRACE_RING_SIZE - 1u)) == 0, "MEM_TRACE_RING_SIZE must be a power of two");
+
+/**
+ * @var     trace_ring
+ * @package MEM_alloc
+ * 
+ * @brief   Binary trace ring and the number of events ever written to it.
+ *
+ * @details Writers claim a slot with one atomic increment and store the fields with plain
+ *          atomic stores, the sequence last, so recording never locks or formats text. Readers
+ *          drop a slot whose sequence changed while they copied it.
+ */
+static mem_trace_event_t trace_ring[MEM_TRACE_RING_SIZE];
+static uint64_t trace_head;
+#endif
+
+_Static_assert((MEM_RECORD_FILES & (MEM_RECORD_FILES - 1u)) == 0, "MEM_RECORD_FILES must be a power of two");
+_Static_assert(MEM_RECORD_FILES <= MEM_RECORD_NO_FILE, "MEM_RECORD_FILES must fit a record file index");
+
+/**
+ * @var     record_fd
+ * @package MEM_alloc
+ * 
+ * @brief   File of the running allocation recording, -1 when none runs.
+ */
+static int record_fd = -1;
+
+/**
+ * @var     record_generation
+ * @package MEM_alloc
+ * 
+ * @brief   Number of recordings started, so that buffers left from a stopped one are dropped.
+ */
+static uint64_t record_generation;
+
+/**
+ * @var     record_epoch
+ * @package MEM_alloc
+ * 
+ * @brief   Monotonic time the running recording started at, in nanoseconds.
+ */
+static uint64_t record_epoch;
+
+/**
+ * @var     record_files
+ * @package MEM_alloc
+ * 
+ * @brief   Source files named by the records, indexed by mem_record_t.file.
+ *
+ * @details Slots are claimed with a compare-and-swap on the address of the file name and are
+ *          never released, so an index stays valid across recordings.
+ */
+static const char *record_files[MEM_RECORD_FILES];
+
+/**
+ * @var     record_buffers
+ * @package MEM_alloc
+ * 
+ * @brief   Every record buffer ever mapped, newest first; buffers are never unlinked.
+ */
+static record_buffer_t *record_buffers;
+
+/**
+ * @var     record_buffer
+ * @package MEM_alloc
+ * 
+ * @brief   Record buffer owned by the calling thread, NULL until its first record.
+ */
+static _Thread_local record_buffer_t *record_buffer;
+
+/**
+ * @var     record_key
+ * @package MEM_alloc
+ * 
+ * @brief   Thread-specific data key whose destructor flushes a thread's records at exit.
+ */
+static pthread_key_t record_key;
+
+/**
+ * @var     record_key_once
+ * @package MEM_alloc
+ * 
+ * @brief   Guards the creation of record_key.
+ */
+static pthread_once_t record_key_once = PTHREAD_ONCE_INIT;
+
+/* =================================
+ *   PRIVATE FUNCTION DECLARATION  *
+ * ================================*/
+
+/**
+ * @fn      MEM_logStdio
+ * @package MEM_alloc
+ * 
+ * @brief   Default log hook, writing to stderr or stdout depending on the level.
+ *
+ * @param   [in] level   Level of the message.
+ * @param   [in] format  Format string.
+ * @param   [in] args    Arguments corresponding to the format string.
+ * @param   [in] context Unused.
+ */
+void MEM_logStdio(int level, const char *format, va_list args, void *context)
+{
+    /* Start Function Logic */
+    (void)context;
+
+    vfprintf((level <= MEM_LOG_LEVEL_WARN) ? stderr : stdout, format, args);
+}
+
+/**
+ * @fn      MEM_logSetHook
+ * @package MEM_alloc
+ * 
+ * @brief   Replaces the log hook.
+ *
+ * @param   [in] hook    New log hook, or NULL to discard messages.
+ * @param   [in] context Opaque pointer passed to the hook.
+ */
+void MEM_logSetHook(mem_log_hook_t hook, void *context)
+{
+    /* Start Function Logic */
+    __atomic_store_n(&log_context, context, __ATOMIC_RELAXED);
+    __atomic_store_n(&log_hook, hook, __ATOMIC_RELEASE);
+}
+
+/**
+ * @fn      MEM_logVWrite
+ * @package MEM_alloc
+ * 
+ * @brief   Sends a formatted message to the log hook.
+ *
+ * @param   [in] level  Level of the message.
+ * @param   [in] format Format string.
+ * @param   [in] args   Arguments corresponding to the format string.
+ */
+static void MEM_logVWrite(int level, const char *format, va_list args)
+{
+    /* Definition of Function Variables */
+    mem_log_hook_t hook = NULL;
+
+    /* Assigning Initial Values for Variables */
+    hook = __atomic_load_n(&log_hook, __ATOMIC_ACQUIRE);
+
+    /* Start Function Logic */
+    if (hook)
+    {
+        hook(level, format, args, __atomic_load_n(&log_context, __ATOMIC_RELAXED));
+    }
+}
+
+/**
+ * @fn      MEM_logWrite
+ * @package MEM_alloc
+ * 
+ * @brief   Sends a message to the log hook.
+ *
+ * @param   [in] level  Level of the message.
+ * @param   [in] format Format string.
+ * @param   [in] ...    Variable arguments corresponding to the format string.
+ */
+void MEM_logWrite(int level, const char *format, ...)
+{
+    /* Definition of Function Variables */
+    va_list args;
+
+    /* Start Function Logic */
+    va_start(args, format);
+    MEM_logVWrite(level, format, args);
+    va_end(args);
+}
+
+/**
+ * @fn      MEM_printd
+ * @package MEM_alloc
+ * 
+ * @brief   Prints debug messages.
+ *
+ * @details Sends the message to the log hook at MEM_LOG_LEVEL_DEBUG.
+ *
+ * @param   [in] format Format string.
+ * @param   [in] ...    Variable arguments corresponding to the format string.
+ */
+void MEM_printd(const char *format, ...) 
+{
+    /* Definition of Function Variables */
+    va_list args;
+
+    /* Start Function Logic */
+    va_start(args, format);
+    MEM_logVWrite(MEM_LOG_LEVEL_DEBUG, format, args);
+    va_end(args);
+}
+
+/**
+ * @fn      MEM_traceRecord
+ * @package MEM_alloc
+ * 
+ * @brief   Appends an event to the trace ring.
+ *
+ * @details Compiles to nothing without MEM_TRACE_ENABLED.
+ *
+ * @param   [in] op    Operation, a mem_trace_op_t.
+ * @param   [in] block Block header the operation applied to.
+ * @param   [in] size  Block size after the operation.
+ * @param   [in] aux   Operation-specific detail.
+ */
+static inline void MEM_traceRecord(mem_trace_op_t op, const void *block, size_t size, uint32_t aux)
+{
+#if MEM_TRACE_ENABLED
+    /* Definition of Function Variables */
+    uint64_t sequence           = 0u;
+    mem_trace_event_t *event    = NULL;
+
+    /* Assigning Initial Values for Variables */
+    sequence    = __atomic_add_fetch(&trace_head, 1u, __ATOMIC_RELAXED);
+    event       = &trace_ring[(sequence - 1u) & (MEM_TRACE_RING_SIZE - 1u)];
+
+    /* Start Function Logic */
+    __atomic_store_n(&event->sequence, (uint64_t)0u, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->ptr, (void *)block, __ATOMIC_RELEASE);
+    __atomic_store_n(&event->size, size, __ATOMIC_RELEASE);
+    __atomic_store_n(&event->op, (uint32_t)op, __ATOMIC_RELEASE);
+    __atomic_store_n(&event->aux, aux, __ATOMIC_RELEASE);
+    __atomic_store_n(&event->sequence, sequence, __ATOMIC_RELEASE);
+#else
+    (void)op;
+    (void)block;
+    (void)size;
+    (void)aux;
+#endif
+}
+
+/**
+ * @fn      MEM_traceSnapshot
+ * @package MEM_alloc
+ * 
+ * @brief   Copies the most recent events of the trace ring, oldest first.
+ *
+ * @param   [out] events     Destination array.
+ * @param   [in]  max_events Capacity of the destination array.
+ *
+ * @return  Number of events copied.
+ */
+size_t MEM_traceSnapshot(mem_trace_event_t *events, size_t max_events)
+{
+    /* Definition of Function Variables */
+    size_t count        = 0u;
+
+#if MEM_TRACE_ENABLED
+    uint64_t head       = 0u;
+    uint64_t sequence   = 0u;
+    uint64_t first      = 0u;
+    mem_trace_event_t *event = NULL;
+
+    /* Check deference/argument boundaries */
+    if (events == NULL || max_events == 0u)
+    {
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    head    = __atomic_load_n(&trace_head, __ATOMIC_ACQUIRE);
+    first   = head - ((head < MEM_TRACE_RING_SIZE) ? head : MEM_TRACE_RING_SIZE);
+
+    if (head - first > max_events)
+    {
+        first = head - max_events;
+    }
+
+    /* Start Function Logic */
+    for (sequence = first + 1u; sequence <= head; ++sequence)
+    {
+        event = &trace_ring[(sequence - 1u) & (MEM_TRACE_RING_SIZE - 1u)];
+
+        if (__atomic_load_n(&event->sequence, __ATOMIC_ACQUIRE) != sequence)
+        {
+            continue;
+        }
+
+        events[count].sequence  = sequence;
+        events[count].ptr       = __atomic_load_n(&event->ptr, __ATOMIC_ACQUIRE);
+        events[count].size      = __atomic_load_n(&event->size, __ATOMIC_ACQUIRE);
+        events[count].op        = __atomic_load_n(&event->op, __ATOMIC_ACQUIRE);
+        events[count].aux       = __atomic_load_n(&event->aux, __ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&event->sequence, __ATOMIC_RELAXED) == sequence)
+        {
+            ++count;
+        }
+    }
+
+    /* Function Return */
+end_of_function:
+#else
+    (void)events;
+    (void)max_events;
+#endif
+    return count;
+}
+
+/**
+ * @fn      MEM_recordNow
+ * @package MEM_alloc
+ * 
+ * @brief   Reads the monotonic clock.
+ *
+ * @return  Current time in nanoseconds.
+ */
+static uint64_t MEM_recordNow(void)
+{
+    /* Definition of Function Variables */
+    struct timespec now;
+
+    /* Start Function Logic */
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    /* Function Return */
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @fn      MEM_recordWrite
+ * @package MEM_alloc
+ * 
+ * @brief   Writes a whole buffer to the recording file.
+ *
+ * @param   [in] fd     Recording file.
+ * @param   [in] data   Bytes to write.
+ * @param   [in] length Number of bytes.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int MEM_recordWrite(int fd, const void *data, size_t length)
+{
+    /* Definition of Function Variables */
+    int ret         = 0u;
+    ssize_t written = 0;
+
+    /* Start Function Logic */
+    while (length > 0u)
+    {
+        written = write(fd, data, length);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            ret = errno;
+            goto end_of_function;
+        }
+
+        data    = (const uint8_t *)data + written;
+        length  -= (size_t)written;
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_recordLock
+ * @package MEM_alloc
+ * 
+ * @brief   Takes the busy flag of a record buffer.
+ *
+ * @details Only the owner and MEM_recordStop ever take it, so the owner almost never waits.
+ *
+ * @param   [in,out] buffer Record buffer.
+ */
+static void MEM_recordLock(record_buffer_t *buffer)
+{
+    /* Start Function Logic */
+    while (__atomic_exchange_n(&buffer->busy, 1u, __ATOMIC_SEQ_CST) != 0u)
+    {
+        sched_yield();
+    }
+}
+
+/**
+ * @fn      MEM_recordUnlock
+ * @package MEM_alloc
+ * 
+ * @brief   Releases the busy flag of a record buffer.
+ *
+ * @param   [in,out] buffer Record buffer.
+ */
+static void MEM_recordUnlock(record_buffer_t *buffer)
+{
+    /* Start Function Logic */
+    __atomic_store_n(&buffer->busy, 0u, __ATOMIC_RELEASE);
+}
+
+/**
+ * @fn      MEM_recordDrain
+ * @package MEM_alloc
+ * 
+ * @brief   Writes out the records of a buffer whose busy flag the caller holds.
+ *
+ * @details The buffer goes out in one write on an O_APPEND file, so the buffers of different
+ *          threads never interleave record by record. Records of another recording than
+ *          generation are dropped.
+ *
+ * @param   [in,out] buffer     Record buffer.
+ * @param   [in]     fd         Recording file, or -1 to drop the records.
+ * @param   [in]     generation Recording fd belongs to.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int MEM_recordDrain(record_buffer_t *buffer, int fd, uint64_t generation)
+{
+    /* Definition of Function Variables */
+    int ret = 0u;
+
+    /* Start Function Logic */
+    if (fd >= 0 && buffer->count != 0u && buffer->generation == generation)
+    {
+        ret = MEM_recordWrite(fd, buffer->records, buffer->count * sizeof(mem_record_t));
+    }
+
+    buffer->count = 0u;
+
+    /* Function Return */
+    return ret;
+}
+
+/**
+ * @fn      MEM_recordFlush
+ * @package MEM_alloc
+ * 
+ * @brief   Writes out the records buffered by the calling thread.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_recordFlush(void)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+    record_buffer_t *buffer = record_buffer;
+
+    /* Check deference/argument boundaries */
+    if (buffer == NULL || buffer->count == 0u)
+    {
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    MEM_recordLock(buffer);
+    ret = MEM_recordDrain(buffer, __atomic_load_n(&record_fd, __ATOMIC_SEQ_CST), __atomic_load_n(&record_generation, __ATOMIC_ACQUIRE));
+    MEM_recordUnlock(buffer);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_recordDestroy
+ * @package MEM_alloc
+ * 
+ * @brief   Thread-specific data destructor flushing the exiting thread's records.
+ *
+ * @details The buffer then goes back to the pool for the next thread that records.
+ *
+ * @param   [in] arg Record buffer bound to record_key.
+ */
+static void MEM_recordDestroy(void *arg)
+{
+    /* Definition of Function Variables */
+    record_buffer_t *buffer = (record_buffer_t *)arg;
+
+    /* Start Function Logic */
+    (void)MEM_recordFlush();
+
+    record_buffer = NULL;
+    __atomic_store_n(&buffer->owned, 0u, __ATOMIC_RELEASE);
+}
+
+/**
+ * @fn      MEM_recordCreateKey
+ * @package MEM_alloc
+ * 
+ * @brief   Creates record_key, once per process.
+ */
+static void MEM_recordCreateKey(void)
+{
+    /* Start Function Logic */
+    (void)pthread_key_create(&record_key, MEM_recordDestroy);
+}
+
+/**
+ * @fn      MEM_recordClaim
+ * @package MEM_alloc
+ * 
+ * @brief   Gives the calling thread a record buffer.
+ *
+ * @details Takes a buffer released by an exited thread, or maps a new one and pushes it onto
+ *          record_buffers, and binds it to record_key for the flush at thread exit.
+ *
+ * @return  The buffer, or NULL when no memory could be mapped.
+ */
+static record_buffer_t *MEM_recordClaim(void)
+{
+    /* Definition of Function Variables */
+    record_buffer_t *buffer = NULL;
+    uint32_t expected       = 0u;
+
+    /* Start Function Logic */
+    for (buffer = __atomic_load_n(&record_buffers, __ATOMIC_ACQUIRE); buffer != NULL; buffer = buffer->next)
+    {
+        expected = 0u;
+
+        if (__atomic_compare_exchange_n(&buffer->owned, &expected, 1u, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+
+    if (buffer == NULL)
+    {
+        buffer = mmap(NULL, sizeof(record_buffer_t), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buffer == MAP_FAILED)
+        {
+            buffer = NULL;
+            goto end_of_function;
+        }
+
+        buffer->owned   = 1u;
+        buffer->next    = __atomic_load_n(&record_buffers, __ATOMIC_RELAXED);
+
+        while (!__atomic_compare_exchange_n(&record_buffers, &buffer->next, buffer, 1, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        {
+        }
+    }
+
+    record_buffer = buffer;
+
+    (void)pthread_once(&record_key_once, MEM_recordCreateKey);
+    (void)pthread_setspecific(record_key, buffer);
+
+    /* Function Return */
+end_of_function:
+    return buffer;
+}
+
+/**
+ * @fn      MEM_recordFile
+ * @package MEM_alloc
+ * 
+ * @brief   Finds or claims the index of a source file name.
+ *
+ * @details Keys on the address of the name, which is a string literal at every call site, so
+ *          the lookup never reads the string.
+ *
+ * @param   [in] file Source file of the call, or NULL.
+ *
+ * @return  Index into record_files, or MEM_RECORD_NO_FILE when unknown or the table is full.
+ */
+static uint16_t MEM_recordFile(const char *file)
+{
+    /* Definition of Function Variables */
+    const char *seen    = NULL;
+    uint32_t slot       = 0u;
+    uint32_t probe      = 0u;
+
+    /* Check deference/argument boundaries */
+    if (file == NULL)
+    {
+        return MEM_RECORD_NO_FILE;
+    }
+
+    /* Assigning Initial Values for Variables */
+    slot = (uint32_t)(((uint64_t)(uintptr_t)file * 0x9E3779B97F4A7C15ULL) >> 32) & (MEM_RECORD_FILES - 1u);
+
+    /* Start Function Logic */
+    for (probe = 0u; probe < MEM_RECORD_FILES; ++probe)
+    {
+        seen = __atomic_load_n(&record_files[slot], __ATOMIC_ACQUIRE);
+
+        if (seen == NULL &&
+            __atomic_compare_exchange_n(&record_files[slot], &seen, file, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            return (uint16_t)slot;
+        }
+
+        if (seen == file)
+        {
+            return (uint16_t)slot;
+        }
+
+        slot = (slot + 1u) & (MEM_RECORD_FILES - 1u);
+    }
+
+    /* Function Return */
+    return MEM_RECORD_NO_FILE;
+}
+
+/**
+ * @fn      MEM_recordOp
+ * @package MEM_alloc
+ * 
+ * @brief   Appends an allocation record to the calling thread's buffer.
+ *
+ * @details Costs one relaxed load while no recording runs. The first record of a thread claims
+ *          its buffer, and the first record in a recording drops what the buffer held from an
+ *          earlier one. errno is preserved.
+ *
+ * @param   [in] op   Record kind, MEM_RECORD_MALLOC or MEM_RECORD_FREE.
+ * @param   [in] ptr  User pointer the call returned or released.
+ * @param   [in] size Requested bytes, 0 for a free.
+ * @param   [in] file Source file of the call.
+ * @param   [in] line Line number of the call.
+ */
+static void MEM_recordOp(mem_record_op_t op, const void *ptr, size_t size, const char *file, int line)
+{
+    /* Definition of Function Variables */
+    uint64_t generation     = 0u;
+    record_buffer_t *buffer = NULL;
+    mem_record_t *record    = NULL;
+    int saved_errno         = 0;
+    int fd                  = -1;
+
+    /* Check deference/argument boundaries */
+    if (__atomic_load_n(&record_fd, __ATOMIC_RELAXED) < 0 || ptr == NULL)
+    {
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    saved_errno = errno;
+    buffer      = record_buffer;
+
+    if (buffer == NULL)
+    {
+        buffer = MEM_recordClaim();
+        if (buffer == NULL)
+        {
+            goto restore_errno;
+        }
+    }
+
+    MEM_recordLock(buffer);
+
+    fd          = __atomic_load_n(&record_fd, __ATOMIC_SEQ_CST);
+    generation  = __atomic_load_n(&record_generation, __ATOMIC_ACQUIRE);
+
+    if (fd < 0)
+    {
+        goto unlock_buffer;
+    }
+
+    if (buffer->generation != generation)
+    {
+        buffer->generation  = generation;
+        buffer->count       = 0u;
+    }
+
+    /* Start Function Logic */
+    record              = &buffer->records[buffer->count++];
+    record->timestamp   = MEM_recordNow() - __atomic_load_n(&record_epoch, __ATOMIC_RELAXED);
+    record->id          = (uint64_t)(uintptr_t)ptr;
+    record->size        = (uint64_t)size;
+    record->line        = (uint32_t)line;
+    record->op          = (uint16_t)op;
+    record->file        = MEM_recordFile(file);
+
+    if (buffer->count == MEM_RECORD_BUFFER)
+    {
+        (void)MEM_recordDrain(buffer, fd, generation);
+    }
+
+unlock_buffer:
+    MEM_recordUnlock(buffer);
+
+restore_errno:
+    errno = saved_errno;
+
+    /* Function Return */
+end_of_function:
+    return;
+}
+
+/**
+ * @fn      MEM_recordStart
+ * @package MEM_alloc
+ * 
+ * @brief   Starts recording every allocation and free to a binary file.
+ *
+ * @param   [in] path File to create or truncate.
+ *
+ * @return  0 on success, EBUSY while a recording runs, other error code on failure.
+ */
+int MEM_recordStart(const char *path)
+{
+    /* Definition of Function Variables */
+    int ret         = 0u;
+    int fd          = -1;
+    int expected    = -1;
+
+    mem_record_header_t header;
+
+    /* Check deference/argument boundaries */
+    if (path == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    if (__atomic_load_n(&record_fd, __ATOMIC_ACQUIRE) >= 0)
+    {
+        ret = EBUSY;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MEM_RECORD_MAGIC, sizeof(MEM_RECORD_MAGIC));
+
+    header.version      = 1u;
+    header.record_size  = (uint32_t)sizeof(mem_record_t);
+
+    /* Start Function Logic */
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        ret = errno;
+        goto end_of_function;
+    }
+
+    ret = MEM_recordWrite(fd, &header, sizeof(header));
+    if (ret != 0u)
+    {
+        (void)close(fd);
+        goto end_of_function;
+    }
+
+    __atomic_store_n(&record_epoch, MEM_recordNow(), __ATOMIC_RELAXED);
+    __atomic_add_fetch(&record_generation, 1u, __ATOMIC_RELEASE);
+
+    if (!__atomic_compare_exchange_n(&record_fd, &expected, fd, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+    {
+        (void)close(fd);
+        ret = EBUSY;
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_recordStop
+ * @package MEM_alloc
+ * 
+ * @brief   Ends the recording and closes its file.
+ *
+ * @details Once record_fd is cleared no thread starts a record, so taking the busy flag of
+ *          every registered buffer waits for the ones in flight and drains what each holds.
+ *          Each file name then goes out as a MEM_RECORD_FILE record followed by the name, zero
+ *          padded to a whole number of records.
+ *
+ * @return  0 on success, EINVAL when no recording runs, other error code on failure.
+ */
+int MEM_recordStop(void)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+    int fd                  = -1;
+    uint32_t index          = 0u;
+    size_t length           = 0u;
+    uint64_t generation     = 0u;
+    const char *name        = NULL;
+    record_buffer_t *buffer = NULL;
+
+    mem_record_t record;
+    uint8_t padding[sizeof(mem_record_t)];
+
+    /* Assigning Initial Values for Variables */
+    memset(padding, 0, sizeof(padding));
+
+    generation  = __atomic_load_n(&record_generation, __ATOMIC_ACQUIRE);
+    fd          = __atomic_exchange_n(&record_fd, -1, __ATOMIC_SEQ_CST);
+
+    /* Check deference/argument boundaries */
+    if (fd < 0)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    for (buffer = __atomic_load_n(&record_buffers, __ATOMIC_SEQ_CST); buffer != NULL; buffer = buffer->next)
+    {
+        MEM_recordLock(buffer);
+
+        if (ret == 0u)
+        {
+            ret = MEM_recordDrain(buffer, fd, generation);
+        }
+
+        MEM_recordUnlock(buffer);
+    }
+
+    for (index = 0u; index < MEM_RECORD_FILES && ret == 0u; ++index)
+    {
+        name = __atomic_load_n(&record_files[index], __ATOMIC_ACQUIRE);
+        if (name == NULL)
+        {
+            continue;
+        }
+
+        length = strlen(name);
+
+        memset(&record, 0, sizeof(record));
+        record.op   = (uint16_t)MEM_RECORD_FILE;
+        record.file = (uint16_t)index;
+        record.size = (uint64_t)length;
+
+        ret = MEM_recordWrite(fd, &record, sizeof(record));
+        if (ret == 0u)
+        {
+            ret = MEM_recordWrite(fd, name, length);
+        }
+
+        if (ret == 0u && (length % sizeof(mem_record_t)) != 0u)
+        {
+            ret = MEM_recordWrite(fd, padding, sizeof(mem_record_t) - (length % sizeof(mem_record_t)));
+        }
+    }
+
+    if (close(fd) != 0 && ret == 0u)
+    {
+        ret = errno;
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+#if defined(_DEBUG_)
+/**
+ * @fn      MEM_debugHome
+ * @package MEM_alloc
+ * 
+ * @brief   Computes the preferred side-table slot of a block.
+ *
+ * @param   [in] block Pointer to the block header.
+ *
+ * @return  Slot index in [0, MEM_DEBUG_TABLE_SIZE).
+ */
+static size_t MEM_debugHome(const block_header_t *block)
+{
+    /* Function Return */
+    return (size_t)((((uintptr_t)block / ARCH_ALIGNMENT) * (uintptr_t)2654435761u) & (MEM_DEBUG_TABLE_SIZE - 1u));
+}
+
+/**
+ * @fn      MEM_debugLookup
+ * @package MEM_alloc
+ * 
+ * @brief   Finds the side-table entry of a block.
+ *
+ * @param   [in] block Pointer to the block header.
+ *
+ * @return  Pointer to the entry, or NULL when the block has none.
+ */
+static debug_entry_t *MEM_debugLookup(const block_header_t *block)
+{
+    /* Definition of Function Variables */
+    size_t slot     = 0u;
+    size_t probe    = 0u;
+
+    /* Assigning Initial Values for Variables */
+    slot = MEM_debugHome(block);
+
+    /* Start Function Logic */
+    for (probe = 0u; probe < MEM_DEBUG_TABLE_SIZE && debug_table[slot].block != NULL; ++probe)
+    {
+        if (debug_table[slot].block == block)
+        {
+            return &debug_table[slot];
+        }
+
+        slot = (slot + 1u) & (MEM_DEBUG_TABLE_SIZE - 1u);
+    }
+
+    /* Function Return */
+    return NULL;
+}
+
+/**
+ * @fn      MEM_debugRecord
+ * @package MEM_alloc
+ * 
+ * @brief   Stores the allocation source of a block in the side table.
+ *
+ * @details Uses linear probing from the block's home slot. The information is silently
+ *          dropped when the table is full.
+ *
+ * @param   [in] block    Pointer to the allocated block header.
+ * @param   [in] file     Name of the file requesting the allocation.
+ * @param   [in] line     Line number in the file requesting the allocation.
+ * @param   [in] var_name Name of the variable being allocated.
+ * @param   [in] size     Bytes requested by the caller.
+ */
+static void MEM_debugRecord(const block_header_t *block, const char *file, int line, const char *var_name, size_t size)
+{
+    /* Definition of Function Variables */
+    size_t slot     = 0u;
+    size_t probe    = 0u;
+
+    /* Assigning Initial Values for Variables */
+    slot = MEM_debugHome(block);
+
+    /* Start Function Logic */
+    pthread_mutex_lock(&debug_lock);
+
+    for (probe = 0u; probe < MEM_DEBUG_TABLE_SIZE; ++probe)
+    {
+        if (debug_table[slot].block == NULL || debug_table[slot].block == block)
+        {
+            debug_table[slot].block     = block;
+            debug_table[slot].file      = file;
+            debug_table[slot].line      = line;
+            debug_table[slot].var_name  = var_name;
+            debug_table[slot].size      = size;
+
+            break;
+        }
+
+        slot = (slot + 1u) & (MEM_DEBUG_TABLE_SIZE - 1u);
+    }
+
+    pthread_mutex_unlock(&debug_lock);
+}
+
+/**
+ * @fn      MEM_debugRemoveSlot
+ * @package MEM_alloc
+ * 
+ * @brief   Empties a side-table slot and repairs the probe sequences crossing it.
+ *
+ * @details Backward-shift deletion: following entries that could live in the emptied slot
+ *          are moved back, so the table never needs tombstones.
+ *
+ * @param   [in] slot Index of the slot to empty.
+ */
+static void MEM_debugRemoveSlot(size_t slot)
+{
+    /* Definition of Function Variables */
+    size_t hole = slot;
+    size_t next = 0u;
+    size_t home = 0u;
+
+    /* Start Function Logic */
+    next = (hole + 1u) & (MEM_DEBUG_TABLE_SIZE - 1u);
+
+    while (debug_table[next].block != NULL && next != slot)
+    {
+        home = MEM_debugHome(debug_table[next].block);
+
+        /* The entry may fill the hole when its home is not cyclically inside (hole, next] */
+        if (((next - home) & (MEM_DEBUG_TABLE_SIZE - 1u)) >= ((next - hole) & (MEM_DEBUG_TABLE_SIZE - 1u)))
+        {
+            debug_table[hole]   = debug_table[next];
+            hole                = next;
+        }
+
+        next = (next + 1u) & (MEM_DEBUG_TABLE_SIZE - 1u);
+    }
+
+    memset(&debug_table[hole], 0, sizeof(debug_entry_t));
+}
+
+/**
+ * @fn      MEM_debugForget
+ * @package MEM_alloc
+ * 
+ * @brief   Drops the side-table entry of a block, if any.
+ *
+ * @param   [in] block Pointer to the block header.
+ */
+static void MEM_debugForget(const block_header_t *block)
+{
+    /* Definition of Function Variables */
+    debug_entry_t *entry = NULL;
+
+    /* Start Function Logic */
+    pthread_mutex_lock(&debug_lock);
+
+    entry = MEM_debugLookup(block);
+    if (entry)
+    {
+        MEM_debugRemoveSlot((size_t)(entry - debug_table));
+    }
+
+    pthread_mutex_unlock(&debug_lock);
+}
+
+/**
+ * @fn      MEM_debugForgetRange
+ * @package MEM_alloc
+ * 
+ * @brief   Drops every side-table entry whose block lies in [start, end).
+ *
+ * @details Used when a heap is (re)initialized. Sweeps until a full pass removes nothing,
+ *          since backward shifts may move a matching entry into an already visited slot.
+ *
+ * @param   [in] start First byte of the range.
+ * @param   [in] end   One past the last byte of the range.
+ */
+static void MEM_debugForgetRange(const uint8_t *start, const uint8_t *end)
+{
+    /* Definition of Function Variables */
+    size_t slot     = 0u;
+    int removed     = 1;
+
+    /* Start Function Logic */
+    pthread_mutex_lock(&debug_lock);
+
+    while (removed)
+    {
+        removed = 0;
+
+        for (slot = 0u; slot < MEM_DEBUG_TABLE_SIZE; ++slot)
+        {
+            while (debug_table[slot].block != NULL &&
+                   (const uint8_t *)debug_table[slot].block >= start &&
+                   (const uint8_t *)debug_table[slot].block < end)
+            {
+                MEM_debugRemoveSlot(slot);
+                removed = 1;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&debug_lock);
+}
+#endif
+
+/**
+ * @fn      MEM_profileSiteSlot
+ * @package MEM_alloc
+ * 
+ * @brief   Finds or creates the profiler entry of an allocation site.
+ *
+ * @details Hashes the file name contents rather than its address, so the same site reached
+ *          through different copies of a string literal aggregates in one entry. Must be
+ *          called with profile_lock held.
+ *
+ * @param   [in] file Source file of the allocation.
+ * @param   [in] line Line number in the source file.
+ *
+ * @return  Slot index, or MEM_PROFILE_SITES when the table is full.
+ */
+static uint32_t MEM_profileSiteSlot(const char *file, int line)
+{
+    /* Definition of Function Variables */
+    uint64_t hash       = 0xCBF29CE484222325ULL;
+    const char *cursor  = NULL;
+    uint32_t slot       = 0u;
+    uint32_t probe      = 0u;
+
+    /* Assigning Initial Values for Variables */
+    file = (file != NULL) ? file : "Unknown";
+
+    for (cursor = file; *cursor != '\0'; ++cursor)
+    {
+        hash = (hash ^ (uint8_t)*cursor) * 0x100000001B3ULL;
+    }
+
+    hash = (hash ^ (uint32_t)line) * 0x100000001B3ULL;
+    slot = (uint32_t)(hash >> 32) & (MEM_PROFILE_SITES - 1u);
+
+    /* Start Function Logic */
+    for (probe = 0u; probe < MEM_PROFILE_SITES; ++probe)
+    {
+        if (profile_sites[slot].file == NULL)
+        {
+            profile_sites[slot].file = file;
+            profile_sites[slot].line = line;
+
+            return slot;
+        }
+
+        if (profile_sites[slot].line == line &&
+            (profile_sites[slot].file == file || strcmp(profile_sites[slot].file, file) == 0))
+        {
+            return slot;
+        }
+
+        slot = (slot + 1u) & (MEM_PROFILE_SITES - 1u);
+    }
+
+    /* Function Return */
+    return MEM_PROFILE_SITES;
+}
+
+/**
+ * @fn      MEM_profileHome
+ * @package MEM_alloc
+ * 
+ * @brief   Computes the preferred profiler-table slot of a block.
+ *
+ * @param   [in] block Pointer to the block header.
+ *
+ * @return  Slot index in [0, MEM_PROFILE_BLOCKS).
+ */
+static size_t MEM_profileHome(const block_header_t *block)
+{
+    /* Function Return */
+    return (size_t)((((uintptr_t)block / ARCH_ALIGNMENT) * (uintptr_t)2654435761u) & (MEM_PROFILE_BLOCKS - 1u));
+}
+
+/**
+ * @fn      MEM_profileRemoveSlot
+ * @package MEM_alloc
+ * 
+ * @brief   Empties a profiler-table slot and takes its block off its site.
+ *
+ * @details Backward-shift deletion as in MEM_debugRemoveSlot. Must be called with
+ *          profile_lock held.
+ *
+ * @param   [in] slot Index of the slot to empty.
+ */
+static void MEM_profileRemoveSlot(size_t slot)
+{
+    /* Definition of Function Variables */
+    mem_profile_site_t *site    = NULL;
+
+    size_t hole                 = slot;
+    size_t next                 = 0u;
+    size_t home                 = 0u;
+
+    /* Assigning Initial Values for Variables */
+    site = &profile_sites[profile_blocks[slot].site];
+
+    /* Start Function Logic */
+    site->live_bytes -= profile_blocks[slot].size;
+    site->live_count--;
+    __atomic_store_n(&profile_live, profile_live - 1u, __ATOMIC_RELAXED);
+
+    next = (hole + 1u) & (MEM_PROFILE_BLOCKS - 1u);
+
+    while (profile_blocks[next].block != NULL && next != slot)
+    {
+        home = MEM_profileHome(profile_blocks[next].block);
+
+        /* The entry may fill the hole when its home is not cyclically inside (hole, next] */
+        if (((next - home) & (MEM_PROFILE_BLOCKS - 1u)) >= ((next - hole) & (MEM_PROFILE_BLOCKS - 1u)))
+        {
+            profile_blocks[hole].size   = profile_blocks[next].size;
+            profile_blocks[hole].site   = profile_blocks[next].site;
+            __atomic_store_n(&profile_blocks[hole].block, profile_blocks[next].block, __ATOMIC_RELAXED);
+
+            hole = next;
+        }
+
+        next = (next + 1u) & (MEM_PROFILE_BLOCKS - 1u);
+    }
+
+    __atomic_store_n(&profile_blocks[hole].block, NULL, __ATOMIC_RELAXED);
+}
+
+/**
+ * @fn      MEM_profileSample
+ * @package MEM_alloc
+ * 
+ * @brief   Adds a sampled block to the profiler tables.
+ *
+ * @details The sample is dropped when either table is full.
+ *
+ * @param   [in] block Pointer to the allocated block header.
+ * @param   [in] file  Source file of the allocation.
+ * @param   [in] line  Line number in the source file.
+ * @param   [in] size  Bytes requested by the caller.
+ */
+static void MEM_profileSample(const block_header_t *block, const char *file, int line, size_t size)
+{
+    /* Definition of Function Variables */
+    mem_profile_site_t *site    = NULL;
+
+    uint32_t site_slot          = 0u;
+    size_t slot                 = 0u;
+    size_t probe                = 0u;
+
+    /* Assigning Initial Values for Variables */
+    slot = MEM_profileHome(block);
+
+    /* Start Function Logic */
+    pthread_mutex_lock(&profile_lock);
+
+    site_slot = MEM_profileSiteSlot(file, line);
+    if (site_slot == MEM_PROFILE_SITES)
+    {
+        goto end_of_function;
+    }
+
+    for (probe = 0u; probe < MEM_PROFILE_BLOCKS && profile_blocks[slot].block != NULL; ++probe)
+    {
+        slot = (slot + 1u) & (MEM_PROFILE_BLOCKS - 1u);
+    }
+
+    if (probe == MEM_PROFILE_BLOCKS)
+    {
+        goto end_of_function;
+    }
+
+    profile_blocks[slot].size   = size;
+    profile_blocks[slot].site   = site_slot;
+    __atomic_store_n(&profile_blocks[slot].block, block, __ATOMIC_RELAXED);
+
+    site                = &profile_sites[site_slot];
+    site->live_bytes    += size;
+    site->live_count++;
+    site->allocations++;
+    __atomic_store_n(&profile_live, profile_live + 1u, __ATOMIC_RELAXED);
+
+    if (site->live_bytes > site->peak_bytes)
+    {
+        site->peak_bytes = site->live_bytes;
+    }
+
+    /* Function Return */
+end_of_function:
+    pthread_mutex_unlock(&profile_lock);
+}
+
+/**
+ * @fn      MEM_profileRecord
+ * @package MEM_alloc
+ * 
+ * @brief   Counts an allocation towards the sample rate and samples it when due.
+ *
+ * @param   [in] block Pointer to the allocated block header.
+ * @param   [in] file  Source file of the allocation.
+ * @param   [in] line  Line number in the source file.
+ * @param   [in] size  Bytes requested by the caller.
+ */
+static inline void MEM_profileRecord(const block_header_t *block, const char *file, int line, size_t size)
+{
+    /* Definition of Function Variables */
+    uint32_t rate = __atomic_load_n(&profile_rate, __ATOMIC_RELAXED);
+
+    /* Check deference/argument boundaries */
+    if (rate == 0u)
+    {
+        return;
+    }
+
+    /* Start Function Logic */
+    if (profile_countdown == 0u || profile_countdown > rate)
+    {
+        profile_countdown = rate;
+    }
+
+    if (--profile_countdown == 0u)
+    {
+        MEM_profileSample(block, file, line, size);
+    }
+}
+
+/**
+ * @fn      MEM_profileForget
+ * @package MEM_alloc
+ * 
+ * @brief   Takes a block being freed or resized off its allocation site.
+ *
+ * @details Linear probing never leaves a hole between a key's home slot and the key, so an
+ *          empty home slot, read without the lock, means the block was not sampled. Only the
+ *          remaining frees take profile_lock.
+ *
+ * @param   [in] block Pointer to the block header.
+ */
+static inline void MEM_profileForget(const block_header_t *block)
+{
+    /* Definition of Function Variables */
+    size_t slot     = 0u;
+    size_t probe    = 0u;
+
+    /* Check deference/argument boundaries */
+    if (__atomic_load_n(&profile_live, __ATOMIC_RELAXED) == 0u)
+    {
+        return;
+    }
+
+    /* Assigning Initial Values for Variables */
+    slot = MEM_profileHome(block);
+
+    if (__atomic_load_n(&profile_blocks[slot].block, __ATOMIC_RELAXED) == NULL)
+    {
+        return;
+    }
+
+    /* Start Function Logic */
+    pthread_mutex_lock(&profile_lock);
+
+    for (probe = 0u; probe < MEM_PROFILE_BLOCKS && profile_blocks[slot].block != NULL; ++probe)
+    {
+        if (profile_blocks[slot].block == block)
+        {
+            MEM_profileRemoveSlot(slot);
+            break;
+        }
+
+        slot = (slot + 1u) & (MEM_PROFILE_BLOCKS - 1u);
+    }
+
+    pthread_mutex_unlock(&profile_lock);
+}
+
+/**
+ * @fn      MEM_profileForgetRange
+ * @package MEM_alloc
+ * 
+ * @brief   Drops every sampled block lying in [start, end).
+ *
+ * @details Used when a heap is (re)initialized or destroyed, sweeping like
+ *          MEM_debugForgetRange.
+ *
+ * @param   [in] start First byte of the range.
+ * @param   [in] end   One past the last byte of the range.
+ */
+static void MEM_profileForgetRange(const uint8_t *start, const uint8_t *end)
+{
+    /* Definition of Function Variables */
+    size_t slot     = 0u;
+    int removed     = 1;
+
+    /* Start Function Logic */
+    pthread_mutex_lock(&profile_lock);
+
+    removed = (profile_live != 0u);
+
+    while (removed)
+    {
+        removed = 0;
+
+        for (slot = 0u; slot < MEM_PROFILE_BLOCKS; ++slot)
+        {
+            while (profile_blocks[slot].block != NULL &&
+                   (const uint8_t *)profile_blocks[slot].block >= start &&
+                   (const uint8_t *)profile_blocks[slot].block < end)
+            {
+                MEM_profileRemoveSlot(slot);
+                removed = 1;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&profile_lock);
+}
+
+/**
+ * @fn      MEM_mappingInsert
+ * @package MEM_alloc
+ * 
+ * @brief   Maps a block size to the segregated free list that stores it.
+ *
+ * @details The first level is the power-of-two class of the size, the second level splits
+ *          that class linearly into MEM_NUM_SIZE_SUBCLASSES lists. Sizes below the first
+ *          power-of-two class share class 0; sizes beyond the last class land in its last list.
+ *
+ * @param   [in]  size Total block size, header included.
+ * @param   [out] fl   First-level index in [0, MEM_NUM_SIZE_CLASSES).
+ * @param   [out] sl   Second-level index in [0, MEM_NUM_SIZE_SUBCLASSES).
+ */
+static void MEM_mappingInsert(size_t size, uint32_t *fl, uint32_t *sl)
+{
+    /* Definition of Function Variables */
+    uint32_t log2 = 0u;
+
+    /* Start Function Logic */
+    if (size < ((size_t)1u << (MEM_SIZE_CLASS_MIN_SHIFT + MEM_SIZE_SUBCLASS_SHIFT)))
+    {
+        *fl = 0u;
+        *sl = (uint32_t)(size >> MEM_SIZE_CLASS_MIN_SHIFT);
+        return;
+    }
+
+    log2 = (uint32_t)(63 - __builtin_clzll((unsigned long long)size));
+
+    *fl = log2 - (MEM_SIZE_CLASS_MIN_SHIFT + MEM_SIZE_SUBCLASS_SHIFT) + 1u;
+    *sl = (uint32_t)(size >> (log2 - MEM_SIZE_SUBCLASS_SHIFT)) & (MEM_NUM_SIZE_SUBCLASSES - 1u);
+
+    if (*fl >= MEM_NUM_SIZE_CLASSES)
+    {
+        *fl = MEM_NUM_SIZE_CLASSES - 1u;
+        *sl = MEM_NUM_SIZE_SUBCLASSES - 1u;
+    }
+}
+
+/**
+ * @fn      MEM_mappingSearch
+ * @package MEM_alloc
+ * 
+ * @brief   Maps a request size to the first free list whose blocks all satisfy it.
+ *
+ * @details Rounds the size up to the next second-level boundary before mapping it, so every
+ *          block stored in the returned list (or in any later one) is large enough.
+ *
+ * @param   [in]  size Total block size needed, header included.
+ * @param   [out] fl   First-level index in [0, MEM_NUM_SIZE_CLASSES).
+ * @param   [out] sl   Second-level index in [0, MEM_NUM_SIZE_SUBCLASSES).
+ */
+static void MEM_mappingSearch(size_t size, uint32_t *fl, uint32_t *sl)
+{
+    /* Definition of Function Variables */
+    uint32_t log2 = 0u;
+
+    /* Start Function Logic */
+    if (size >= ((size_t)1u << (MEM_SIZE_CLASS_MIN_SHIFT + MEM_SIZE_SUBCLASS_SHIFT)))
+    {
+        log2 = (uint32_t)(63 - __builtin_clzll((unsigned long long)size));
+        size += ((size_t)1u << (log2 - MEM_SIZE_SUBCLASS_SHIFT)) - 1u;
+    }
+    else
+    {
+        size += ((size_t)1u << MEM_SIZE_CLASS_MIN_SHIFT) - 1u;
+    }
+
+    MEM_mappingInsert(size, fl, sl);
+}
+
+/**
+ * @fn      MEM_findSuitableList
+ * @package MEM_alloc
+ * 
+ * @brief   Locates the first non-empty free list at or after a given (fl, sl) pair.
+ *
+ * @details Masks the second-level bitmap of the class from sl upwards; when it is empty, the
+ *          first-level bitmap gives the next non-empty class, whose lowest non-empty sub-class
+ *          is taken. Both lookups are a single find-first-set each.
+ *
+ * @param   [in]     allocator Pointer to the memory allocator structure.
+ * @param   [in/out] fl        First-level index to start from; updated to the found list.
+ * @param   [in/out] sl        Second-level index to start from; updated to the found list.
+ *
+ * @return  Head of the found list, or NULL when no list at or after (fl, sl) holds a block.
+ */
+static block_header_t *MEM_findSuitableList(mem_allocator_t *allocator, uint32_t *fl, uint32_t *sl)
+{
+    /* Definition of Function Variables */
+    uint32_t sl_map = 0u;
+    uint32_t fl_map = 0u;
+
+    /* Start Function Logic */
+    sl_map = allocator->sl_bitmap[*fl] & (uint32_t)(~0u << *sl);
+
+    if (sl_map == 0u)
+    {
+        if (*fl + 1u < MEM_NUM_SIZE_CLASSES)
+        {
+            fl_map = allocator->fl_bitmap & (uint32_t)(~0u << (*fl + 1u));
+        }
+
+        if (fl_map == 0u)
+        {
+            return NULL;
+        }
+
+        *fl     = (uint32_t)__builtin_ctz(fl_map);
+        sl_map  = allocator->sl_bitmap[*fl];
+    }
+
+    *sl = (uint32_t)__builtin_ctz(sl_map);
+
+    return allocator->free_lists[*fl][*sl];
+}
+
+/**
+ * @fn      MEM_freeNode
+ * @package MEM_alloc
+ * 
+ * @brief   Size tree links of a free block.
+ *
+ * @param   [in] block Pointer to a free block of at least MEM_SIZE_TREE_MIN bytes.
+ *
+ * @return  Pointer to the node stored in the block payload.
+ */
+static free_node_t *MEM_freeNode(const block_header_t *block)
+{
+    /* Function Return */
+    return (free_node_t *)MEM_FREE_LINKS(block);
+}
+
+/**
+ * @fn      MEM_sizeTreeLess
+ * @package MEM_alloc
+ * 
+ * @brief   Orders free blocks by size, then by address.
+ *
+ * @param   [in] lhs First block.
+ * @param   [in] rhs Second block.
+ *
+ * @return  Non-zero when lhs sorts before rhs.
+ */
+static int MEM_sizeTreeLess(const block_header_t *lhs, const block_header_t *rhs)
+{
+    /* Function Return */
+    return (MEM_BLOCK_SIZE(lhs) < MEM_BLOCK_SIZE(rhs)) ||
+           (MEM_BLOCK_SIZE(lhs) == MEM_BLOCK_SIZE(rhs) && lhs < rhs);
+}
+
+/**
+ * @fn      MEM_sizeTreePriority
+ * @package MEM_alloc
+ * 
+ * @brief   Treap priority of a block, a multiplicative hash of its address.
+ *
+ * @param   [in] block Pointer to the block.
+ *
+ * @return  Priority; parents never have a lower one than their children.
+ */
+static uint32_t MEM_sizeTreePriority(const block_header_t *block)
+{
+    /* Function Return */
+    return (uint32_t)((((uint64_t)(uintptr_t)block / ARCH_ALIGNMENT) * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+/**
+ * @fn      MEM_sizeTreeReplace
+ * @package MEM_alloc
+ * 
+ * @brief   Makes the parent of a node point to another node instead.
+ *
+ * @param   [in/out] allocator   Pointer to the memory allocator structure.
+ * @param   [in]     parent      Parent of old_node, NULL when old_node is the root.
+ * @param   [in]     old_node    Current child.
+ * @param   [in]     new_node    Replacement, may be NULL.
+ */
+static void MEM_sizeTreeReplace(mem_allocator_t *allocator, block_header_t *parent, block_header_t *old_node, block_header_t *new_node)
+{
+    /* Start Function Logic */
+    if (parent == NULL)
+    {
+        allocator->size_tree = new_node;
+    }
+    else if (MEM_freeNode(parent)->left == old_node)
+    {
+        MEM_freeNode(parent)->left = new_node;
+    }
+    else
+    {
+        MEM_freeNode(parent)->right = new_node;
+    }
+
+    if (new_node)
+    {
+        MEM_freeNode(new_node)->parent = parent;
+    }
+}
+
+/**
+ * @fn      MEM_sizeTreeRotateUp
+ * @package MEM_alloc
+ * 
+ * @brief   Rotates a node above its parent, keeping the key order.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Node with a parent.
+ */
+static void MEM_sizeTreeRotateUp(mem_allocator_t *allocator, block_header_t *block)
+{
+    /* Definition of Function Variables */
+    free_node_t *node       = NULL;
+    free_node_t *parent     = NULL;
+    block_header_t *moved   = NULL;
+    block_header_t *up      = NULL;
+
+    /* Assigning Initial Values for Variables */
+    node    = MEM_freeNode(block);
+    up      = node->parent;
+    parent  = MEM_freeNode(up);
+
+    /* Start Function Logic */
+    MEM_sizeTreeReplace(allocator, parent->parent, up, block);
+
+    if (parent->left == block)
+    {
+        moved           = node->right;
+        parent->left    = moved;
+        node->right     = up;
+    }
+    else
+    {
+        moved           = node->left;
+        parent->right   = moved;
+        node->left      = up;
+    }
+
+    if (moved)
+    {
+        MEM_freeNode(moved)->parent = up;
+    }
+
+    parent->parent = block;
+}
+
+/**
+ * @fn      MEM_sizeTreeInsert
+ * @package MEM_alloc
+ * 
+ * @brief   Adds a free block to the size tree.
+ *
+ * @details Inserts at the leaf its key leads to, then rotates it up while its priority beats
+ *          its parent's. Expected O(log n).
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Free block of at least MEM_SIZE_TREE_MIN bytes.
+ */
+static void MEM_sizeTreeInsert(mem_allocator_t *allocator, block_header_t *block)
+{
+    /* Definition of Function Variables */
+    free_node_t *node           = NULL;
+    block_header_t *parent      = NULL;
+    block_header_t **link       = NULL;
+    uint32_t priority           = 0u;
+
+    /* Assigning Initial Values for Variables */
+    node        = MEM_freeNode(block);
+    link        = &allocator->size_tree;
+    priority    = MEM_sizeTreePriority(block);
+
+    /* Start Function Logic */
+    while (*link)
+    {
+        parent  = *link;
+        link    = MEM_sizeTreeLess(block, parent) ? &MEM_freeNode(parent)->left : &MEM_freeNode(parent)->right;
+    }
+
+    node->left      = NULL;
+    node->right     = NULL;
+    node->parent    = parent;
+    *link           = block;
+
+    if (allocator->size_tree_max == NULL || MEM_sizeTreeLess(allocator->size_tree_max, block))
+    {
+        allocator->size_tree_max = block;
+    }
+
+    while (node->parent && MEM_sizeTreePriority(node->parent) < priority)
+    {
+        MEM_sizeTreeRotateUp(allocator, block);
+    }
+}
+
+/**
+ * @fn      MEM_sizeTreeRemove
+ * @package MEM_alloc
+ * 
+ * @brief   Removes a free block from the size tree.
+ *
+ * @details Rotates the higher-priority child up until the block has at most one child, then
+ *          splices it out. Expected O(log n).
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Block linked in the tree.
+ */
+static void MEM_sizeTreeRemove(mem_allocator_t *allocator, block_header_t *block)
+{
+    /* Definition of Function Variables */
+    free_node_t *node       = NULL;
+    block_header_t *child   = NULL;
+
+    /* Assigning Initial Values for Variables */
+    node = MEM_freeNode(block);
+
+    /* Start Function Logic */
+    if (allocator->size_tree_max == block)
+    {
+        /* The maximum has no right child: its predecessor is the rightmost node on its left, or its parent */
+        child = node->left;
+        while (child && MEM_freeNode(child)->right)
+        {
+            child = MEM_freeNode(child)->right;
+        }
+
+        allocator->size_tree_max = child ? child : node->parent;
+    }
+
+    while (node->left && node->right)
+    {
+        child = (MEM_sizeTreePriority(node->left) > MEM_sizeTreePriority(node->right)) ? node->left : node->right;
+        MEM_sizeTreeRotateUp(allocator, child);
+    }
+
+    child = node->left ? node->left : node->right;
+    MEM_sizeTreeReplace(allocator, node->parent, block, child);
+
+    node->left      = NULL;
+    node->right     = NULL;
+    node->parent    = NULL;
+}
+
+/**
+ * @fn      MEM_sizeTreeBuild
+ * @package MEM_alloc
+ * 
+ * @brief   Builds the size tree from the free lists on the first Best-Fit search.
+ *
+ * @details Only Best-Fit reads the tree, so until it runs the other strategies keep their
+ *          O(1) free list updates. Every listed block of at least MEM_SIZE_TREE_MIN bytes is
+ *          inserted once, after which MEM_freeListInsert and MEM_freeListRemove maintain it.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ */
+static void MEM_sizeTreeBuild(mem_allocator_t *allocator)
+{
+    /* Definition of Function Variables */
+    uint32_t fl             = 0u;
+    uint32_t sl             = 0u;
+    uint32_t fl_map         = 0u;
+    uint32_t sl_map         = 0u;
+
+    block_header_t *block   = NULL;
+
+    /* Assigning Initial Values for Variables */
+    fl_map = allocator->fl_bitmap;
+
+    /* Start Function Logic */
+    while (fl_map != 0u)
+    {
+        fl      = (uint32_t)__builtin_ctz(fl_map);
+        sl_map  = allocator->sl_bitmap[fl];
+        fl_map &= fl_map - 1u;
+
+        while (sl_map != 0u)
+        {
+            sl      = (uint32_t)__builtin_ctz(sl_map);
+            sl_map &= sl_map - 1u;
+
+            for (block = allocator->free_lists[fl][sl]; block != NULL; block = MEM_FREE_LINKS(block)->next_free)
+            {
+                if (MEM_BLOCK_SIZE(block) >= MEM_SIZE_TREE_MIN)
+                {
+                    MEM_sizeTreeInsert(allocator, block);
+                }
+            }
+        }
+    }
+
+    allocator->size_tree_built = 1;
+}
+
+/**
+ * @fn      MEM_freeListInsert
+ * @package MEM_alloc
+ * 
+ * @brief   Links a free block at the head of its segregated free list.
+ *
+ * @details Pushes the block onto the list selected by MEM_mappingInsert and sets the
+ *          matching bits of both bitmaps. The block must not be linked already.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Pointer to the free block to be linked.
+ */
+static void MEM_freeListInsert(mem_allocator_t *allocator, block_header_t *block)
+{
+    /* Definition of Function Variables */
+    uint32_t fl             = 0u;
+    uint32_t sl             = 0u;
+
+    free_links_t *links     = NULL;
+
+    /* Assigning Initial Values for Variables */
+    MEM_mappingInsert(MEM_BLOCK_SIZE(block), &fl, &sl);
+    links = MEM_FREE_LINKS(block);
+
+    /* Start Function Logic */
+    links->prev_free = NULL;
+    links->next_free = allocator->free_lists[fl][sl];
+
+    if (links->next_free)
+    {
+        MEM_FREE_LINKS(links->next_free)->prev_free = block;
+    }
+
+    allocator->free_lists[fl][sl]   = block;
+    allocator->sl_bitmap[fl]       |= (uint32_t)(1u << sl);
+    allocator->fl_bitmap           |= (uint32_t)(1u << fl);
+
+    allocator->stats.free_bytes    += MEM_BLOCK_SIZE(block);
+    allocator->stats.free_blocks++;
+
+    if (allocator->size_tree_built && MEM_BLOCK_SIZE(block) >= MEM_SIZE_TREE_MIN)
+    {
+        MEM_sizeTreeInsert(allocator, block);
+    }
+}
+
+/**
+ * @fn      MEM_freeListRemove
+ * @package MEM_alloc
+ * 
+ * @brief   Unlinks a free block from its segregated free list.
+ *
+ * @details Removes the block in O(1) through its doubly linked free-list links and clears
+ *          the bitmap bits once its list (and its class) become empty. The block size must
+ *          be the one it was inserted with.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Pointer to the free block to be unlinked.
+ */
+static void MEM_freeListRemove(mem_allocator_t *allocator, block_header_t *block)
+{
+    /* Definition of Function Variables */
+    uint32_t fl             = 0u;
+    uint32_t sl             = 0u;
+
+    free_links_t *links     = NULL;
+
+    /* Assigning Initial Values for Variables */
+    MEM_mappingInsert(MEM_BLOCK_SIZE(block), &fl, &sl);
+    links = MEM_FREE_LINKS(block);
+
+    /* Start Function Logic */
+    if (links->prev_free)
+    {
+        MEM_FREE_LINKS(links->prev_free)->next_free = links->next_free;
+    }
+    else
+    {
+        allocator->free_lists[fl][sl] = links->next_free;
+    }
+
+    if (links->next_free)
+    {
+        MEM_FREE_LINKS(links->next_free)->prev_free = links->prev_free;
+    }
+
+    if (allocator->free_lists[fl][sl] == NULL)
+    {
+        allocator->sl_bitmap[fl] &= (uint32_t)~(1u << sl);
+
+        if (allocator->sl_bitmap[fl] == 0u)
+        {
+            allocator->fl_bitmap &= (uint32_t)~(1u << fl);
+        }
+    }
+
+    if (allocator->size_tree_built && MEM_BLOCK_SIZE(block) >= MEM_SIZE_TREE_MIN)
+    {
+        MEM_sizeTreeRemove(allocator, block);
+    }
+
+    allocator->stats.free_bytes -= MEM_BLOCK_SIZE(block);
+    allocator->stats.free_blocks--;
+
+    links->next_free = NULL;
+    links->prev_free = NULL;
+}
+
+/**
+ * @fn      MEM_statsAllocated
+ * @package MEM_alloc
+ * 
+ * @brief   Counts served allocations and refreshes the peak of bytes in use.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     strategy  Strategy that served the blocks.
+ * @param   [in]     count     Number of blocks handed out, 0 for an in-place resize.
+ */
+static void MEM_statsAllocated(mem_allocator_t *allocator, allocation_strategy_t strategy, size_t count)
+{
+    /* Definition of Function Variables */
+    size_t in_use = 0u;
+
+    /* Assigning Initial Values for Variables */
+    in_use = allocator->heap_bytes - allocator->stats.free_bytes;
+
+    /* Start Function Logic */
+    if ((uint32_t)strategy < MEM_NUM_STRATEGIES)
+    {
+        allocator->stats.mallocs[strategy] += count;
+    }
+
+    if (in_use > allocator->stats.peak_bytes_in_use)
+    {
+        allocator->stats.peak_bytes_in_use = in_use;
+    }
+}
+
+/**
+ * @fn      MEM_nextPhysBlock
+ * @package MEM_alloc
+ * 
+ * @brief   Returns the block that physically follows a given block.
+ *
+ * @details Every heap segment (the initial region and each grown chunk) ends with a fencepost
+ *          header of size 0, so the walk stops there without knowing the segment bounds.
+ *
+ * @param   [in] block Pointer to the current block.
+ *
+ * @return  Pointer to the next block, or NULL when the block is the last one of its segment.
+ */
+static block_header_t *MEM_nextPhysBlock(block_header_t *block)
+{
+    /* Definition of Function Variables */
+    block_header_t *next = NULL;
+
+    /* Start Function Logic */
+    next = (block_header_t *)((uint8_t *)block + MEM_BLOCK_SIZE(block));
+
+    /* Function Return */
+    return (MEM_BLOCK_SIZE(next) != 0u) ? next : NULL;
+}
+
+/**
+ * @fn      MEM_prevPhysBlock
+ * @package MEM_alloc
+ * 
+ * @brief   Returns the free block that physically precedes a given block.
+ *
+ * @details Reads the boundary tag stored in the block's prev_size field. The tag is only
+ *          maintained for free blocks, so the caller must check MEM_BLOCK_PREV_FREE first.
+ *
+ * @param   [in] block Pointer to a block whose MEM_BLOCK_PREV_FREE flag is set.
+ *
+ * @return  Pointer to the previous block.
+ */
+static block_header_t *MEM_prevPhysBlock(block_header_t *block)
+{
+    /* Function Return */
+    return (block_header_t *)((uint8_t *)block - block->prev_size);
+}
+
+/**
+ * @fn      MEM_loadBlockSize
+ * @package MEM_alloc
+ * 
+ * @brief   Reads the size field of a block that may be accessed without the allocator lock.
+ *
+ * @details In thread-safe mode a thread reads the headers of the blocks it owns without the
+ *          lock, while another thread holding the lock may update their MEM_BLOCK_PREV_FREE
+ *          flag. Both sides use relaxed atomics, which compile to plain loads and a locked
+ *          or/and on the neighbour.
+ *
+ * @param   [in] block Pointer to the block header.
+ *
+ * @return  Raw size field, flags included.
+ */
+static size_t MEM_loadBlockSize(const block_header_t *block)
+{
+    /* Function Return */
+    return __atomic_load_n(&block->size, __ATOMIC_RELAXED);
+}
+
+/**
+ * @fn      MEM_lockHeap
+ * @package MEM_alloc
+ * 
+ * @brief   Acquires the shared heap of an allocator in thread-safe mode.
+ *
+ * @details Tries the lock first so that acquisitions that had to wait are counted in the
+ *          statistics. Both counters are updated with the lock held.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ */
+static void MEM_lockHeap(mem_allocator_t *allocator)
+{
+    /* Start Function Logic */
+    if (allocator->thread_safe)
+    {
+        if (pthread_mutex_trylock(&allocator->lock) != 0)
+        {
+            pthread_mutex_lock(&allocator->lock);
+            allocator->stats.lock_contended++;
+        }
+
+        allocator->stats.lock_acquisitions++;
+    }
+}
+
+/**
+ * @fn      MEM_unlockHeap
+ * @package MEM_alloc
+ * 
+ * @brief   Releases the shared heap acquired by MEM_lockHeap.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ */
+static void MEM_unlockHeap(mem_allocator_t *allocator)
+{
+    /* Start Function Logic */
+    if (allocator->thread_safe)
+    {
+        pthread_mutex_unlock(&allocator->lock);
+    }
+}
+
+/**
+ * @fn      MEM_heapSegment
+ * @package MEM_alloc
+ * 
+ * @brief   Finds the heap segment holding an address.
+ *
+ * @details Segments are the initial region and the grown chunks. Chunk bounds are read with
+ *          relaxed atomics, since thread caches validate pointers without the heap lock; a
+ *          chunk cannot be released while one of its blocks is allocated, so the bounds seen
+ *          for a live block are always current.
+ *
+ * @param   [in]  allocator Pointer to the memory allocator structure.
+ * @param   [in]  ptr       Address to look up.
+ * @param   [out] start     First block of the segment.
+ * @param   [out] end       Fencepost header closing the segment.
+ *
+ * @return  Non-zero when a segment holds ptr.
+ */
+static int MEM_heapSegment(mem_allocator_t *allocator, const void *ptr, uint8_t **start, uint8_t **end)
+{
+    /* Definition of Function Variables */
+    const uint8_t *address  = NULL;
+    uint8_t *chunk_start    = NULL;
+    uint8_t *chunk_end      = NULL;
+
+    size_t count            = 0u;
+    size_t index            = 0u;
+    int found               = 0;
+
+    /* Assigning Initial Values for Variables */
+    address = (const uint8_t *)ptr;
+
+    /* Start Function Logic */
+    if (address >= allocator->heap && address < allocator->heap + allocator->heap_size - sizeof(block_header_t))
+    {
+        *start  = allocator->heap;
+        *end    = allocator->heap + allocator->heap_size - sizeof(block_header_t);
+        found   = 1;
+
+        goto end_of_function;
+    }
+
+    count = __atomic_load_n(&allocator->chunk_count, __ATOMIC_RELAXED);
+
+    for (index = 0u; index < count; ++index)
+    {
+        chunk_start = __atomic_load_n(&allocator->chunks[index].start, __ATOMIC_RELAXED);
+        chunk_end   = __atomic_load_n(&allocator->chunks[index].end, __ATOMIC_RELAXED);
+
+        if (chunk_start != NULL && address >= chunk_start && address < chunk_end)
+        {
+            *start  = chunk_start;
+            *end    = chunk_end;
+            found   = 1;
+
+            break;
+        }
+    }
+
+    /* Function Return */
+end_of_function:
+    return found;
+}
+
+/**
+ * @fn      MEM_nextHeapBlock
+ * @package MEM_alloc
+ * 
+ * @brief   Returns the block following a given one in heap walk order.
+ *
+ * @details Walks the initial region, then every grown chunk in slot order. Called with the
+ *          heap lock held.
+ *
+ * @param   [in] allocator Pointer to the memory allocator structure.
+ * @param   [in] block     Pointer to the current block.
+ *
+ * @return  Pointer to the next block, or NULL after the last block of the last segment.
+ */
+static block_header_t *MEM_nextHeapBlock(mem_allocator_t *allocator, block_header_t *block)
+{
+    /* Definition of Function Variables */
+    block_header_t *next    = NULL;
+    size_t index            = 0u;
+
+    /* Start Function Logic */
+    next = MEM_nextPhysBlock(block);
+    if (next)
+    {
+        goto end_of_function;
+    }
+
+    if ((uint8_t *)block < allocator->heap || (uint8_t *)block >= allocator->heap + allocator->heap_size)
+    {
+        while (index < allocator->chunk_count &&
+               ((uint8_t *)block < allocator->chunks[index].start || (uint8_t *)block >= allocator->chunks[index].end))
+        {
+            ++index;
+        }
+
+        ++index;
+    }
+
+    for (; index < allocator->chunk_count; ++index)
+    {
+        if (allocator->chunks[index].start != NULL)
+        {
+            next = (block_header_t *)allocator->chunks[index].start;
+            break;
+        }
+    }
+
+    /* Function Return */
+end_of_function:
+    return next;
+}
+
+/**
+ * @fn      MEM_heapSegmentAt
+ * @package MEM_alloc
+ * 
+ * @brief   Reads the bounds of one contiguous segment of a heap, by index.
+ *
+ * @details Segment 0 is the initial heap, segment i + 1 is chunks[i]. The end is the closing
+ *          fencepost, where a walk from start with MEM_nextPhysBlock ends.
+ *
+ * @param   [in]  allocator Pointer to the memory allocator structure.
+ * @param   [in]  index     Segment index, up to chunk_count.
+ * @param   [out] start     First block of the segment.
+ * @param   [out] end       Closing fencepost of the segment.
+ *
+ * @return  Non-zero when the segment is in use, 0 for a released chunk slot.
+ */
+static int MEM_heapSegmentAt(const mem_allocator_t *allocator, size_t index, uint8_t **start, uint8_t **end)
+{
+    /* Check deference/argument boundaries */
+    if (index > 0u && allocator->chunks[index - 1u].start == NULL)
+    {
+        return 0;
+    }
+
+    /* Start Function Logic */
+    *start  = (index == 0u) ? allocator->heap : allocator->chunks[index - 1u].start;
+    *end    = (index == 0u) ? allocator->heap + allocator->heap_size - sizeof(block_header_t)
+                            : allocator->chunks[index - 1u].end;
+
+    /* Function Return */
+    return 1;
+}
+
+/**
+ * @fn      MEM_markFree
+ * @package MEM_alloc
+ * 
+ * @brief   Publishes a block as free to its physical neighbours.
+ *
+ * @details Sets the block's free flag and writes its boundary tag into the prev_size field
+ *          of the next physical block, then raises that block's MEM_BLOCK_PREV_FREE flag.
+ *          The flag is updated atomically, see MEM_loadBlockSize.
+ *
+ * @param   [in/out] block Pointer to the block to mark as free.
+ */
+static void MEM_markFree(block_header_t *block)
+{
+    /* Definition of Function Variables */
+    block_header_t *next = NULL;
+
+    /* Start Function Logic */
+    block->size |= MEM_BLOCK_FREE;
+
+    next = MEM_nextPhysBlock(block);
+    if (next)
+    {
+        next->prev_size = MEM_BLOCK_SIZE(block);
+
+        /* The next block may be owned by a thread reading its header without the lock */
+        __atomic_fetch_or(&next->size, MEM_BLOCK_PREV_FREE, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @fn      MEM_markAllocated
+ * @package MEM_alloc
+ * 
+ * @brief   Publishes a block as allocated to its physical neighbours.
+ *
+ * @details Clears the block's free flag and the MEM_BLOCK_PREV_FREE flag of the next physical
+ *          block, whose boundary tag is stale from now on. The flag is updated atomically, see
+ *          MEM_loadBlockSize.
+ *
+ * @param   [in/out] block Pointer to the block to mark as allocated.
+ */
+static void MEM_markAllocated(block_header_t *block)
+{
+    /* Definition of Function Variables */
+    block_header_t *next = NULL;
+
+    /* Start Function Logic */
+    block->size &= ~MEM_BLOCK_FREE;
+
+    next = MEM_nextPhysBlock(block);
+    if (next)
+    {
+        __atomic_fetch_and(&next->size, ~MEM_BLOCK_PREV_FREE, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @fn      MEM_cookieSeed
+ * @package MEM_alloc
+ * 
+ * @brief   Returns the process-wide seed of the block cookie keys.
+ *
+ * @details Read from the AT_RANDOM bytes the kernel hands every process, so it costs no system
+ *          call; without them the addresses of a static and a stack variable, both randomized
+ *          by ASLR, stand in. Concurrent first calls compute the same value.
+ *
+ * @return  Non-zero seed.
+ */
+static uintptr_t MEM_cookieSeed(void)
+{
+    /* Definition of Function Variables */
+    uintptr_t seed          = 0u;
+    const void *random      = NULL;
+
+    /* Assigning Initial Values for Variables */
+    seed = __atomic_load_n(&cookie_seed, __ATOMIC_RELAXED);
+
+    /* Start Function Logic */
+    if (seed == 0u)
+    {
+        random = (const void *)getauxval(AT_RANDOM);
+
+        if (random != NULL)
+        {
+            memcpy(&seed, random, sizeof(uintptr_t));
+        }
+        else
+        {
+            seed = (uintptr_t)&cookie_seed ^ ((uintptr_t)&random << 16);
+        }
+
+        seed |= 1u;
+
+        __atomic_store_n(&cookie_seed, seed, __ATOMIC_RELAXED);
+    }
+
+    /* Function Return */
+    return seed;
+}
+
+/**
+ * @fn      MEM_blockCookie
+ * @package MEM_alloc
+ * 
+ * @brief   Returns the cookie sealing an allocated block of an allocator.
+ *
+ * @details The cookie mixes the block address with the allocator's secret key, so it can
+ *          neither be guessed from the heap contents nor match a block of another allocator.
+ *
+ * @param   [in] allocator Pointer to the memory allocator structure.
+ * @param   [in] block     Pointer to the block header.
+ *
+ * @return  Cookie of the block.
+ */
+static inline size_t MEM_blockCookie(const mem_allocator_t *allocator, const block_header_t *block)
+{
+    /* Function Return */
+    return (size_t)(((uintptr_t)block * (uintptr_t)0x9E3779B97F4A7C15ull) ^ allocator->cookie);
+}
+
+/**
+ * @fn      MEM_sealBlock
+ * @package MEM_alloc
+ * 
+ * @brief   Writes the cookie of an allocated block.
+ *
+ * @details The cookie goes into the prev_size field of the header that physically follows
+ *          the block, its fencepost included. That field is unused while the block is
+ *          allocated and gets the boundary tag back from MEM_markFree, so a freed block loses
+ *          its cookie. MEM_validPointerCheck compares it in constant time.
+ *
+ * @param   [in]     allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Pointer to an allocated block whose size is final.
+ */
+static void MEM_sealBlock(const mem_allocator_t *allocator, block_header_t *block)
+{
+    /* Definition of Function Variables */
+    block_header_t *next = NULL;
+
+    /* Assigning Initial Values for Variables */
+    next = (block_header_t *)((uint8_t *)block + MEM_BLOCK_SIZE(block));
+
+    /* Start Function Logic */
+    next->prev_size = MEM_blockCookie(allocator, block);
+}
+
+/**
+ * @fn      MEM_chunkMmapAcquire
+ * @package MEM_alloc
+ * 
+ * @brief   Default chunk provider: maps anonymous private memory.
+ *
+ * @param   [in] size    Size of the chunk in bytes.
+ * @param   [in] context Unused.
+ *
+ * @return  Pointer to the chunk, or NULL on failure.
+ */
+static void *MEM_chunkMmapAcquire(size_t size, void *context)
+{
+    /* Definition of Function Variables */
+    void *chunk = NULL;
+
+    /* Start Function Logic */
+    (void)context;
+
+    chunk = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    /* Function Return */
+    return (chunk == MAP_FAILED) ? NULL : chunk;
+}
+
+/**
+ * @fn      MEM_chunkMmapRelease
+ * @package MEM_alloc
+ * 
+ * @brief   Default chunk provider: unmaps a chunk.
+ *
+ * @param   [in] base    Chunk returned by MEM_chunkMmapAcquire.
+ * @param   [in] size    Size of the chunk in bytes.
+ * @param   [in] context Unused.
+ */
+static void MEM_chunkMmapRelease(void *base, size_t size, void *context)
+{
+    /* Start Function Logic */
+    (void)context;
+    munmap(base, size);
+}
+
+/**
+ * @fn      MEM_backingLength
+ * @package MEM_alloc
+ * 
+ * @brief   Rounds a size up to the pages a backing maps it with.
+ *
+ * @param   [in] size  Requested size in bytes.
+ * @param   [in] pages Page size of the backing.
+ *
+ * @return  Length of the mapping, 0 on overflow.
+ */
+static size_t MEM_backingLength(size_t size, mem_page_mode_t pages)
+{
+    /* Definition of Function Variables */
+    size_t granule  = 0u;
+    size_t length   = 0u;
+
+    /* Assigning Initial Values for Variables */
+    granule = (pages == MEM_PAGES_DEFAULT) ? (size_t)sysconf(_SC_PAGESIZE) : (size_t)MEM_HUGE_PAGE_SIZE;
+
+    /* Start Function Logic */
+    if (size <= SIZE_MAX - granule)
+    {
+        length = (size + granule - 1u) & ~(granule - 1u);
+    }
+
+    /* Function Return */
+    return length;
+}
+
+/**
+ * @fn      MEM_backingBind
+ * @package MEM_alloc
+ * 
+ * @brief   Binds the pages of a mapping to one NUMA node.
+ *
+ * @details Raw mbind(2), so no libnuma is needed. Nodes beyond one word of node mask and
+ *          kernels without NUMA support leave the mapping on the default policy.
+ *
+ * @param   [in] base   First byte of the mapping.
+ * @param   [in] length Length of the mapping.
+ * @param   [in] node   Node to bind to.
+ */
+static void MEM_backingBind(void *base, size_t length, int node)
+{
+    /* Definition of Function Variables */
+    unsigned long mask = 0u;
+
+    /* Check deference/argument boundaries */
+    if (node < 0 || (size_t)node >= sizeof(mask) * CHAR_BIT)
+    {
+        return;
+    }
+
+    /* Start Function Logic */
+    mask = 1UL << (unsigned)node;
+
+#if defined(SYS_mbind)
+    (void)syscall(SYS_mbind, base, length, MPOL_BIND, &mask, (unsigned long)(sizeof(mask) * CHAR_BIT) + 1UL, 0u);
+#else
+    (void)base;
+    (void)length;
+#endif
+}
+
+/**
+ * @fn      MEM_backingAcquire
+ * @package MEM_alloc
+ * 
+ * @brief   Chunk provider mapping memory with the page size and node of a mem_backing_t.
+ *
+ * @details THP mappings are over-mapped by one huge page and trimmed, so the region starts
+ *          on a huge page boundary and the kernel can back all of it with huge pages.
+ *
+ * @param   [in] size    Size of the chunk in bytes.
+ * @param   [in] context Pointer to a mem_backing_t, or NULL for base pages on any node.
+ *
+ * @return  Pointer to the chunk, or NULL on failure.
+ */
+void *MEM_backingAcquire(size_t size, void *context)
+{
+    /* Definition of Function Variables */
+    const mem_backing_t *backing    = (const mem_backing_t *)context;
+    mem_page_mode_t pages           = MEM_PAGES_DEFAULT;
+    int node                        = MEM_NODE_ANY;
+    int flags                       = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    size_t length                   = 0u;
+    size_t head                     = 0u;
+    uint8_t *span                   = NULL;
+    uint8_t *region                 = NULL;
+
+    /* Check deference/argument boundaries */
+    if (size == 0u)
+    {
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    if (backing != NULL)
+    {
+        pages   = backing->pages;
+        node    = backing->node;
+    }
+
+    length = MEM_backingLength(size, pages);
+    if (length == 0u)
+    {
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+#if defined(MAP_HUGETLB)
+    if (pages == MEM_PAGES_HUGETLB)
+    {
+    #if defined(MAP_HUGE_SHIFT)
+        flags |= __builtin_ctzl((unsigned long)MEM_HUGE_PAGE_SIZE) << MAP_HUGE_SHIFT;
+    #endif
+
+        region = mmap(NULL, length, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+        if (region == MAP_FAILED)
+        {
+            region = NULL;
+        }
+    }
+#endif
+
+    /* No huge pages reserved: transparent huge pages are the next best thing */
+    if (region == NULL && pages != MEM_PAGES_DEFAULT)
+    {
+        if (length > SIZE_MAX - MEM_HUGE_PAGE_SIZE)
+        {
+            goto end_of_function;
+        }
+
+        span = mmap(NULL, length + MEM_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (span == MAP_FAILED)
+        {
+            goto end_of_function;
+        }
+
+        region  = (uint8_t *)(((uintptr_t)span + (MEM_HUGE_PAGE_SIZE - 1u)) & ~((uintptr_t)MEM_HUGE_PAGE_SIZE - 1u));
+        head    = (size_t)(region - span);
+
+        if (head != 0u)
+        {
+            munmap(span, head);
+        }
+
+        munmap(region + length, MEM_HUGE_PAGE_SIZE - head);
+
+#if defined(MADV_HUGEPAGE)
+        (void)madvise(region, length, MADV_HUGEPAGE);
+#endif
+    }
+
+    if (region == NULL)
+    {
+        region = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED)
+        {
+            region = NULL;
+            goto end_of_function;
+        }
+    }
+
+    /* Before the first touch, or the pages land on the toucher's node */
+    MEM_backingBind(region, length, node);
+
+    /* Function Return */
+end_of_function:
+    return region;
+}
+
+/**
+ * @fn      MEM_backingRelease
+ * @package MEM_alloc
+ * 
+ * @brief   Returns a chunk obtained from MEM_backingAcquire.
+ *
+ * @param   [in] base    Chunk returned by MEM_backingAcquire.
+ * @param   [in] size    Size passed to MEM_backingAcquire.
+ * @param   [in] context Same mem_backing_t as given to MEM_backingAcquire.
+ */
+void MEM_backingRelease(void *base, size_t size, void *context)
+{
+    /* Definition of Function Variables */
+    const mem_backing_t *backing    = (const mem_backing_t *)context;
+    size_t length                   = 0u;
+
+    /* Check deference/argument boundaries */
+    if (base == NULL)
+    {
+        return;
+    }
+
+    /* Start Function Logic */
+    length = MEM_backingLength(size, (backing != NULL) ? backing->pages : MEM_PAGES_DEFAULT);
+
+    munmap(base, length);
+}
+
+/**
+ * @fn      MEM_numaNodeCount
+ * @package MEM_alloc
+ * 
+ * @brief   Returns the number of NUMA nodes of the machine.
+ *
+ * @details Parses the highest node of the sysfs online list, such as "0-3" or "0,2-3".
+ *
+ * @return  Highest online node plus one, 1 when the topology cannot be read.
+ */
+size_t MEM_numaNodeCount(void)
+{
+    /* Definition of Function Variables */
+    char text[256]  = { 0 };
+    ssize_t length  = 0;
+    ssize_t index   = 0;
+    size_t node     = 0u;
+    size_t count    = 1u;
+    int fd          = -1;
+
+    /* Assigning Initial Values for Variables */
+    fd = open("/sys/devices/system/node/online", O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        goto end_of_function;
+    }
+
+    length = read(fd, text, sizeof(text) - 1u);
+    close(fd);
+
+    /* Start Function Logic */
+    for (index = 0; index < length; ++index)
+    {
+        if (text[index] >= '0' && text[index] <= '9')
+        {
+            node = (node * 10u) + (size_t)(text[index] - '0');
+            continue;
+        }
+
+        if (index > 0 && text[index - 1] >= '0' && text[index - 1] <= '9' && node + 1u > count)
+        {
+            count = node + 1u;
+        }
+
+        node = 0u;
+    }
+
+    if (length > 0 && text[length - 1] >= '0' && text[length - 1] <= '9' && node + 1u > count)
+    {
+        count = node + 1u;
+    }
+
+    /* Function Return */
+end_of_function:
+    return count;
+}
+
+/**
+ * @fn      MEM_heapGrow
+ * @package MEM_alloc
+ * 
+ * @brief   Adds a chunk able to hold a payload of a given size to the heap.
+ *
+ * @details The chunk is at least chunk_size bytes, and large enough for the payload even after
+ *          the TLSF search rounds the request up. It becomes a single free block closed by a
+ *          fencepost header, published in a free chunk slot.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Aligned payload size the chunk must hold.
+ *
+ * @return  0 on success, ENOMEM when growth is disabled or the provider fails.
+ */
+static int MEM_heapGrow(mem_allocator_t *allocator, size_t size)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    size_t index            = 0u;
+    size_t length           = 0u;
+    size_t needed           = 0u;
+
+    void *base              = NULL;
+    uintptr_t start         = 0u;
+    uintptr_t end           = 0u;
+
+    block_header_t *block   = NULL;
+    block_header_t *fence   = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator->chunk_size == 0u || allocator->provider.acquire == NULL)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    if (size > (SIZE_MAX / 2u) - (4u * (size_t)ARCH_ALIGNMENT))
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    needed  = size + sizeof(block_header_t);
+    needed += (needed >> MEM_SIZE_SUBCLASS_SHIFT) + sizeof(block_header_t) + (2u * (size_t)ARCH_ALIGNMENT);
+    length  = (allocator->chunk_size > needed) ? allocator->chunk_size : needed;
+
+    while (index < MEM_CHUNKS_MAX && allocator->chunks[index].start != NULL)
+    {
+        ++index;
+    }
+
+    if (index == MEM_CHUNKS_MAX)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    base = allocator->provider.acquire(length, allocator->provider.context);
+    if (base == NULL)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    start   = ((uintptr_t)base + ((uintptr_t)ARCH_ALIGNMENT - 1u)) & ~((uintptr_t)ARCH_ALIGNMENT - 1u);
+    end     = ((uintptr_t)base + length - sizeof(block_header_t)) & ~((uintptr_t)ARCH_ALIGNMENT - 1u);
+
+    block               = (block_header_t *)start;
+    block->prev_size    = 0u;
+    block->size         = (size_t)(end - start);
+
+    fence               = (block_header_t *)end;
+    fence->prev_size    = 0u;
+    fence->size         = 0u;
+
+    allocator->chunks[index].base   = base;
+    allocator->chunks[index].length = length;
+
+    __atomic_store_n(&allocator->chunks[index].end, (uint8_t *)end, __ATOMIC_RELAXED);
+    __atomic_store_n(&allocator->chunks[index].start, (uint8_t *)start, __ATOMIC_RELAXED);
+
+    if (index >= allocator->chunk_count)
+    {
+        __atomic_store_n(&allocator->chunk_count, index + 1u, __ATOMIC_RELAXED);
+    }
+
+    allocator->heap_bytes += MEM_BLOCK_SIZE(block);
+
+    MEM_markFree(block);
+    MEM_freeListInsert(allocator, block);
+
+    MEM_traceRecord(MEM_TRACE_GROW, block, MEM_BLOCK_SIZE(block), 0u);
+    MEM_LOG_DEBUG("MEM_heapGrow: Added chunk at %p with %zu bytes.\n", (void *)block, MEM_BLOCK_SIZE(block));
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_chunkIsEmpty
+ * @package MEM_alloc
+ * 
+ * @brief   Tells whether a chunk slot holds a chunk made of a single free block.
+ *
+ * @param   [in] chunk Pointer to the chunk slot.
+ *
+ * @return  Non-zero when the chunk is in use and fully free.
+ */
+static int MEM_chunkIsEmpty(const mem_chunk_t *chunk)
+{
+    /* Definition of Function Variables */
+    block_header_t *block = NULL;
+
+    /* Assigning Initial Values for Variables */
+    block = (block_header_t *)chunk->start;
+
+    /* Function Return */
+    return block != NULL && MEM_BLOCK_IS_FREE(block) && MEM_nextPhysBlock(block) == NULL;
+}
+
+/**
+ * @fn      MEM_heapShrink
+ * @package MEM_alloc
+ * 
+ * @brief   Releases fully empty chunks past a number of bytes to keep.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     keep      Bytes of empty chunks to keep, usually the release threshold.
+ *
+ * @return  Number of bytes released.
+ */
+static size_t MEM_heapShrink(mem_allocator_t *allocator, size_t keep)
+{
+    /* Definition of Function Variables */
+    size_t index            = 0u;
+    size_t empty            = 0u;
+    size_t released         = 0u;
+
+    mem_chunk_t *chunk      = NULL;
+    block_header_t *block   = NULL;
+
+    /* Start Function Logic */
+    for (index = 0u; index < allocator->chunk_count; ++index)
+    {
+        if (MEM_chunkIsEmpty(&allocator->chunks[index]))
+        {
+            empty += allocator->chunks[index].length;
+        }
+    }
+
+    for (index = 0u; index < allocator->chunk_count && empty > keep; ++index)
+    {
+        chunk = &allocator->chunks[index];
+
+        if (!MEM_chunkIsEmpty(chunk))
+        {
+            continue;
+        }
+
+        block = (block_header_t *)chunk->start;
+
+        MEM_freeListRemove(allocator, block);
+
+        allocator->heap_bytes -= MEM_BLOCK_SIZE(block);
+
+        if (allocator->last_allocated == block)
+        {
+            allocator->last_allocated = (block_header_t *)allocator->heap;
+        }
+
+        __atomic_store_n(&chunk->start, (uint8_t *)NULL, __ATOMIC_RELAXED);
+        __atomic_store_n(&chunk->end, (uint8_t *)NULL, __ATOMIC_RELAXED);
+
+        empty       -= chunk->length;
+        released    += chunk->length;
+
+        MEM_traceRecord(MEM_TRACE_SHRINK, chunk->base, chunk->length, 0u);
+        MEM_LOG_DEBUG("MEM_heapShrink: Released chunk at %p with %zu bytes.\n", chunk->base, chunk->length);
+
+        if (allocator->provider.release)
+        {
+            allocator->provider.release(chunk->base, chunk->length, allocator->provider.context);
+        }
+
+        chunk->base     = NULL;
+        chunk->length   = 0u;
+    }
+
+    /* Function Return */
+    return released;
+}
+
+/**
+ * @fn      MEM_heapInit
+ * @package MEM_alloc
+ * 
+ * @brief   Initializes an allocator over a memory region.
+ *
+ * @details Creates the initial free block spanning all of the region but the closing fencepost
+ *          header. Only those two headers and the free-list links are written, so the pages of
+ *          the region are committed as allocations first touch them. The allocator starts in
+ *          single-threaded mode without growth; blocks the calling thread still caches for it
+ *          are dropped.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure to be initialized.
+ * @param   [in]     base      First byte of the region, aligned to ARCH_ALIGNMENT.
+ * @param   [in]     size      Size of the region, a multiple of ARCH_ALIGNMENT, at least
+ *                               two headers and MEM_MIN_PAYLOAD_SIZE.
+ */
+static void MEM_heapInit(mem_allocator_t *allocator, uint8_t *base, size_t size)
+{
+    /* Definition of Function Variables */
+    uint32_t fl                     = 0u;
+    uint32_t sl                     = 0u;
+
+    block_header_t *initial_block   = NULL;
+    block_header_t *fence           = NULL;
+
+    /* Assigning Initial Values for Variables */
+#if defined(_DEBUG_)
+    MEM_debugForgetRange(base, base + size);
+#endif
+
+    MEM_profileForgetRange(base, base + size);
+
+    initial_block               = (block_header_t *)(base);
+    fence                       = (block_header_t *)(base + size - sizeof(block_header_t));
+
+    /* Start Function Logic */
+    initial_block->prev_size    = 0u;
+    initial_block->size         = size - sizeof(block_header_t);
+
+    fence->prev_size            = 0u;
+    fence->size                 = 0u;
+
+    allocator->heap             = base;
+    allocator->heap_size        = size;
+    allocator->mapped_size      = 0u;
+    allocator->backing.pages    = MEM_PAGES_DEFAULT;
+    allocator->backing.node     = MEM_NODE_ANY;
+    allocator->cookie           = MEM_cookieSeed() ^ (uintptr_t)allocator;
+    allocator->chunk_count      = 0u;
+    allocator->chunk_size       = 0u;
+    allocator->release_threshold = 0u;
+    allocator->trim_threshold   = 0u;
+
+    memset(allocator->chunks, 0, sizeof(allocator->chunks));
+    memset(&allocator->provider, 0, sizeof(mem_chunk_provider_t));
+    allocator->last_allocated   = initial_block;
+    allocator->size_tree        = NULL;
+    allocator->size_tree_max    = NULL;
+    allocator->size_tree_built  = 0;
+    allocator->heap_bytes       = initial_block->size;
+    allocator->fl_bitmap        = 0u;
+
+    memset(&allocator->stats, 0, sizeof(mem_alloc_stats_t));
+    allocator->thread_safe      = 0;
+    allocator->remote_free      = NULL;
+
+    allocator->deferred_coalescing = 0;
+    memset(allocator->fastbins, 0, sizeof(allocator->fastbins));
+    allocator->fastbin_count    = 0u;
+    allocator->fastbin_cursor   = 0u;
+
+    memset(&allocator->tcache_stats, 0, sizeof(mem_tcache_stats_t));
+    pthread_mutex_init(&allocator->lock, NULL);
+
+    if (tcache.owner == allocator)
+    {
+        memset(&tcache, 0, sizeof(mem_tcache_t));
+    }
+
+    for (fl = 0u; fl < MEM_NUM_SIZE_CLASSES; ++fl)
+    {
+        allocator->sl_bitmap[fl] = 0u;
+
+        for (sl = 0u; sl < MEM_NUM_SIZE_SUBCLASSES; ++sl)
+        {
+            allocator->free_lists[fl][sl] = NULL;
+        }
+    }
+
+    MEM_markFree(initial_block);
+    MEM_freeListInsert(allocator, initial_block);
+}
+
+/**
+ * @fn      MEM_allocatorInit
+ * @package MEM_alloc
+ * 
+ * @brief   Initializes the memory allocator.
+ *
+ * @details Sets up the memory allocator by creating the initial free block that spans the
+ *          entire heap. The heap itself is not cleared, see MEM_heapInit. The allocator starts
+ *          in single-threaded mode; blocks the calling thread still caches for it are dropped.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure to be initialized.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorInit(mem_allocator_t *allocator) 
+{
+    /* Definition of Function Variables */
+    int ret = 0u;
+    
+    /* Check deference/argument boundaries */
+    if (allocator == NULL) 
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    MEM_heapInit(allocator, heap_memory, HEAP_SIZE);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_allocatorInitRegion
+ * @package MEM_alloc
+ * 
+ * @brief   Initializes the memory allocator over a caller-supplied memory region.
+ *
+ * @details Aligns the base up and the end down to ARCH_ALIGNMENT, then lays out the heap in
+ *          what remains.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure to be initialized.
+ * @param   [in]     base      First byte of the region.
+ * @param   [in]     size      Size of the region in bytes.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorInitRegion(mem_allocator_t *allocator, void *base, size_t size)
+{
+    /* Definition of Function Variables */
+    int ret             = 0u;
+
+    uintptr_t start     = 0u;
+    uintptr_t end       = 0u;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || base == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    if (size > UINTPTR_MAX - (uintptr_t)base)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    start   = ((uintptr_t)base + ((uintptr_t)ARCH_ALIGNMENT - 1u)) & ~((uintptr_t)ARCH_ALIGNMENT - 1u);
+    end     = ((uintptr_t)base + size) & ~((uintptr_t)ARCH_ALIGNMENT - 1u);
+
+    /* Start Function Logic */
+    if (end <= start || (size_t)(end - start) < (2u * sizeof(block_header_t)) + MEM_MIN_PAYLOAD_SIZE)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    MEM_heapInit(allocator, (uint8_t *)start, (size_t)(end - start));
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_allocatorInitMmap
+ * @package MEM_alloc
+ * 
+ * @brief   Initializes the memory allocator over an anonymous private mapping.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure to be initialized.
+ * @param   [in]     size      Requested heap size in bytes, rounded up to the page size.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorInitMmap(mem_allocator_t *allocator, size_t size)
+{
+    /* Definition of Function Variables */
+    int ret         = 0u;
+
+    size_t page     = 0u;
+    size_t length   = 0u;
+    void *region    = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || size == 0u)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    page = (size_t)sysconf(_SC_PAGESIZE);
+
+    if (size > SIZE_MAX - page)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    length = (size + page - 1u) & ~(page - 1u);
+
+    /* Start Function Logic */
+    region = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    ret = MEM_allocatorInitRegion(allocator, region, length);
+    if (ret != 0u)
+    {
+        munmap(region, length);
+        goto end_of_function;
+    }
+
+    allocator->mapped_size = length;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_allocatorInitBacked
+ * @package MEM_alloc
+ * 
+ * @brief   Initializes the memory allocator over a mapping with a given page size and node.
+ *
+ * @details The mapping is made by MEM_backingAcquire, so MEM_allocatorDestroy unmaps it
+ *          like the one of MEM_allocatorInitMmap.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure to be initialized.
+ * @param   [in]     size      Requested heap size in bytes, rounded up to the page size used.
+ * @param   [in]     backing   Page size and node of the heap.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorInitBacked(mem_allocator_t *allocator, size_t size, const mem_backing_t *backing)
+{
+    /* Definition of Function Variables */
+    int ret         = 0u;
+
+    size_t length   = 0u;
+    void *region    = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || size == 0u || backing == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    length = MEM_backingLength(size, backing->pages);
+    if (length == 0u)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    region = MEM_backingAcquire(size, (void *)backing);
+    if (region == NULL)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    ret = MEM_allocatorInitRegion(allocator, region, length);
+    if (ret != 0u)
+    {
+        MEM_backingRelease(region, size, (void *)backing);
+        goto end_of_function;
+    }
+
+    allocator->mapped_size  = length;
+    allocator->backing      = *backing;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_findFirstFit
+ * @package MEM_alloc
+ * 
+ * @brief   Finds the first free block that can accommodate the requested size.
+ *
+ * @details Implements the First-Fit allocation strategy by walking the heap in address order and
+ *          returning the first free block that is large enough to satisfy the allocation request.
+ *
+ * @param   [in]      allocator Pointer to the memory allocator structure.
+ * @param   [in]      size      Requested memory size.
+ * @param   [out]     fit_block Output parameter to store the found free block.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int MEM_findFirstFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block) 
+{
+    /* Definition of Function Variables */
+    int ret = 0u;
+
+    block_header_t *current = NULL;
+    
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || fit_block == NULL) 
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+    
+    /* Assigning Initial Values for Variables */
+    current = (block_header_t *)allocator->heap;
+
+    /* Start Function Logic */
+    while (current) 
+    {
+        if (MEM_BLOCK_IS_FREE(current) && MEM_BLOCK_SIZE(current) >= size + sizeof(block_header_t)) {
+            *fit_block = current;
+            goto end_of_function;
+        }
+
+        current = MEM_nextHeapBlock(allocator, current);
+    }
+
+    ret = ENOMEM;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_findNextFit
+ * @package MEM_alloc
+ * 
+ * @brief   Finds the next suitable free block starting from the last allocated block.
+ *
+ * @details Implements the Next-Fit allocation strategy by continuing the search from where the last
+ *          allocation occurred, potentially improving allocation distribution and reducing fragmentation.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Requested memory size.
+ * @param   [out]    fit_block Output parameter to store the found free block.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int MEM_findNextFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block) 
+{
+    /* Definition of Function Variables */
+    int ret                     = 0u;
+
+    block_header_t *current     = NULL;
+    block_header_t *start       = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || fit_block == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+    
+    /* Assigning Initial Values for Variables */
+    current     = allocator->last_allocated;
+    start       = current;
+
+    /* Start Function Logic */
+    do 
+    {
+        if (MEM_BLOCK_IS_FREE(current) && MEM_BLOCK_SIZE(current) >= size + sizeof(block_header_t)) 
+        {
+            *fit_block                  = current;
+            allocator->last_allocated   = current;
+
+            goto end_of_function;
+        }
+
+        current = MEM_nextHeapBlock(allocator, current);
+        if (current == NULL)
+        {
+            current = (block_header_t *)allocator->heap;
+        }
+    } while (current != start);
+
+
+    ret = ENOMEM;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_findBestFit
+ * @package MEM_alloc
+ * 
+ * @brief   Finds the best-fit free block for the requested size.
+ *
+ * @details Implements the Best-Fit allocation strategy by selecting the smallest free block that is
+ *          large enough to satisfy the allocation request, the lowest-addressed one among equals,
+ *          aiming to minimize fragmentation. Blocks of at least MEM_SIZE_TREE_MIN bytes are found by a
+ *          lower-bound search of the size tree in expected O(log n); smaller requests first check the
+ *          exact-size lists of size class 0 through its bitmap and scan the smallest non-empty one
+ *          for its lowest address. The first call builds the tree, which the free list updates
+ *          maintain from then on.
+ *
+ * @param   [in]      allocator Pointer to the memory allocator structure.
+ * @param   [in]      size      Requested memory size.
+ * @param   [out]     best_fit  Output parameter to store the best-fit free block.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int MEM_findBestFit(mem_allocator_t *allocator, size_t size, block_header_t **best_fit) 
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    size_t needed           = 0u;
+    uint32_t small_lists    = 0u;
+    block_header_t *current = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || best_fit == NULL) 
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+    
+    /* Assigning Initial Values for Variables */
+    if (!allocator->size_tree_built)
+    {
+        MEM_sizeTreeBuild(allocator);
+    }
+
+    *best_fit   = NULL;
+    needed      = size + sizeof(block_header_t);
+    current     = allocator->size_tree;
+
+    /* Start Function Logic */
+    if (needed < MEM_SIZE_TREE_MIN)
+    {
+        /* Each small sub-class holds a single block size, so its first non-empty list is the best fit */
+        small_lists = allocator->sl_bitmap[0] & ~(uint32_t)((1u << ((needed + ((size_t)1u << MEM_SIZE_CLASS_MIN_SHIFT) - 1u) >> MEM_SIZE_CLASS_MIN_SHIFT)) - 1u);
+
+        if (small_lists != 0u)
+        {
+            /* The list is LIFO, the lowest-addressed of its equal blocks breaks the tie */
+            for (current = allocator->free_lists[0][__builtin_ctz(small_lists)]; current != NULL; current = MEM_FREE_LINKS(current)->next_free)
+            {
+                if (*best_fit == NULL || current < *best_fit)
+                {
+                    *best_fit = current;
+                }
+            }
+
+            goto end_of_function;
+        }
+    }
+
+    while (current)
+    {
+        if (MEM_BLOCK_SIZE(current) >= needed)
+        {
+            *best_fit   = current;
+            current     = MEM_freeNode(current)->left;
+        }
+        else
+        {
+            current     = MEM_freeNode(current)->right;
+        }
+    }
+
+    if (*best_fit == NULL) 
+    {
+        ret = ENOMEM;
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_findSegregatedFit
+ * @package MEM_alloc
+ * 
+ * @brief   Finds a free block through the segregated size-class free lists.
+ *
+ * @details Implements the Segregated-Fit allocation strategy. The free list matching the
+ *          request is scanned first; when it holds no suitable block, the bitmaps yield
+ *          the next non-empty larger list, whose head fits by construction.
+ *
+ * @param   [in]      allocator Pointer to the memory allocator structure.
+ * @param   [in]      size      Requested memory size.
+ * @param   [out]     fit_block Output parameter to store the found free block.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int MEM_findSegregatedFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    size_t needed           = 0u;
+    uint32_t fl             = 0u;
+    uint32_t sl             = 0u;
+
+    block_header_t *current = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || fit_block == NULL) 
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    needed  = size + sizeof(block_header_t);
+
+    MEM_mappingInsert(needed, &fl, &sl);
+    current = allocator->free_lists[fl][sl];
+
+    /* Start Function Logic */
+    while (current) 
+    {
+        if (MEM_BLOCK_SIZE(current) >= needed) 
+        {
+            *fit_block = current;
+            goto end_of_function;
+        }
+
+        current = MEM_FREE_LINKS(current)->next_free;
+    }
+
+    if (++sl == MEM_NUM_SIZE_SUBCLASSES)
+    {
+        sl = 0u;
+
+        if (++fl == MEM_NUM_SIZE_CLASSES)
+        {
+            ret = ENOMEM;
+            goto end_of_function;
+        }
+    }
+
+    *fit_block = MEM_findSuitableList(allocator, &fl, &sl);
+    if (*fit_block == NULL)
+    {
+        ret = ENOMEM;
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_findTlsfFit
+ * @package MEM_alloc
+ * 
+ * @brief   Finds a free block in constant time with the Two-Level Segregated Fit strategy.
+ *
+ * @details Rounds the request up to the next sub-class boundary so that any block of the
+ *          resulting list fits, then locates the first non-empty list at or above it with
+ *          two bitmap lookups (find-first-set on the second and first level).
+ *
+ * @param   [in]      allocator Pointer to the memory allocator structure.
+ * @param   [in]      size      Requested memory size.
+ * @param   [out]     fit_block Output parameter to store the found free block.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int MEM_findTlsfFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    size_t needed           = 0u;
+    uint32_t fl             = 0u;
+    uint32_t sl             = 0u;
+
+    block_header_t *current = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || fit_block == NULL) 
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    needed = size + sizeof(block_header_t);
+
+    MEM_mappingSearch(needed, &fl, &sl);
+
+    /* Start Function Logic */
+    current = MEM_findSuitableList(allocator, &fl, &sl);
+
+    /* Only the catch-all list of the last class can hold blocks smaller than its index */
+    while (current && MEM_BLOCK_SIZE(current) < needed)
+    {
+        current = MEM_FREE_LINKS(current)->next_free;
+    }
+
+    if (current == NULL)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    *fit_block = current;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_splitBlock
+ * @package MEM_alloc
+ * 
+ * @brief   Splits a free block into two if possible.
+ *
+ * @details Divides a larger free block into an allocated block and a smaller free b
+ *          lock while maintaining alignment constraints. Updates the free lists and boundary tags accordingly.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Pointer to the block to be split.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_splitBlock(mem_allocator_t *allocator, block_header_t *block, size_t size) 
+{
+    /* Definition of Function Variables */
+    int ret                     = 0u;
+
+    size_t aligned_size         = 0u;
+
+    uint8_t *new_block_addr     = NULL;
+    block_header_t *new_block   = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || block == NULL) 
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+    
+    /* Assigning Initial Values for Variables */
+    aligned_size = ALIGN(size);
+
+    if (aligned_size < MEM_MIN_PAYLOAD_SIZE)
+    {
+        aligned_size = MEM_MIN_PAYLOAD_SIZE;
+    }
+
+    /* Start Function Logic */
+    if (MEM_BLOCK_IS_FREE(block))
+    {
+        MEM_freeListRemove(allocator, block);
+    }
+
+    if (MEM_BLOCK_SIZE(block) >= aligned_size + (2u * sizeof(block_header_t)) + MEM_MIN_PAYLOAD_SIZE) 
+    {
+        new_block_addr      = (uint8_t *)block + sizeof(block_header_t) + aligned_size;
+        new_block           = (block_header_t *)new_block_addr;
+
+        new_block->size     = MEM_BLOCK_SIZE(block) - sizeof(block_header_t) - aligned_size;
+
+        block->size         = (aligned_size + sizeof(block_header_t)) | (block->size & MEM_BLOCK_PREV_FREE);
+
+        MEM_markFree(new_block);
+        MEM_freeListInsert(allocator, new_block);
+
+        allocator->stats.splits++;
+
+        MEM_traceRecord(MEM_TRACE_SPLIT, new_block, MEM_BLOCK_SIZE(new_block), 0u);
+        MEM_LOG_DEBUG("MEM_splitBlock: Split block. New block at %p with size %zu bytes.\n",
+                   (void *)new_block, MEM_BLOCK_SIZE(new_block));
+    } 
+    else 
+    {
+        MEM_markAllocated(block);
+        MEM_LOG_DEBUG("MEM_splitBlock: Block at %p not split. Marked as allocated.\n", (void *)block);
+    }
+
+    MEM_sealBlock(allocator, block);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_trimRange
+ * @package MEM_alloc
+ * 
+ * @brief   Gives the whole pages of a byte range back to the kernel.
+ *
+ * @param   [in] first First byte of the range.
+ * @param   [in] last  Byte past the range.
+ *
+ * @return  Number of bytes advised, 0 when the range holds no whole page or madvise fails.
+ */
+static size_t MEM_trimRange(uintptr_t first, uintptr_t last)
+{
+    /* Definition of Function Variables */
+    uintptr_t page  = 0u;
+    size_t length   = 0u;
+
+    /* Assigning Initial Values for Variables */
+    page    = (uintptr_t)sysconf(_SC_PAGESIZE);
+    first   = (first + (page - 1u)) & ~(page - 1u);
+    last    = last & ~(page - 1u);
+
+    /* Start Function Logic */
+    if (last > first && madvise((void *)first, (size_t)(last - first), MEM_TRIM_ADVICE) == 0)
+    {
+        length = (size_t)(last - first);
+    }
+
+    /* Function Return */
+    return length;
+}
+
+/**
+ * @fn      MEM_trimBlock
+ * @package MEM_alloc
+ * 
+ * @brief   Gives the whole pages inside a free block back to the kernel.
+ *
+ * @details The header and the free_node_t after it carry the free-list and size-tree links,
+ *          and the next block's header carries the boundary tag: all of them stay resident.
+ *
+ * @param   [in] block Pointer to a free block header.
+ * @param   [in] pad   Bytes kept resident after the free-list node.
+ *
+ * @return  Number of bytes advised.
+ */
+static size_t MEM_trimBlock(const block_header_t *block, size_t pad)
+{
+    /* Definition of Function Variables */
+    uintptr_t first = 0u;
+    uintptr_t last  = 0u;
+
+    /* Assigning Initial Values for Variables */
+    first   = (uintptr_t)block + sizeof(block_header_t) + sizeof(free_node_t);
+    last    = (uintptr_t)block + MEM_BLOCK_SIZE(block);
+
+    /* Check deference/argument boundaries */
+    if (last <= first || pad >= last - first)
+    {
+        return 0u;
+    }
+
+    /* Function Return */
+    return MEM_trimRange(first + pad, last);
+}
+
+/**
+ * @fn      MEM_coalesceBlock
+ * @package MEM_alloc
+ * 
+ * @brief   Marks an allocated block free and merges it with its free neighbours.
+ *
+ * @details A merge leaving a free block of at least the trim threshold gives the freed
+ *          block's pages back, see MEM_allocatorSetTrimThreshold. A grown chunk left fully
+ *          empty may be released.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Pointer to a validated, allocated block header.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int MEM_coalesceBlock(mem_allocator_t *allocator, block_header_t *block)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+    block_header_t *merged  = NULL;
+
+    uintptr_t first         = 0u;
+    uintptr_t last          = 0u;
+
+    /* Assigning Initial Values for Variables */
+    first   = (uintptr_t)block;
+    last    = (uintptr_t)block + MEM_BLOCK_SIZE(block);
+
+    /* Start Function Logic */
+    block->size |= MEM_BLOCK_FREE;
+    merged       = (block->size & MEM_BLOCK_PREV_FREE) ? MEM_prevPhysBlock(block) : block;
+
+    ret = MEM_mergeBlocks(allocator, block);
+    if (ret != 0u)
+    {
+        goto end_of_function;
+    }
+
+    /* Only the freed bytes: neighbours big enough were trimmed when they were freed */
+    if (allocator->trim_threshold != 0u && MEM_BLOCK_SIZE(merged) >= allocator->trim_threshold)
+    {
+        if (first < (uintptr_t)merged + sizeof(block_header_t) + sizeof(free_node_t))
+        {
+            first = (uintptr_t)merged + sizeof(block_header_t) + sizeof(free_node_t);
+        }
+
+        (void)MEM_trimRange(first, last);
+    }
+
+    /* Only a block closing its segment can be a whole chunk */
+    if (allocator->chunk_count != 0u && MEM_nextPhysBlock(merged) == NULL)
+    {
+        (void)MEM_heapShrink(allocator, allocator->release_threshold);
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_fastbinIndex
+ * @package MEM_alloc
+ * 
+ * @brief   Maps a payload size to its fast bin.
+ *
+ * @param   [in] payload Aligned payload size in bytes.
+ *
+ * @return  Bin index, or MEM_FASTBINS when the size is not deferred.
+ */
+static size_t MEM_fastbinIndex(size_t payload)
+{
+    /* Function Return */
+    return (payload <= MEM_FASTBIN_MAX_SIZE) ? (payload / ARCH_ALIGNMENT) - 1u : MEM_FASTBINS;
+}
+
+/**
+ * @fn      MEM_fastbinHolds
+ * @package MEM_alloc
+ * 
+ * @brief   Tells whether a block is deferred in one of the fast bins.
+ *
+ * @details A deferred block is still marked allocated, so MEM_validPointerCheck accepts it.
+ *          Only a block whose MEM_FREE_LINKS()->prev_free carries the bins' tag is looked up
+ *          in its bin, which tells it from payload data that happens to match.
+ *
+ * @param   [in] allocator Pointer to the memory allocator structure.
+ * @param   [in] block     Pointer to a validated, allocated block header.
+ *
+ * @return  Non-zero when the block is linked in its fast bin.
+ */
+static int MEM_fastbinHolds(const mem_allocator_t *allocator, block_header_t *block)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0;
+
+    size_t bin              = 0u;
+    block_header_t *binned  = NULL;
+
+    /* Check deference/argument boundaries */
+    if ((const void *)MEM_FREE_LINKS(block)->prev_free != (const void *)allocator->fastbins)
+    {
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    bin = MEM_fastbinIndex(MEM_BLOCK_SIZE(block) - sizeof(block_header_t));
+
+    if (bin >= MEM_FASTBINS)
+    {
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    for (binned = allocator->fastbins[bin]; binned != NULL; binned = MEM_FREE_LINKS(binned)->next_free)
+    {
+        if (binned == block)
+        {
+            ret = 1;
+            break;
+        }
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_fastbinPut
+ * @package MEM_alloc
+ * 
+ * @brief   Defers the coalescing of a freed block by pushing it on its fast bin.
+ *
+ * @details The block stays marked allocated, so neither its neighbours' merges nor the
+ *          strategies see it. Its MEM_FREE_LINKS()->prev_free is tagged with the bins'
+ *          address; a tagged block is looked up in its bin to tell a double free from payload
+ *          data that happens to match. The caller holds the heap lock.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Pointer to a validated, allocated block header.
+ *
+ * @return  0 when the block was deferred, EINVAL on a double free, EAGAIN when the caller must
+ *          coalesce it now.
+ */
+static int MEM_fastbinPut(mem_allocator_t *allocator, block_header_t *block)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    size_t bin              = 0u;
+    free_links_t *links     = NULL;
+    block_header_t *marker  = NULL;
+
+    /* Check deference/argument boundaries */
+    if (!allocator->deferred_coalescing)
+    {
+        ret = EAGAIN;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    links   = MEM_FREE_LINKS(block);
+    marker  = (block_header_t *)(void *)allocator->fastbins;
+    bin     = MEM_fastbinIndex(MEM_BLOCK_SIZE(block) - sizeof(block_header_t));
+
+    if (bin >= MEM_FASTBINS)
+    {
+        ret = EAGAIN;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    if (MEM_fastbinHolds(allocator, block))
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    links->next_free            = allocator->fastbins[bin];
+    links->prev_free            = marker;
+
+    allocator->fastbins[bin]    = block;
+    allocator->fastbin_count++;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_fastbinGet
+ * @package MEM_alloc
+ * 
+ * @brief   Pops a deferred block of exactly the requested payload size.
+ *
+ * @param   [in/out] allocator    Pointer to the memory allocator structure.
+ * @param   [in]     aligned_size Aligned payload size to allocate.
+ *
+ * @return  Pointer to an allocated block header, or NULL when the bin is empty.
+ */
+static block_header_t *MEM_fastbinGet(mem_allocator_t *allocator, size_t aligned_size)
+{
+    /* Definition of Function Variables */
+    size_t bin              = 0u;
+    block_header_t *block   = NULL;
+
+    /* Assigning Initial Values for Variables */
+    bin = MEM_fastbinIndex(aligned_size);
+
+    /* Start Function Logic */
+    if (bin >= MEM_FASTBINS || allocator->fastbins[bin] == NULL)
+    {
+        goto end_of_function;
+    }
+
+    block                               = allocator->fastbins[bin];
+    allocator->fastbins[bin]            = MEM_FREE_LINKS(block)->next_free;
+    allocator->fastbin_count--;
+
+    MEM_FREE_LINKS(block)->prev_free    = NULL;
+
+    /* Function Return */
+end_of_function:
+    return block;
+}
+
+/**
+ * @fn      MEM_fastbinConsolidate
+ * @package MEM_alloc
+ * 
+ * @brief   Coalesces deferred blocks back into the heap.
+ *
+ * @details Takes the bins in turn from where the previous call stopped, so bounded calls
+ *          spread their work over every size. The caller holds the heap lock.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     budget    Maximum number of blocks to coalesce, SIZE_MAX for all.
+ */
+static void MEM_fastbinConsolidate(mem_allocator_t *allocator, size_t budget)
+{
+    /* Definition of Function Variables */
+    size_t bin              = 0u;
+    block_header_t *block   = NULL;
+
+    /* Assigning Initial Values for Variables */
+    bin = allocator->fastbin_cursor;
+
+    /* Start Function Logic */
+    while (budget != 0u && allocator->fastbin_count != 0u)
+    {
+        block = allocator->fastbins[bin];
+        if (block == NULL)
+        {
+            bin = (bin + 1u) % MEM_FASTBINS;
+            continue;
+        }
+
+        allocator->fastbins[bin]            = MEM_FREE_LINKS(block)->next_free;
+        allocator->fastbin_count--;
+        budget--;
+
+        /* A block merged into its predecessor keeps its links, the tag must not outlive it */
+        MEM_FREE_LINKS(block)->prev_free    = NULL;
+
+        if (MEM_coalesceBlock(allocator, block) != 0u)
+        {
+            MEM_LOG_ERROR("MEM_fastbinConsolidate: Failed to merge blocks at %p\n", (void *)block);
+        }
+    }
+
+    allocator->fastbin_cursor = bin;
+}
+
+/**
+ * @fn      MEM_findBlock
+ * @package MEM_alloc
+ * 
+ * @brief   Runs the finder of an allocation strategy.
+ *
+ * @details Always inlined, so a caller passing a constant strategy calls its finder directly
+ *          and the unknown-strategy branch is compiled out.
+ *
+ * @param   [in/out] allocator    Pointer to the memory allocator structure.
+ * @param   [in]     aligned_size Aligned payload size to allocate.
+ * @param   [in]     strategy     Allocation strategy to use.
+ * @param   [out]    block        Output parameter to store the found free block.
+ *
+ * @return  0 on success, ENOMEM when no block fits, EINVAL for an unknown strategy.
+ */
+static inline __attribute__((always_inline)) int MEM_findBlock(mem_allocator_t *allocator, size_t aligned_size, allocation_strategy_t strategy, block_header_t **block)
+{
+    /* Definition of Function Variables */
+    int ret = 0u;
+
+    /* Start Function Logic */
+    switch (strategy) 
+    {
+        case FIRST_FIT:
+            ret = MEM_findFirstFit(allocator, aligned_size, block);
+            break;
+        case NEXT_FIT:
+            ret = MEM_findNextFit(allocator, aligned_size, block);
+            break;
+        case BEST_FIT:
+            ret = MEM_findBestFit(allocator, aligned_size, block);
+            break;
+        case SEGREGATED_FIT:
+            ret = MEM_findSegregatedFit(allocator, aligned_size, block);
+            break;
+        case TLSF_FIT:
+            ret = MEM_findTlsfFit(allocator, aligned_size, block);
+            break;
+        default:
+            MEM_LOG_ERROR("MEM_allocatorMalloc: Unknown allocation strategy.\n");
+            ret = EINVAL;
+            break;
+    }
+
+    /* Function Return */
+    return ret;
+}
+
+/**
+ * @fn      MEM_heapFind
+ * @package MEM_alloc
+ * 
+ * @brief   Finds a free block, coalescing the fast bins and then growing the heap when
+ *          nothing fits.
+ *
+ * @param   [in/out] allocator    Pointer to the memory allocator structure.
+ * @param   [in]     aligned_size Aligned payload size to allocate.
+ * @param   [in]     strategy     Allocation strategy to use.
+ * @param   [out]    block        Output parameter to store the found free block.
+ *
+ * @return  0 on success, ENOMEM when no block fits, EINVAL for an unknown strategy.
+ */
+static inline __attribute__((always_inline)) int MEM_heapFind(mem_allocator_t *allocator, size_t aligned_size, allocation_strategy_t strategy, block_header_t **block)
+{
+    /* Definition of Function Variables */
+    int ret = 0u;
+
+    /* Start Function Logic */
+    ret = MEM_findBlock(allocator, aligned_size, strategy, block);
+
+    if (ret == ENOMEM && allocator->fastbin_count != 0u)
+    {
+        MEM_fastbinConsolidate(allocator, SIZE_MAX);
+        ret = MEM_findBlock(allocator, aligned_size, strategy, block);
+    }
+
+    if (ret == ENOMEM && MEM_heapGrow(allocator, aligned_size) == 0u)
+    {
+        ret = MEM_findBlock(allocator, aligned_size, strategy, block);
+    }
+
+    /* Function Return */
+    return ret;
+}
+
+/**
+ * @fn      MEM_heapMalloc
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates a block from the shared heap.
+ *
+ * @details Pops a deferred block of the same size when the fast bins have one. Otherwise runs
+ *          the selected strategy, grows the heap and retries once when nothing fits, and
+ *          splits the found block. Records the allocation source. The caller holds the heap
+ *          lock in thread-safe mode. Always inlined, like MEM_findBlock, so each specialized
+ *          entry point gets its own copy with the strategy folded in.
+ *
+ * @param   [in/out] allocator    Pointer to the memory allocator structure.
+ * @param   [in]     size         Size requested by the caller.
+ * @param   [in]     aligned_size Aligned payload size to allocate.
+ * @param   [in]     file         Name of the file requesting the allocation.
+ * @param   [in]     line         Line number in the file requesting the allocation.
+ * @param   [in]     var_name     Name of the variable being allocated.
+ * @param   [in]     strategy     Allocation strategy to use.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+static inline __attribute__((always_inline)) void *MEM_heapMalloc(mem_allocator_t *allocator, size_t size, size_t aligned_size, const char *file, int line, const char *var_name, allocation_strategy_t strategy)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    void *user_ptr          = NULL;
+    block_header_t *block   = NULL;
+
+    /* Start Function Logic */
+    if (allocator->fastbin_count != 0u)
+    {
+        block = MEM_fastbinGet(allocator, aligned_size);
+        if (block)
+        {
+            goto record_allocation;
+        }
+    }
+
+    ret = MEM_heapFind(allocator, aligned_size, strategy, &block);
+
+    if (ret == EINVAL)
+    {
+        errno = EINVAL;
+        goto end_of_function;
+    }
+
+    if (ret != 0 || block == NULL) 
+    {
+        allocator->stats.failed_allocations++;
+
+        MEM_LOG_ERROR("MEM_allocatorMalloc: No sufficient free block to allocate %zu bytes for variable '%s' (in %s:%d)\n", 
+                size, var_name, file, line);
+
+        errno       = ENOMEM;
+        user_ptr    = NULL;
+
+        goto end_of_function;
+    }
+
+    ret = MEM_splitBlock(allocator, block, aligned_size);
+    if (ret != 0u) 
+    {
+        MEM_LOG_ERROR("MEM_allocatorMalloc: Failed to split block for variable '%s' (in %s:%d)\n", 
+                var_name, file, line);
+
+        errno       = EINVAL;
+        user_ptr    = NULL;
+
+        goto end_of_function;
+    }
+
+record_allocation:
+    user_ptr = (void *)((uint8_t *)block + sizeof(block_header_t));
+
+#if defined(_DEBUG_)
+    MEM_debugRecord(block, file, line, var_name, size);
+#endif
+
+    MEM_profileRecord(block, file, line, size);
+
+    MEM_statsAllocated(allocator, strategy, 1u);
+
+    MEM_traceRecord(MEM_TRACE_MALLOC, block, MEM_BLOCK_SIZE(block), (uint32_t)strategy);
+    MEM_LOG_DEBUG("MEM_allocatorMalloc: Allocated %zu bytes for variable '%s' at %p (in %s:%d) using strategy %d.\n", 
+               size, var_name, user_ptr, file, line, strategy);
+
+    /* Function Return */
+end_of_function:
+    return user_ptr;
+}
+
+/**
+ * @fn      MEM_tcacheBinIndex
+ * @package MEM_alloc
+ * 
+ * @brief   Maps a payload size to its thread cache bin.
+ *
+ * @param   [in] payload Aligned payload size in bytes.
+ *
+ * @return  Bin index, or MEM_TCACHE_BINS when the size is not cached.
+ */
+static size_t MEM_tcacheBinIndex(size_t payload)
+{
+    /* Function Return */
+    return (payload <= MEM_TCACHE_MAX_SIZE) ? (payload / ARCH_ALIGNMENT) - 1u : MEM_TCACHE_BINS;
+}
+
+/**
+ * @fn      MEM_tcacheDestroy
+ * @package MEM_alloc
+ * 
+ * @brief   Thread-specific data destructor flushing the exiting thread's cache.
+ *
+ * @param   [in] arg Value bound to tcache_key (unused).
+ */
+static void MEM_tcacheDestroy(void *arg)
+{
+    /* Start Function Logic */
+    (void)arg;
+    (void)MEM_tcacheFlush();
+}
+
+/**
+ * @fn      MEM_tcacheCreateKey
+ * @package MEM_alloc
+ * 
+ * @brief   Creates tcache_key, once per process.
+ */
+static void MEM_tcacheCreateKey(void)
+{
+    /* Start Function Logic */
+    (void)pthread_key_create(&tcache_key, MEM_tcacheDestroy);
+}
+
+/**
+ * @fn      MEM_tcacheBind
+ * @package MEM_alloc
+ * 
+ * @brief   Checks whether the calling thread's cache may serve an allocator.
+ *
+ * @details An unbound cache is bound to the allocator and registered for the flush at
+ *          thread exit. A cache bound to another allocator is left alone and the caller
+ *          takes the locked path.
+ *
+ * @param   [in] allocator Pointer to a thread-safe memory allocator.
+ *
+ * @return  Non-zero when the cache belongs to the allocator.
+ */
+static int MEM_tcacheBind(mem_allocator_t *allocator)
+{
+    /* Start Function Logic */
+    if (tcache.owner == NULL)
+    {
+        (void)pthread_once(&tcache_key_once, MEM_tcacheCreateKey);
+        (void)pthread_setspecific(tcache_key, &tcache);
+
+        tcache.owner = allocator;
+    }
+
+    /* Function Return */
+    return tcache.owner == allocator;
+}
+
+/**
+ * @fn      MEM_tcacheGet
+ * @package MEM_alloc
+ * 
+ * @brief   Pops a cached block of the calling thread.
+ *
+ * @details Plain thread-local loads and stores only: no lock, no atomics.
+ *
+ * @param   [in] aligned_size Aligned payload size requested.
+ *
+ * @return  Pointer to the block, or NULL when the size is not cached or its bin is empty.
+ */
+static block_header_t *MEM_tcacheGet(size_t aligned_size)
+{
+    /* Definition of Function Variables */
+    size_t bin              = 0u;
+    block_header_t *block   = NULL;
+
+    /* Assigning Initial Values for Variables */
+    bin = MEM_tcacheBinIndex(aligned_size);
+
+    /* Start Function Logic */
+    if (bin >= MEM_TCACHE_BINS)
+    {
+        goto end_of_function;
+    }
+
+    block = tcache.bins[bin];
+    if (block == NULL)
+    {
+        tcache.stats.misses++;
+        goto end_of_function;
+    }
+
+    tcache.bins[bin]                    = MEM_FREE_LINKS(block)->next_free;
+    tcache.counts[bin]--;
+    tcache.stats.hits++;
+
+    MEM_FREE_LINKS(block)->prev_free    = NULL;
+
+    /* Function Return */
+end_of_function:
+    return block;
+}
+
+/**
+ * @fn      MEM_tcacheHolds
+ * @package MEM_alloc
+ * 
+ * @brief   Tells whether a block sits in the calling thread's cache.
+ *
+ * @details A cached block is still marked allocated, so MEM_validPointerCheck accepts it. Its
+ *          MEM_FREE_LINKS()->prev_free is tagged with the cache's address, and only a tagged
+ *          block is looked up in its bin, which tells it from payload data that happens to
+ *          match.
+ *
+ * @param   [in] block Pointer to a validated, allocated block header.
+ *
+ * @return  Non-zero when the block is linked in one of the calling thread's bins.
+ */
+static int MEM_tcacheHolds(block_header_t *block)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0;
+
+    size_t bin              = 0u;
+    block_header_t *cached  = NULL;
+
+    /* Check deference/argument boundaries */
+    if ((void *)MEM_FREE_LINKS(block)->prev_free != (void *)&tcache)
+    {
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    bin = MEM_tcacheBinIndex(MEM_BLOCK_SIZE(block) - sizeof(block_header_t));
+
+    if (bin >= MEM_TCACHE_BINS)
+    {
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    for (cached = tcache.bins[bin]; cached != NULL; cached = MEM_FREE_LINKS(cached)->next_free)
+    {
+        if (cached == block)
+        {
+            ret = 1;
+            break;
+        }
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_heapFree
+ * @package MEM_alloc
+ * 
+ * @brief   Returns a block to the shared heap.
+ *
+ * @details Validates the pointer, clears its metadata and either defers the block on a fast
+ *          bin or coalesces it with MEM_coalesceBlock. Frees past MEM_FASTBIN_LIMIT deferred
+ *          blocks coalesce MEM_FASTBIN_STEP of them. The caller holds the heap lock in
+ *          thread-safe mode.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     ptr       Pointer to the memory to free.
+ * @param   [in]     file      Name of the file requesting the free operation.
+ * @param   [in]     line      Line number in the file requesting the free operation.
+ * @param   [in]     var_name  Name of the variable being freed.
+ *
+ * @return  0 on success, error code on failure.
+ */
+static int MEM_heapFree(mem_allocator_t *allocator, void *ptr, const char *file, int line, const char *var_name)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+    int deferred            = 0u;
+
+    block_header_t *block   = NULL;
+    
+    /* Start Function Logic */
+    ret = MEM_validPointerCheck(allocator, ptr);
+    if (ret != 0u) 
+    {
+        MEM_LOG_ERROR("MEM_allocatorFree: Invalid pointer %p for variable '%s' (in %s:%d)\n", ptr, var_name, file, line);
+        goto end_of_function;
+    }
+
+    block = (block_header_t *)((uint8_t *)ptr - sizeof(block_header_t));
+
+    if (MEM_BLOCK_IS_FREE(block)) 
+    {
+        MEM_LOG_ERROR("MEM_allocatorFree: Double free detected for %p (variable '%s') (in %s:%d)\n", ptr, var_name, file, line);
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    ret = MEM_fastbinPut(allocator, block);
+    if (ret == EINVAL)
+    {
+        MEM_LOG_ERROR("MEM_allocatorFree: Double free detected for %p (variable '%s') (in %s:%d)\n", ptr, var_name, file, line);
+        goto end_of_function;
+    }
+
+    deferred = (ret == 0u);
+
+    allocator->stats.frees++;
+
+#if defined(_DEBUG_)
+    MEM_debugForget(block);
+#endif
+
+    MEM_profileForget(block);
+
+    MEM_traceRecord(MEM_TRACE_FREE, block, MEM_BLOCK_SIZE(block), 0u);
+    MEM_LOG_DEBUG("MEM_allocatorFree: Freed %zu bytes for variable '%s' from %p (in %s:%d)\n", 
+               MEM_BLOCK_SIZE(block) - sizeof(block_header_t), 
+               var_name ? var_name : "N/A", 
+               ptr, file, line);
+
+    if (deferred)
+    {
+        ret = 0u;
+
+        if (allocator->fastbin_count > MEM_FASTBIN_LIMIT)
+        {
+            MEM_fastbinConsolidate(allocator, MEM_FASTBIN_STEP);
+        }
+
+        goto end_of_function;
+    }
+
+    ret = MEM_coalesceBlock(allocator, block);
+    if (ret != 0u) 
+    {
+        MEM_LOG_ERROR("MEM_allocatorFree: Failed to merge blocks (in %s:%d)\n", file, line);
+        goto end_of_function;
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_remotePush
+ * @package MEM_alloc
+ * 
+ * @brief   Queues a block freed by another thread on its allocator's remote-free list.
+ *
+ * @details Lock-free, any number of threads may push at once. A compare-and-swap tags the
+ *          block's MEM_FREE_LINKS()->prev_free with the list head's address, which also rejects
+ *          a second free of a queued block, and another one on the head links it in through
+ *          next_free. Only the payload is written: the header stays as the heap expects it from
+ *          an allocated block until MEM_remoteDrain frees it.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Pointer to a validated, allocated block header.
+ *
+ * @return  0 when the block was queued, EINVAL on a double free.
+ */
+static int MEM_remotePush(mem_allocator_t *allocator, block_header_t *block)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    free_links_t *links     = NULL;
+    block_header_t *marker  = NULL;
+    block_header_t *seen    = NULL;
+    block_header_t *head    = NULL;
+
+    /* Assigning Initial Values for Variables */
+    links   = MEM_FREE_LINKS(block);
+    marker  = (block_header_t *)(void *)&allocator->remote_free;
+    seen    = __atomic_load_n(&links->prev_free, __ATOMIC_RELAXED);
+
+    /* Start Function Logic */
+    do
+    {
+        if (seen == marker)
+        {
+            ret = EINVAL;
+            goto end_of_function;
+        }
+    } while (!__atomic_compare_exchange_n(&links->prev_free, &seen, marker, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    head = __atomic_load_n(&allocator->remote_free, __ATOMIC_RELAXED);
+
+    do
+    {
+        links->next_free = head;
+    } while (!__atomic_compare_exchange_n(&allocator->remote_free, &head, block, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_remoteDrain
+ * @package MEM_alloc
+ * 
+ * @brief   Frees every block queued on the remote-free list in one batch.
+ *
+ * @details The whole list is detached with one atomic exchange, so pushers never wait on the
+ *          drain and the heap lock is taken once per batch instead of once per free. An empty
+ *          list costs a single relaxed load. The caller holds the heap lock.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ */
+static void MEM_remoteDrain(mem_allocator_t *allocator)
+{
+    /* Definition of Function Variables */
+    block_header_t *block   = NULL;
+    block_header_t *next    = NULL;
+
+    /* Check deference/argument boundaries */
+    if (__atomic_load_n(&allocator->remote_free, __ATOMIC_RELAXED) == NULL)
+    {
+        return;
+    }
+
+    /* Start Function Logic */
+    block = __atomic_exchange_n(&allocator->remote_free, NULL, __ATOMIC_ACQUIRE);
+
+    while (block != NULL)
+    {
+        next = MEM_FREE_LINKS(block)->next_free;
+
+        /* A block merged into its predecessor keeps its links, the tag must not outlive it */
+        MEM_FREE_LINKS(block)->prev_free = NULL;
+
+        if (MEM_heapFree(allocator, (uint8_t *)block + sizeof(block_header_t), __FILE__, __LINE__, "remote_free") == 0u)
+        {
+            allocator->stats.remote_frees++;
+        }
+
+        block = next;
+    }
+}
+
+/**
+ * @fn      MEM_allocatorDestroy
+ * @package MEM_alloc
+ * 
+ * @brief   Tears an allocator down.
+ *
+ * @details Must not race with any other use of the allocator. Blocks cached by other threads
+ *          must have been flushed beforehand; blocks they queued on the remote-free list are
+ *          freed here, before the heap goes away.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorDestroy(mem_allocator_t *allocator)
+{
+    /* Definition of Function Variables */
+    int ret         = 0u;
+    size_t index    = 0u;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || allocator->heap == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    if (tcache.owner == allocator)
+    {
+        ret = MEM_tcacheFlush();
+    }
+
+    MEM_lockHeap(allocator);
+    MEM_remoteDrain(allocator);
+    MEM_unlockHeap(allocator);
+
+#if defined(_DEBUG_)
+    MEM_debugForgetRange(allocator->heap, allocator->heap + allocator->heap_size);
+#endif
+
+    MEM_profileForgetRange(allocator->heap, allocator->heap + allocator->heap_size);
+
+    for (index = 0u; index < allocator->chunk_count; ++index)
+    {
+        if (allocator->chunks[index].start == NULL)
+        {
+            continue;
+        }
+
+#if defined(_DEBUG_)
+        MEM_debugForgetRange(allocator->chunks[index].start, allocator->chunks[index].end);
+#endif
+
+        MEM_profileForgetRange(allocator->chunks[index].start, allocator->chunks[index].end);
+
+        if (allocator->provider.release)
+        {
+            allocator->provider.release(allocator->chunks[index].base, allocator->chunks[index].length, allocator->provider.context);
+        }
+    }
+
+    memset(allocator->chunks, 0, sizeof(allocator->chunks));
+    allocator->chunk_count = 0u;
+
+    if (allocator->mapped_size != 0u)
+    {
+        munmap(allocator->heap, allocator->mapped_size);
+    }
+
+    pthread_mutex_destroy(&allocator->lock);
+
+    allocator->heap             = NULL;
+    allocator->heap_size        = 0u;
+    allocator->mapped_size      = 0u;
+    allocator->last_allocated   = NULL;
+    allocator->thread_safe      = 0;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_mallocInline
+ * @package MEM_alloc
+ * 
+ * @brief   Body shared by MEM_allocatorMalloc and its specialized entry points.
+ *
+ * @details Aligns the size, serves it from the calling thread's cache in thread-safe mode, and
+ *          otherwise runs MEM_heapMalloc under the allocator lock. Always inlined, together
+ *          with MEM_heapMalloc, MEM_heapFind and MEM_findBlock, so a constant strategy reaches
+ *          the finder as a direct call. Holds the argument checks of every entry point, so the
+ *          size bound lives in one place.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variable being allocated.
+ * @param   [in]     strategy  Allocation strategy to use.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+static inline __attribute__((always_inline)) void *MEM_mallocInline(mem_allocator_t *allocator, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy)
+{
+    /* Definition of Function Variables */
+    size_t aligned_size     = 0u;
+
+    void *user_ptr          = NULL;
+    block_header_t *block   = NULL;
+
+    /* Check deference/argument boundaries */
+    if (__builtin_expect(allocator == NULL || size == 0u, 0))
+    {
+        errno = EINVAL;
+        goto end_of_function;
+    }
+
+    if (__builtin_expect(size > SIZE_MAX - ARCH_ALIGNMENT - sizeof(block_header_t), 0))
+    {
+        errno = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    aligned_size = ALIGN(size);
+
+    if (aligned_size < MEM_MIN_PAYLOAD_SIZE)
+    {
+        aligned_size = MEM_MIN_PAYLOAD_SIZE;
+    }
+
+    /* Start Function Logic */
+    if (allocator->thread_safe && MEM_tcacheBind(allocator))
+    {
+        block = MEM_tcacheGet(aligned_size);
+        if (block)
+        {
+            user_ptr = (void *)((uint8_t *)block + sizeof(block_header_t));
+
+#if defined(_DEBUG_)
+            MEM_debugRecord(block, file, line, var_name, size);
+#endif
+
+            MEM_profileRecord(block, file, line, size);
+
+            goto end_of_function;
+        }
+    }
+
+    MEM_lockHeap(allocator);
+    MEM_remoteDrain(allocator);
+    user_ptr = MEM_heapMalloc(allocator, size, aligned_size, file, line, var_name, strategy);
+    MEM_unlockHeap(allocator);
+
+    /* Function Return */
+end_of_function:
+    if (user_ptr != NULL)
+    {
+        MEM_recordOp(MEM_RECORD_MALLOC, user_ptr, size, file, line);
+    }
+
+    return user_ptr;
+}
+
+/**
+ * @fn      MEM_allocatorMalloc
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory using the custom allocator.
+ *
+ * @details Allocates a block of memory of the specified size from the allocator's heap. It aligns the size,
+ *          selects the allocation strategy, finds the appropriate-fit block, splits it if necessary,
+ *          and updates the block's metadata with the allocation source information. In thread-safe
+ *          mode small requests are first served from the calling thread's cache, regardless of the
+ *          strategy, and everything else runs under the allocator lock.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variable being allocated.
+ * @param   [in]     strategy  Allocation strategy to use (FIRST_FIT, NEXT_FIT, BEST_FIT, SEGREGATED_FIT, TLSF_FIT).
+ *
+ * @return Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMalloc(mem_allocator_t *allocator, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy) 
+{
+    /* Function Return */
+    return MEM_mallocInline(allocator, size, file, line, var_name, strategy);
+}
+
+/**
+ * @fn      MEM_allocatorMallocFirstFit
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory with the First-Fit strategy, without call-site tracking.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMallocFirstFit(mem_allocator_t *allocator, size_t size)
+{
+    /* Function Return */
+    return MEM_mallocInline(allocator, size, MEM_UNTRACKED, 0, MEM_UNTRACKED, FIRST_FIT);
+}
+
+/**
+ * @fn      MEM_allocatorMallocNextFit
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory with the Next-Fit strategy, without call-site tracking.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMallocNextFit(mem_allocator_t *allocator, size_t size)
+{
+    /* Function Return */
+    return MEM_mallocInline(allocator, size, MEM_UNTRACKED, 0, MEM_UNTRACKED, NEXT_FIT);
+}
+
+/**
+ * @fn      MEM_allocatorMallocBestFit
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory with the Best-Fit strategy, without call-site tracking.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMallocBestFit(mem_allocator_t *allocator, size_t size)
+{
+    /* Function Return */
+    return MEM_mallocInline(allocator, size, MEM_UNTRACKED, 0, MEM_UNTRACKED, BEST_FIT);
+}
+
+/**
+ * @fn      MEM_allocatorMallocSegregatedFit
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory with the Segregated-Fit strategy, without call-site tracking.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMallocSegregatedFit(mem_allocator_t *allocator, size_t size)
+{
+    /* Function Return */
+    return MEM_mallocInline(allocator, size, MEM_UNTRACKED, 0, MEM_UNTRACKED, SEGREGATED_FIT);
+}
+
+/**
+ * @fn      MEM_allocatorMallocTlsfFit
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory with the TLSF-Fit strategy, without call-site tracking.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMallocTlsfFit(mem_allocator_t *allocator, size_t size)
+{
+    /* Function Return */
+    return MEM_mallocInline(allocator, size, MEM_UNTRACKED, 0, MEM_UNTRACKED, TLSF_FIT);
+}
+
+/**
+ * @fn      MEM_allocatorCalloc
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates zero-initialized memory for an array using the custom allocator.
+ *
+ * @details Checks nmemb * size for overflow, allocates through MEM_allocatorMalloc and clears
+ *          the requested bytes.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     nmemb     Number of elements.
+ * @param   [in]     size      Size of each element.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variable being allocated.
+ * @param   [in]     strategy  Allocation strategy to use.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorCalloc(mem_allocator_t *allocator, size_t nmemb, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy)
+{
+    /* Definition of Function Variables */
+    void *user_ptr  = NULL;
+    size_t total    = 0u;
+
+    /* Check deference/argument boundaries */
+    if (__builtin_mul_overflow(nmemb, size, &total))
+    {
+        errno = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    user_ptr = MEM_allocatorMalloc(allocator, total, file, line, var_name, strategy);
+    if (user_ptr)
+    {
+        memset(user_ptr, 0, total);
+    }
+
+    /* Function Return */
+end_of_function:
+    return user_ptr;
+}
+
+/**
+ * @fn      MEM_splitLeading
+ * @package MEM_alloc
+ * 
+ * @brief   Splits the leading slack off a free block, which stays free.
+ *
+ * @details The returned block starts slack bytes into the free block and is not linked in any
+ *          free list; it must be handed to MEM_splitBlock. slack must be 0 or at least
+ *          sizeof(block_header_t) + MEM_MIN_PAYLOAD_SIZE.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Pointer to a free block linked in its free list.
+ * @param   [in]     slack     Bytes to keep free in front of the returned block.
+ *
+ * @return  Pointer to the block starting slack bytes into block.
+ */
+static block_header_t *MEM_splitLeading(mem_allocator_t *allocator, block_header_t *block, size_t slack)
+{
+    /* Definition of Function Variables */
+    block_header_t *aligned_block = NULL;
+
+    /* Assigning Initial Values for Variables */
+    aligned_block = block;
+
+    /* Check deference/argument boundaries */
+    if (slack == 0u)
+    {
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    MEM_freeListRemove(allocator, block);
+
+    aligned_block       = (block_header_t *)((uint8_t *)block + slack);
+    aligned_block->size = MEM_BLOCK_SIZE(block) - slack;
+
+    block->size         = slack | (block->size & MEM_BLOCK_FLAGS);
+
+    /* The slack keeps the free predecessor of the new block, so nothing merges here */
+    MEM_markFree(block);
+    MEM_freeListInsert(allocator, block);
+
+    allocator->stats.splits++;
+
+    MEM_traceRecord(MEM_TRACE_SPLIT, block, MEM_BLOCK_SIZE(block), 0u);
+
+    /* Function Return */
+end_of_function:
+    return aligned_block;
+}
+
+/**
+ * @fn      MEM_alignmentSlack
+ * @package MEM_alloc
+ * 
+ * @brief   Bytes to skip in a free block so that its payload lands on an alignment boundary.
+ *
+ * @details A non-zero slack is raised by whole alignment steps until it can hold a free block.
+ *
+ * @param   [in] block     Pointer to the free block.
+ * @param   [in] alignment Power-of-two alignment, larger than ARCH_ALIGNMENT.
+ *
+ * @return  Slack in bytes.
+ */
+static size_t MEM_alignmentSlack(const block_header_t *block, size_t alignment)
+{
+    /* Definition of Function Variables */
+    size_t slack        = 0u;
+    uintptr_t payload   = 0u;
+
+    /* Assigning Initial Values for Variables */
+    payload = (uintptr_t)block + sizeof(block_header_t);
+    slack   = (size_t)((alignment - (payload & (alignment - 1u))) & (alignment - 1u));
+
+    /* Start Function Logic */
+    while (slack != 0u && slack < sizeof(block_header_t) + MEM_MIN_PAYLOAD_SIZE)
+    {
+        slack += alignment;
+    }
+
+    /* Function Return */
+    return slack;
+}
+
+/**
+ * @fn      MEM_allocatorMemalign
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory whose address is a multiple of alignment.
+ *
+ * @details Looks for a block with room for the payload plus the worst-case slack, splits the
+ *          leading slack off as a free block and the unused tail with MEM_splitBlock. The
+ *          result is an ordinary block for MEM_allocatorFree and MEM_validPointerCheck.
+ *          Alignments up to ARCH_ALIGNMENT are served by MEM_allocatorMalloc.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     alignment Required alignment, a power of two.
+ * @param   [in]     size      Size of memory to allocate.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variable being allocated.
+ * @param   [in]     strategy  Allocation strategy to use.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMemalign(mem_allocator_t *allocator, size_t alignment, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    size_t aligned_size     = 0u;
+    size_t search_size      = 0u;
+
+    void *user_ptr          = NULL;
+    block_header_t *block   = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || size == 0u || alignment == 0u || (alignment & (alignment - 1u)) != 0u)
+    {
+        errno = EINVAL;
+        goto end_of_function;
+    }
+
+    if (alignment <= ARCH_ALIGNMENT)
+    {
+        user_ptr = MEM_allocatorMalloc(allocator, size, file, line, var_name, strategy);
+        goto end_of_function;
+    }
+
+    if (size > SIZE_MAX - (2u * alignment) - (2u * sizeof(block_header_t)) - MEM_MIN_PAYLOAD_SIZE)
+    {
+        errno = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    aligned_size = ALIGN(size);
+
+    if (aligned_size < MEM_MIN_PAYLOAD_SIZE)
+    {
+        aligned_size = MEM_MIN_PAYLOAD_SIZE;
+    }
+
+    search_size = aligned_size + alignment + sizeof(block_header_t) + MEM_MIN_PAYLOAD_SIZE;
+
+    /* Start Function Logic */
+    MEM_lockHeap(allocator);
+    MEM_remoteDrain(allocator);
+
+    ret = MEM_heapFind(allocator, search_size, strategy, &block);
+    if (ret != 0u || block == NULL)
+    {
+        if (ret != EINVAL)
+        {
+            allocator->stats.failed_allocations++;
+        }
+
+        MEM_unlockHeap(allocator);
+
+        if (ret != EINVAL)
+        {
+            MEM_LOG_ERROR("MEM_allocatorMemalign: No sufficient free block to allocate %zu bytes aligned to %zu for variable '%s' (in %s:%d)\n",
+                          size, alignment, var_name, file, line);
+        }
+
+        errno = (ret == EINVAL) ? EINVAL : ENOMEM;
+        goto end_of_function;
+    }
+
+    block = MEM_splitLeading(allocator, block, MEM_alignmentSlack(block, alignment));
+    MEM_splitBlock(allocator, block, aligned_size);
+
+    user_ptr = (void *)((uint8_t *)block + sizeof(block_header_t));
+
+#if defined(_DEBUG_)
+    MEM_debugRecord(block, file, line, var_name, size);
+#endif
+
+    MEM_profileRecord(block, file, line, size);
+
+    MEM_statsAllocated(allocator, strategy, 1u);
+
+    MEM_traceRecord(MEM_TRACE_MALLOC, block, MEM_BLOCK_SIZE(block), (uint32_t)strategy);
+    MEM_LOG_DEBUG("MEM_allocatorMemalign: Allocated %zu bytes aligned to %zu for variable '%s' at %p (in %s:%d) using strategy %d.\n",
+                  size, alignment, var_name, user_ptr, file, line, strategy);
+
+    MEM_unlockHeap(allocator);
+
+    /* Function Return */
+end_of_function:
+    return user_ptr;
+}
+
+/**
+ * @fn      MEM_allocatorMallocShared
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory for an object shared between threads, on cache lines of its own.
+ *
+ * @details The payload starts on a MEM_CACHE_LINE_SIZE boundary and its size is rounded up to
+ *          whole lines, so the next block's header starts on a fresh line and no other object
+ *          shares a line with it. Only the block's own header sits in the line before, and it
+ *          is written by allocation and free alone.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of memory to allocate.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variable being allocated.
+ * @param   [in]     strategy  Allocation strategy to use.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_allocatorMallocShared(mem_allocator_t *allocator, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy)
+{
+    /* Definition of Function Variables */
+    void *user_ptr = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || size == 0u)
+    {
+        errno = EINVAL;
+        goto end_of_function;
+    }
+
+    if (size > SIZE_MAX - MEM_CACHE_LINE_SIZE)
+    {
+        errno = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    user_ptr = MEM_allocatorMemalign(allocator, MEM_CACHE_LINE_SIZE, MEM_CACHE_LINE_ALIGN(size), file, line, var_name, strategy);
+
+    /* Function Return */
+end_of_function:
+    return user_ptr;
+}
+
+/**
+ * @fn      MEM_carveBlocks
+ * @package MEM_alloc
+ * 
+ * @brief   Cuts consecutive allocated blocks of one size out of a free block.
+ *
+ * @details The free block must hold at least count blocks of aligned_size payload. All but
+ *          the last block get their header written directly; the last one goes through
+ *          MEM_splitBlock, which returns the unused tail to the free lists.
+ *
+ * @param   [in/out] allocator    Pointer to the memory allocator structure.
+ * @param   [in/out] block        Pointer to a free block linked in its free list.
+ * @param   [in]     aligned_size Aligned payload size of each block.
+ * @param   [in]     count        Number of blocks to cut.
+ * @param   [out]    out_ptrs     Receives the count payload pointers.
+ */
+static void MEM_carveBlocks(mem_allocator_t *allocator, block_header_t *block, size_t aligned_size, size_t count, void **out_ptrs)
+{
+    /* Definition of Function Variables */
+    size_t index            = 0u;
+    size_t block_size       = 0u;
+    size_t remaining        = 0u;
+
+    /* Assigning Initial Values for Variables */
+    block_size  = aligned_size + sizeof(block_header_t);
+    remaining   = MEM_BLOCK_SIZE(block);
+
+    /* Start Function Logic */
+    MEM_freeListRemove(allocator, block);
+
+    block->size = remaining | (block->size & MEM_BLOCK_PREV_FREE);
+
+    for (index = 0u; index + 1u < count; ++index)
+    {
+        block->size         = block_size | (block->size & MEM_BLOCK_PREV_FREE);
+        out_ptrs[index]     = (uint8_t *)block + sizeof(block_header_t);
+        remaining          -= block_size;
+
+        MEM_sealBlock(allocator, block);
+
+        block               = (block_header_t *)((uint8_t *)block + block_size);
+        block->size         = remaining;
+    }
+
+    MEM_splitBlock(allocator, block, aligned_size);
+    out_ptrs[index] = (uint8_t *)block + sizeof(block_header_t);
+}
+
+/**
+ * @fn      MEM_allocatorMallocBatch
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates count blocks of the same size in one call.
+ *
+ * @details Arguments are validated and the lock is taken once. The strategy looks for a free
+ *          block able to hold the whole remaining batch and cuts it into consecutive blocks in
+ *          a single pass; when no such block exists the fast bins are coalesced first, then the
+ *          request is halved until one fits, and the heap is grown once if even a single block
+ *          does not.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     size      Size of each block.
+ * @param   [in]     count     Number of blocks to allocate.
+ * @param   [out]    out_ptrs  Receives the allocated pointers.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variables being allocated.
+ * @param   [in]     strategy  Allocation strategy to use.
+ *
+ * @return  Number of pointers stored in out_ptrs; fewer than count when the heap ran out.
+ */
+size_t MEM_allocatorMallocBatch(mem_allocator_t *allocator, size_t size, size_t count, void **out_ptrs, const char *file, int line, const char *var_name, allocation_strategy_t strategy)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+    int grown               = 0u;
+
+    size_t aligned_size     = 0u;
+    size_t block_size       = 0u;
+    size_t done             = 0u;
+    size_t batch            = 0u;
+    size_t index            = 0u;
+
+    block_header_t *block   = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || out_ptrs == NULL || size == 0u || size > SIZE_MAX / 2u)
+    {
+        errno = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    aligned_size = ALIGN(size);
+
+    if (aligned_size < MEM_MIN_PAYLOAD_SIZE)
+    {
+        aligned_size = MEM_MIN_PAYLOAD_SIZE;
+    }
+
+    block_size = aligned_size + sizeof(block_header_t);
+
+    /* Start Function Logic */
+    MEM_lockHeap(allocator);
+    MEM_remoteDrain(allocator);
+
+    while (done < count)
+    {
+        batch = count - done;
+
+        if (batch > SIZE_MAX / block_size)
+        {
+            batch = SIZE_MAX / block_size;
+        }
+
+        ret = MEM_findBlock(allocator, (batch * block_size) - sizeof(block_header_t), strategy, &block);
+
+        if (ret == ENOMEM && allocator->fastbin_count != 0u)
+        {
+            MEM_fastbinConsolidate(allocator, SIZE_MAX);
+            ret = MEM_findBlock(allocator, (batch * block_size) - sizeof(block_header_t), strategy, &block);
+        }
+
+        while (ret == ENOMEM && batch > 1u)
+        {
+            batch   = (batch + 1u) / 2u;
+            ret     = MEM_findBlock(allocator, (batch * block_size) - sizeof(block_header_t), strategy, &block);
+        }
+
+        if (ret == ENOMEM && !grown)
+        {
+            grown = 1;
+
+            batch = count - done;
+            if (batch > SIZE_MAX / block_size)
+            {
+                batch = SIZE_MAX / block_size;
+            }
+
+            if (MEM_heapGrow(allocator, (batch * block_size) - sizeof(block_header_t)) == 0u)
+            {
+                continue;
+            }
+        }
+
+        if (ret != 0u || block == NULL)
+        {
+            break;
+        }
+
+        MEM_carveBlocks(allocator, block, aligned_size, batch, &out_ptrs[done]);
+
+        for (index = done; index < done + batch; ++index)
+        {
+            block = (block_header_t *)((uint8_t *)out_ptrs[index] - sizeof(block_header_t));
+
+#if defined(_DEBUG_)
+            MEM_debugRecord(block, file, line, var_name, size);
+#endif
+
+            MEM_profileRecord(block, file, line, size);
+
+            MEM_traceRecord(MEM_TRACE_MALLOC, block, MEM_BLOCK_SIZE(block), (uint32_t)strategy);
+        }
+
+        allocator->stats.splits += batch - 1u;
+        done                    += batch;
+    }
+
+    MEM_statsAllocated(allocator, strategy, done);
+
+    if (done < count && ret != EINVAL)
+    {
+        allocator->stats.failed_allocations++;
+    }
+
+    MEM_unlockHeap(allocator);
+
+    if (ret == EINVAL)
+    {
+        errno = EINVAL;
+    }
+    else if (done < count)
+    {
+        MEM_LOG_ERROR("MEM_allocatorMallocBatch: Allocated %zu of %zu blocks of %zu bytes for variable '%s' (in %s:%d)\n",
+                      done, count, size, var_name, file, line);
+
+        errno = ENOMEM;
+    }
+
+    MEM_LOG_DEBUG("MEM_allocatorMallocBatch: Allocated %zu blocks of %zu bytes for variable '%s' (in %s:%d) using strategy %d.\n",
+                  done, size, var_name, file, line, strategy);
+
+    /* Function Return */
+end_of_function:
+    return done;
+}
+
+/**
+ * @fn      MEM_comparePointers
+ * @package MEM_alloc
+ * 
+ * @brief   qsort comparator ordering pointers by address.
+ *
+ * @param   [in] lhs Pointer to the first pointer.
+ * @param   [in] rhs Pointer to the second pointer.
+ *
+ * @return  Negative, zero or positive like memcmp.
+ */
+static int MEM_comparePointers(const void *lhs, const void *rhs)
+{
+    /* Definition of Function Variables */
+    uintptr_t left  = 0u;
+    uintptr_t right = 0u;
+
+    /* Assigning Initial Values for Variables */
+    left    = (uintptr_t)*(void * const *)lhs;
+    right   = (uintptr_t)*(void * const *)rhs;
+
+    /* Function Return */
+    return (left > right) - (left < right);
+}
+
+/**
+ * @fn      MEM_allocatorFreeBatch
+ * @package MEM_alloc
+ * 
+ * @brief   Frees count blocks in one call.
+ *
+ * @details The pointers are sorted by address, which reorders ptrs, and the lock is taken once.
+ *          Each run of physically adjacent blocks is fused into one block up front, so a run
+ *          costs a single merge and a single free list insertion. Invalid pointers and double
+ *          frees, including blocks still held by the calling thread's cache or deferred in a
+ *          fast bin, are reported and skipped.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] ptrs      Pointers to free.
+ * @param   [in]     count     Number of pointers.
+ * @param   [in]     file      Name of the file requesting the free operation.
+ * @param   [in]     line      Line number in the file requesting the free operation.
+ * @param   [in]     var_name  Name of the variables being freed.
+ *
+ * @return  0 on success, EINVAL if any pointer was rejected.
+ */
+int MEM_allocatorFreeBatch(mem_allocator_t *allocator, void **ptrs, size_t count, const char *file, int line, const char *var_name)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    size_t index            = 0u;
+
+    block_header_t *block   = NULL;
+    block_header_t *run_end = NULL;
+    block_header_t *next    = NULL;
+    block_header_t *merged  = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || (ptrs == NULL && count != 0u))
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    qsort(ptrs, count, sizeof(void *), MEM_comparePointers);
+
+    /* Start Function Logic */
+    MEM_lockHeap(allocator);
+    MEM_remoteDrain(allocator);
+
+    while (index < count)
+    {
+        /* Sorting made duplicates adjacent; the first copy may already sit inside a fused run */
+        if (index > 0u && ptrs[index] == ptrs[index - 1u])
+        {
+            MEM_LOG_ERROR("MEM_allocatorFreeBatch: Double free detected for %p (variable '%s') (in %s:%d)\n", ptrs[index], var_name, file, line);
+
+            ret = EINVAL;
+            ++index;
+            continue;
+        }
+
+        if (MEM_validPointerCheck(allocator, ptrs[index]) != 0u)
+        {
+            MEM_LOG_ERROR("MEM_allocatorFreeBatch: Invalid pointer %p for variable '%s' (in %s:%d)\n", ptrs[index], var_name, file, line);
+
+            ret = EINVAL;
+            ++index;
+            continue;
+        }
+
+        block   = (block_header_t *)((uint8_t *)ptrs[index] - sizeof(block_header_t));
+        run_end = block;
+
+        if (MEM_tcacheHolds(block) || MEM_fastbinHolds(allocator, block))
+        {
+            MEM_LOG_ERROR("MEM_allocatorFreeBatch: Double free detected for %p (variable '%s') (in %s:%d)\n", ptrs[index], var_name, file, line);
+
+            ret = EINVAL;
+            ++index;
+            continue;
+        }
+
+#if defined(_DEBUG_)
+        MEM_debugForget(block);
+#endif
+
+        MEM_profileForget(block);
+
+        MEM_traceRecord(MEM_TRACE_FREE, block, MEM_BLOCK_SIZE(block), 0u);
+
+        for (++index; index < count; ++index)
+        {
+            next = MEM_nextPhysBlock(run_end);
+            if (next == NULL || (uint8_t *)ptrs[index] != (uint8_t *)next + sizeof(block_header_t) || MEM_BLOCK_IS_FREE(next))
+            {
+                break;
+            }
+
+            /* A cached or deferred neighbour ends the run, the outer loop reports it */
+            if (MEM_tcacheHolds(next) || MEM_fastbinHolds(allocator, next))
+            {
+                break;
+            }
+
+#if defined(_DEBUG_)
+            MEM_debugForget(next);
+#endif
+
+            MEM_profileForget(next);
+
+            MEM_traceRecord(MEM_TRACE_FREE, next, MEM_BLOCK_SIZE(next), 0u);
+
+            /* Drops the cookie of the previous block of the run, the header becomes payload */
+            next->prev_size  = 0u;
+            block->size     += MEM_BLOCK_SIZE(next);
+
+            if (allocator->last_allocated == next)
+            {
+                allocator->last_allocated = block;
+            }
+
+            allocator->stats.frees++;
+            allocator->stats.merges++;
+
+            run_end = next;
+        }
+
+        /* The headers of the run carry no free flag, so the last cookie must go as well */
+        ((block_header_t *)((uint8_t *)run_end + MEM_BLOCK_SIZE(run_end)))->prev_size = 0u;
+
+        block->size |= MEM_BLOCK_FREE;
+        merged       = (block->size & MEM_BLOCK_PREV_FREE) ? MEM_prevPhysBlock(block) : block;
+
+        allocator->stats.frees++;
+
+        MEM_mergeBlocks(allocator, block);
+
+        if (allocator->chunk_count != 0u && MEM_nextPhysBlock(merged) == NULL)
+        {
+            (void)MEM_heapShrink(allocator, allocator->release_threshold);
+        }
+    }
+
+    MEM_unlockHeap(allocator);
+
+    MEM_LOG_DEBUG("MEM_allocatorFreeBatch: Freed %zu blocks for variable '%s' (in %s:%d)\n",
+                  count, var_name ? var_name : "N/A", file, line);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_allocatorGetStats
+ * @package MEM_alloc
+ * 
+ * @brief   Reads the counters of an allocator.
+ *
+ * @details Copies the incremental counters and derives the two values that are not stored:
+ *          bytes in use from the segment and free byte totals, and the largest free block from
+ *          the cached maximum of the size tree, or from the highest non-empty free list when the
+ *          tree is not built or holds no block.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [out]    stats     Receives the counters.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorGetStats(mem_allocator_t *allocator, mem_alloc_stats_t *stats)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    uint32_t fl             = 0u;
+    uint32_t sl             = 0u;
+    block_header_t *block   = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || stats == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    MEM_lockHeap(allocator);
+
+    *stats              = allocator->stats;
+    stats->bytes_in_use = allocator->heap_bytes - allocator->stats.free_bytes;
+
+    stats->largest_free_block = 0u;
+
+    if (allocator->size_tree_max)
+    {
+        stats->largest_free_block = MEM_BLOCK_SIZE(allocator->size_tree_max) - sizeof(block_header_t);
+    }
+    else if (allocator->fl_bitmap != 0u)
+    {
+        /* The highest non-empty list holds the largest block, its sizes only share a range */
+        fl = (uint32_t)(31 - __builtin_clz(allocator->fl_bitmap));
+        sl = (uint32_t)(31 - __builtin_clz(allocator->sl_bitmap[fl]));
+
+        for (block = allocator->free_lists[fl][sl]; block != NULL; block = MEM_FREE_LINKS(block)->next_free)
+        {
+            if (MEM_BLOCK_SIZE(block) - sizeof(block_header_t) > stats->largest_free_block)
+            {
+                stats->largest_free_block = MEM_BLOCK_SIZE(block) - sizeof(block_header_t);
+            }
+        }
+    }
+
+    MEM_unlockHeap(allocator);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_allocatorFragmentation
+ * @package MEM_alloc
+ * 
+ * @brief   Measures how fragmented a heap is.
+ *
+ * @details Walks every segment in physical order. Free blocks feed the totals and the
+ *          power-of-two histogram; allocated blocks feed the header count and, in debug builds,
+ *          the requested sizes recorded in the side table, which give the padding.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [out]    report    Receives the fragmentation figures.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorFragmentation(mem_allocator_t *allocator, mem_frag_report_t *report)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    block_header_t *block   = NULL;
+    uint8_t *start          = NULL;
+    uint8_t *end            = NULL;
+
+    size_t index            = 0u;
+    size_t payload          = 0u;
+    size_t bin              = 0u;
+
+#if defined(_DEBUG_)
+    debug_entry_t *entry    = NULL;
+#endif
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || report == NULL || allocator->heap == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    memset(report, 0, sizeof(mem_frag_report_t));
+
+    /* Start Function Logic */
+    MEM_lockHeap(allocator);
+
+    for (index = 0u; index <= allocator->chunk_count; ++index)
+    {
+        if (!MEM_heapSegmentAt(allocator, index, &start, &end))
+        {
+            continue;
+        }
+
+        for (block = (block_header_t *)start; block != NULL; block = MEM_nextPhysBlock(block))
+        {
+            payload = MEM_BLOCK_SIZE(block) - sizeof(block_header_t);
+
+            if (MEM_BLOCK_IS_FREE(block))
+            {
+                bin = (size_t)(63 - __builtin_clzll((unsigned long long)payload));
+
+                report->free_histogram[(bin < MEM_FRAG_BINS) ? bin : MEM_FRAG_BINS - 1u]++;
+                report->free_bytes  += payload;
+                report->free_blocks++;
+
+                if (payload > report->largest_free)
+                {
+                    report->largest_free = payload;
+                }
+
+                continue;
+            }
+
+            report->used_blocks++;
+            report->used_bytes      += payload;
+            report->header_bytes    += sizeof(block_header_t);
+
+#if defined(_DEBUG_)
+            pthread_mutex_lock(&debug_lock);
+
+            entry = MEM_debugLookup(block);
+            if (entry && entry->size <= payload)
+            {
+                report->requested_bytes += entry->size;
+                report->padding_bytes   += payload - entry->size;
+            }
+
+            pthread_mutex_unlock(&debug_lock);
+#endif
+        }
+    }
+
+    MEM_unlockHeap(allocator);
+
+    if (report->free_bytes > 0u)
+    {
+        report->external_fragmentation = 1.0 - ((double)report->largest_free / (double)report->free_bytes);
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_allocatorExportHeapMap
+ * @package MEM_alloc
+ * 
+ * @brief   Writes the layout of a heap for external tooling.
+ *
+ * @details Walks every segment in physical order under the allocator lock and writes one
+ *          entry per block, see the header for both encodings. Write errors of the stream are
+ *          reported once the whole map has been written.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     stream    Stream the map is written to.
+ * @param   [in]     format    Encoding of the map.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_allocatorExportHeapMap(mem_allocator_t *allocator, FILE *stream, mem_heapmap_format_t format)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    block_header_t *block   = NULL;
+    uint8_t *start          = NULL;
+    uint8_t *end            = NULL;
+
+    size_t index            = 0u;
+    uint64_t words[2]       = { 0u, 0u };
+    const char *separator   = "";
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || stream == NULL || allocator->heap == NULL ||
+        (format != MEM_HEAPMAP_JSON && format != MEM_HEAPMAP_BINARY))
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    MEM_lockHeap(allocator);
+
+    if (format == MEM_HEAPMAP_JSON)
+    {
+        fputs("{\"segments\":[", stream);
+    }
+    else
+    {
+        fwrite(MEM_HEAPMAP_MAGIC, 1u, sizeof(MEM_HEAPMAP_MAGIC) - 1u, stream);
+    }
+
+    for (index = 0u; index <= allocator->chunk_count; ++index)
+    {
+        if (!MEM_heapSegmentAt(allocator, index, &start, &end))
+        {
+            continue;
+        }
+
+        if (format == MEM_HEAPMAP_JSON)
+        {
+            fprintf(stream, "%s{\"base\":\"%p\",\"size\":%zu,\"blocks\":[", separator, (void *)start, (size_t)(end - start));
+            separator = ",";
+        }
+        else
+        {
+            words[0] = (uint64_t)(uintptr_t)start;
+            words[1] = (uint64_t)(end - start);
+            fwrite(words, sizeof(uint64_t), 2u, stream);
+        }
+
+        for (block = (block_header_t *)start; block != NULL; block = MEM_nextPhysBlock(block))
+        {
+            if (format == MEM_HEAPMAP_JSON)
+            {
+                fprintf(stream, "%s[%zu,%d]", ((uint8_t *)block == start) ? "" : ",",
+                        MEM_BLOCK_SIZE(block), MEM_BLOCK_IS_FREE(block) ? 1 : 0);
+            }
+            else
+            {
+                words[0] = (uint64_t)MEM_BLOCK_SIZE(block) | (MEM_BLOCK_IS_FREE(block) ? 1u : 0u);
+                fwrite(words, sizeof(uint64_t), 1u, stream);
+            }
+        }
+
+        if (format == MEM_HEAPMAP_JSON)
+        {
+            fputs("]}", stream);
+        }
+        else
+        {
+            words[0] = 0u;
+            fwrite(words, sizeof(uint64_t), 1u, stream);
+        }
+    }
+
+    if (format == MEM_HEAPMAP_JSON)
+    {
+        fputs("]}\n", stream);
+    }
+
+    MEM_unlockHeap(allocator);
+
+    ret = ferror(stream) ? EIO : 0;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_profileCompareSites
+ * @package MEM_alloc
+ * 
+ * @brief   qsort comparator ordering profiled sites by live bytes, largest first.
+ */
+static int MEM_profileCompareSites(const void *lhs, const void *rhs)
+{
+    /* Definition of Function Variables */
+    size_t a = ((const mem_profile_site_t *)lhs)->live_bytes;
+    size_t b = ((const mem_profile_site_t *)rhs)->live_bytes;
+
+    /* Function Return */
+    return (a < b) - (a > b);
+}
+
+/**
+ * @fn      MEM_profileSetRate
+ * @package MEM_alloc
+ * 
+ * @brief   Starts, tunes or stops the allocation-site profiler.
+ *
+ * @details Threads pick up the new rate on their next allocation. Blocks sampled before the
+ *          profiler is stopped are still taken off their sites when freed.
+ *
+ * @param   [in] rate 0 to stop sampling, 1 to profile every allocation, N for one in N.
+ */
+void MEM_profileSetRate(uint32_t rate)
+{
+    /* Start Function Logic */
+    __atomic_store_n(&profile_rate, rate, __ATOMIC_RELAXED);
+}
+
+/**
+ * @fn      MEM_profileSnapshot
+ * @package MEM_alloc
+ * 
+ * @brief   Copies the profiled allocation sites, largest live bytes first.
+ *
+ * @details Sites are sorted as a whole before the copy, so a small buffer receives the top
+ *          max_sites sites.
+ *
+ * @param   [out] sites     Buffer that receives the sites.
+ * @param   [in]  max_sites Capacity of sites.
+ *
+ * @return  Number of sites copied.
+ */
+size_t MEM_profileSnapshot(mem_profile_site_t *sites, size_t max_sites)
+{
+    /* Definition of Function Variables */
+    static mem_profile_site_t sorted[MEM_PROFILE_SITES];
+
+    size_t count    = 0u;
+    size_t slot     = 0u;
+
+    /* Check deference/argument boundaries */
+    if (sites == NULL || max_sites == 0u)
+    {
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    pthread_mutex_lock(&profile_lock);
+
+    for (slot = 0u; slot < MEM_PROFILE_SITES; ++slot)
+    {
+        if (profile_sites[slot].file != NULL)
+        {
+            sorted[count++] = profile_sites[slot];
+        }
+    }
+
+    qsort(sorted, count, sizeof(mem_profile_site_t), MEM_profileCompareSites);
+
+    count = (count < max_sites) ? count : max_sites;
+    memcpy(sites, sorted, count * sizeof(mem_profile_site_t));
+
+    pthread_mutex_unlock(&profile_lock);
+
+    /* Function Return */
+end_of_function:
+    return count;
+}
+
+/**
+ * @fn      MEM_profileReset
+ * @package MEM_alloc
+ * 
+ * @brief   Forgets every profiled site and sampled block, keeping the sample rate.
+ *
+ * @details Blocks sampled before the reset are freed as if they had never been sampled.
+ */
+void MEM_profileReset(void)
+{
+    /* Definition of Function Variables */
+    size_t slot = 0u;
+
+    /* Start Function Logic */
+    pthread_mutex_lock(&profile_lock);
+
+    memset(profile_sites, 0, sizeof(profile_sites));
+
+    for (slot = 0u; slot < MEM_PROFILE_BLOCKS; ++slot)
+    {
+        __atomic_store_n(&profile_blocks[slot].block, NULL, __ATOMIC_RELAXED);
+    }
+
+    __atomic_store_n(&profile_live, 0u, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&profile_lock);
+}
+
+/**
+ * @fn      MEM_validPointerCheck
+ * @package MEM_alloc
+ * 
+ * @brief   Validates if a pointer is within the allocator's heap.
+ *
+ * @details Checks whether a given pointer falls within one of the allocator's heap segments, is properly aligned,
+ *          has a valid block header, and is marked as allocated. The header is not trusted on its own: the
+ *          block must also carry its cookie, written by MEM_sealBlock when it was allocated, so interior,
+ *          stale and foreign pointers are rejected in constant time.
+ *
+ * @param   [in]  allocator Pointer to the memory allocator structure.
+ * @param   [in]  ptr       Pointer to validate.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_validPointerCheck(mem_allocator_t *allocator, void *ptr) 
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    uint8_t *segment_start  = NULL;
+    uint8_t *segment_end    = NULL;
+    uintptr_t heap_start    = 0u;
+    uintptr_t heap_end      = 0u;
+    uintptr_t user_ptr      = 0u;
+    size_t block_size       = 0u;
+
+    block_header_t *block   = NULL;
+    block_header_t *next    = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL) 
+    {
+        errno = EINVAL;
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    if (ptr == NULL) 
+    {
+        errno = EINVAL;
+        ret = EINVAL;
+        goto end_of_function;
+    }
+    
+    /* Assigning Initial Values for Variables */
+    user_ptr    = (uintptr_t)ptr;
+
+    /* Start Function Logic */
+    if (!MEM_heapSegment(allocator, (uint8_t *)ptr - sizeof(block_header_t), &segment_start, &segment_end))
+    {
+        errno = EINVAL;
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    heap_start  = (uintptr_t)segment_start;
+    heap_end    = (uintptr_t)segment_end;
+
+    if (user_ptr < heap_start + sizeof(block_header_t) || user_ptr >= heap_end) 
+    {
+        errno = EINVAL;
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    if (((user_ptr - heap_start) % ALIGNMENT) != 0u) 
+    {
+        errno = EINVAL;
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    block = (block_header_t *)(user_ptr - sizeof(block_header_t));
+    if ((uintptr_t)block < heap_start || (uintptr_t)block >= heap_end) 
+    {
+        errno = EINVAL;
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    block_size = MEM_loadBlockSize(block);
+
+    if ((block_size & MEM_BLOCK_FREE) != 0u) 
+    {
+        errno = EINVAL;
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    block_size &= ~MEM_BLOCK_FLAGS;
+
+    if (block_size < sizeof(block_header_t) + MEM_MIN_PAYLOAD_SIZE || block_size > heap_end - (uintptr_t)block)
+    {
+        errno = EINVAL;
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    next = (block_header_t *)((uintptr_t)block + block_size);
+    if (next->prev_size != MEM_blockCookie(allocator, block))
+    {
+        errno = EINVAL;
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    ret = 0u;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_allocatorUsableSize
+ * @package MEM_alloc
+ * 
+ * @brief   Returns the number of bytes usable in an allocated block.
+ *
+ * @param   [in]  allocator Pointer to the memory allocator structure.
+ * @param   [in]  ptr       Pointer returned by one of the allocator's allocation functions.
+ *
+ * @return  Usable size in bytes, or 0 for an invalid pointer.
+ */
+size_t MEM_allocatorUsableSize(mem_allocator_t *allocator, void *ptr)
+{
+    /* Definition of Function Variables */
+    size_t usable_size      = 0u;
+
+    block_header_t *block   = NULL;
+
+    /* Check deference/argument boundaries */
+    if (MEM_validPointerCheck(allocator, ptr) != 0u)
+    {
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    block = (block_header_t *)((uint8_t *)ptr - sizeof(block_header_t));
+
+    /* Start Function Logic */
+    usable_size = (MEM_loadBlockSize(block) & ~MEM_BLOCK_FLAGS) - sizeof(block_header_t);
+
+    /* Function Return */
+end_of_function:
+    return usable_size;
+}
+
+/**
+ * @fn      MEM_mergeBlocks
+ * @package MEM_alloc
+ * 
+ * @brief   Merges adjacent free blocks to reduce fragmentation.
+ *
+ * @details Combines a free block with its physical neighbours (if free) to create a larger contiguous free block.
+ *          The next block is found by address arithmetic and the previous one through its boundary tag, so both
+ *          merges are O(1). The resulting block gets its boundary tag and is linked into its segregated free list.
+ *          The block must already be marked free and must not be linked in a free list yet.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] block     Pointer to the block to be merged.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_mergeBlocks(mem_allocator_t *allocator, block_header_t *block) 
+{
+    /* Definition of Function Variables */
+    int ret = 0u;
+
+    block_header_t *next_block = NULL;
+    block_header_t *prev_block = NULL;
+    
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || block == NULL) 
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    next_block = MEM_nextPhysBlock(block);
+    if (next_block && MEM_BLOCK_IS_FREE(next_block)) 
+    {
+        MEM_freeListRemove(allocator, next_block);
+
+        block->size += MEM_BLOCK_SIZE(next_block);
+
+        if (allocator->last_allocated == next_block)
+        {
+            allocator->last_allocated = block;
+        }
+
+        allocator->stats.merges++;
+
+        MEM_traceRecord(MEM_TRACE_MERGE, block, MEM_BLOCK_SIZE(block), 0u);
+        MEM_LOG_DEBUG("MEM_mergeBlocks: Merged with next block. New size: %zu bytes.\n", MEM_BLOCK_SIZE(block));
+    }
+
+    if (block->size & MEM_BLOCK_PREV_FREE) 
+    {
+        prev_block = MEM_prevPhysBlock(block);
+
+        MEM_freeListRemove(allocator, prev_block);
+
+        prev_block->size += MEM_BLOCK_SIZE(block);
+
+        if (allocator->last_allocated == block)
+        {
+            allocator->last_allocated = prev_block;
+        }
+
+        block = prev_block;
+
+        allocator->stats.merges++;
+
+        MEM_traceRecord(MEM_TRACE_MERGE, block, MEM_BLOCK_SIZE(block), 0u);
+        MEM_LOG_DEBUG("MEM_mergeBlocks: Merged with previous block. New size: %zu bytes.\n", MEM_BLOCK_SIZE(block));
+    }
+
+    MEM_markFree(block);
+    MEM_freeListInsert(allocator, block);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_tcachePut
+ * @package MEM_alloc
+ * 
+ * @brief   Pushes a block into the calling thread's cache.
+ *
+ * @details The block stays marked allocated. Its size is read with MEM_loadBlockSize since a
+ *          thread holding the heap lock may concurrently update its MEM_BLOCK_PREV_FREE flag;
+ *          everything else is a plain thread-local access.
+ *
+ * @param   [in/out] block Pointer to a validated, allocated block header.
+ *
+ * @return  0 when the block was cached, EINVAL on a double free, EAGAIN when the caller must
+ *          return the block to the heap (size not cached, or bin full).
+ */
+static int MEM_tcachePut(block_header_t *block)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    size_t bin              = 0u;
+    free_links_t *links     = NULL;
+    block_header_t *cached  = NULL;
+
+    /* Assigning Initial Values for Variables */
+    links   = MEM_FREE_LINKS(block);
+    bin     = MEM_tcacheBinIndex((MEM_loadBlockSize(block) & ~MEM_BLOCK_FLAGS) - sizeof(block_header_t));
+
+    /* Check deference/argument boundaries */
+    if (bin >= MEM_TCACHE_BINS)
+    {
+        ret = EAGAIN;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    if ((void *)links->prev_free == (void *)&tcache)
+    {
+        for (cached = tcache.bins[bin]; cached != NULL; cached = MEM_FREE_LINKS(cached)->next_free)
+        {
+            if (cached == block)
+            {
+                ret = EINVAL;
+                goto end_of_function;
+            }
+        }
+    }
+
+    if (tcache.counts[bin] >= MEM_TCACHE_COUNT)
+    {
+        tcache.stats.spilled_frees++;
+
+        ret = EAGAIN;
+        goto end_of_function;
+    }
+
+    links->next_free    = tcache.bins[bin];
+    links->prev_free    = (block_header_t *)(void *)&tcache;
+
+    tcache.bins[bin]    = block;
+    tcache.counts[bin]++;
+    tcache.stats.cached_frees++;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_allocatorFree
+ * @package MEM_alloc
+ * 
+ * @brief   Frees allocated memory using the custom allocator.
+ *
+ * @details Marks a previously allocated block as free, clears its metadata, and attempts to merge it with
+ *          adjacent free blocks to minimize fragmentation. In thread-safe mode small blocks are kept in the
+ *          calling thread's cache while their bin has room, provided the thread already allocates from this
+ *          allocator. Threads caching another allocator, or none, push the block on the remote-free list
+ *          without taking the lock; the next locked allocation drains it. Everything else runs
+ *          under the allocator lock.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     ptr       Pointer to the memory to free.
+ * @param   [in]     file      Name of the file requesting the free operation.
+ * @param   [in]     line      Line number in the file requesting the free operation.
+ * @param   [in]     var_name  Name of the variable being freed.
+ *
+ * @return 0 on success, error code on failure.
+ */
+int MEM_allocatorFree(mem_allocator_t *allocator, void *ptr, const char *file, int line, const char *var_name) 
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    block_header_t *block   = NULL;
+    
+    /* Check deference/argument boundaries */
+    if (allocator == NULL) 
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Recorded before the block can be reused, so it precedes the next malloc of ptr */
+    MEM_recordOp(MEM_RECORD_FREE, ptr, 0u, file, line);
+
+    /* Start Function Logic */
+    if (allocator->thread_safe && tcache.owner == allocator)
+    {
+        ret = MEM_validPointerCheck(allocator, ptr);
+        if (ret != 0u) 
+        {
+            MEM_LOG_ERROR("MEM_allocatorFree: Invalid pointer %p for variable '%s' (in %s:%d)\n", ptr, var_name, file, line);
+            goto end_of_function;
+        }
+
+        block   = (block_header_t *)((uint8_t *)ptr - sizeof(block_header_t));
+        ret     = MEM_tcachePut(block);
+
+        if (ret == EINVAL)
+        {
+            MEM_LOG_ERROR("MEM_allocatorFree: Double free detected for %p (variable '%s') (in %s:%d)\n", ptr, var_name, file, line);
+            goto end_of_function;
+        }
+
+        if (ret == 0u)
+        {
+#if defined(_DEBUG_)
+            MEM_debugForget(block);
+#endif
+
+            MEM_profileForget(block);
+            goto end_of_function;
+        }
+    }
+    else if (allocator->thread_safe)
+    {
+        ret = MEM_validPointerCheck(allocator, ptr);
+        if (ret != 0u) 
+        {
+            MEM_LOG_ERROR("MEM_allocatorFree: Invalid pointer %p for variable '%s' (in %s:%d)\n", ptr, var_name, file, line);
+            goto end_of_function;
+        }
+
+        block   = (block_header_t *)((uint8_t *)ptr - sizeof(block_header_t));
+        ret     = MEM_remotePush(allocator, block);
+
+        if (ret != 0u)
+        {
+            MEM_LOG_ERROR("MEM_allocatorFree: Double free detected for %p (variable '%s') (in %s:%d)\n", ptr, var_name, file, line);
+        }
+
+        goto end_of_function;
+    }
+
+    MEM_lockHeap(allocator);
+    MEM_remoteDrain(allocator);
+    ret = MEM_heapFree(allocator, ptr, file, line, var_name);
+    MEM_unlockHeap(allocator);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_heapResize
+ * @package MEM_alloc
+ * 
+ * @brief   Resizes an allocated block without moving it.
+ *
+ * @details Shrinking splits the tail off with MEM_splitBlock and merges it with a free
+ *          successor. Growing absorbs a free physical successor, found by the same adjacency
+ *          check MEM_mergeBlocks uses, and splits off what is not needed. The caller holds the
+ *          heap lock in thread-safe mode.
+ *
+ * @param   [in/out] allocator    Pointer to the memory allocator structure.
+ * @param   [in/out] block        Pointer to a validated, allocated block header.
+ * @param   [in]     aligned_size Aligned payload size requested.
+ *
+ * @return  0 when the block now holds aligned_size bytes, EAGAIN when it must move.
+ */
+static int MEM_heapResize(mem_allocator_t *allocator, block_header_t *block, size_t aligned_size)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    size_t payload          = 0u;
+    block_header_t *next    = NULL;
+
+    /* Assigning Initial Values for Variables */
+    payload = MEM_BLOCK_SIZE(block) - sizeof(block_header_t);
+    next    = MEM_nextPhysBlock(block);
+
+    /* Start Function Logic */
+    if (aligned_size <= payload)
+    {
+        MEM_splitBlock(allocator, block, aligned_size);
+
+        next = MEM_nextPhysBlock(block);
+        if (next && MEM_BLOCK_IS_FREE(next))
+        {
+            MEM_freeListRemove(allocator, next);
+            ret = MEM_mergeBlocks(allocator, next);
+        }
+
+        goto end_of_function;
+    }
+
+    if (next == NULL || !MEM_BLOCK_IS_FREE(next) || payload + MEM_BLOCK_SIZE(next) < aligned_size)
+    {
+        ret = EAGAIN;
+        goto end_of_function;
+    }
+
+    MEM_freeListRemove(allocator, next);
+
+    block->size += MEM_BLOCK_SIZE(next);
+
+    if (allocator->last_allocated == next)
+    {
+        allocator->last_allocated = block;
+    }
+
+    MEM_markAllocated(block);
+    ret = MEM_splitBlock(allocator, block, aligned_size);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_allocatorRealloc
+ * @package MEM_alloc
+ * 
+ * @brief   Changes the size of an allocated block, in place when possible.
+ *
+ * @details A block shrinks in place and grows in place into a free physical successor. Only
+ *          when neither applies is a new block allocated with the given strategy, the old
+ *          payload copied and the old block freed. On failure the original block is left
+ *          untouched. A NULL ptr allocates; a size of 0 frees ptr and returns NULL.
+ *
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     ptr       Pointer to the memory to resize, or NULL.
+ * @param   [in]     size      New size in bytes.
+ * @param   [in]     file      Name of the file requesting the reallocation.
+ * @param   [in]     line      Line number in the file requesting the reallocation.
+ * @param   [in]     var_name  Name of the variable being reallocated.
+ * @param   [in]     strategy  Allocation strategy used when the block has to move.
+ *
+ * @return  Pointer to the resized memory on success, or NULL on failure.
+ */
+void *MEM_allocatorRealloc(mem_allocator_t *allocator, void *ptr, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    size_t aligned_size     = 0u;
+    size_t payload          = 0u;
+
+    void *user_ptr          = NULL;
+    block_header_t *block   = NULL;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL)
+    {
+        errno = EINVAL;
+        goto end_of_function;
+    }
+
+    if (ptr == NULL)
+    {
+        user_ptr = MEM_allocatorMalloc(allocator, size, file, line, var_name, strategy);
+        goto end_of_function;
+    }
 
-/* implements: */
-#include <libmemalloc.h>
+    if (size == 0u)
+    {
+        MEM_allocatorFree(allocator, ptr, file, line, var_name);
+        goto end_of_function;
+    }
 
-/* =================================
- *     PRIVATE GLOBAL VARIABLE     *
- * ================================*/
+    if (size > SIZE_MAX - ARCH_ALIGNMENT)
+    {
+        errno = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    aligned_size = ALIGN(size);
+
+    if (aligned_size < MEM_MIN_PAYLOAD_SIZE)
+    {
+        aligned_size = MEM_MIN_PAYLOAD_SIZE;
+    }
+
+    block = (block_header_t *)((uint8_t *)ptr - sizeof(block_header_t));
+
+    /* Start Function Logic */
+    MEM_lockHeap(allocator);
+    MEM_remoteDrain(allocator);
+
+    ret = MEM_validPointerCheck(allocator, ptr);
+    if (ret != 0u)
+    {
+        MEM_unlockHeap(allocator);
+        MEM_LOG_ERROR("MEM_allocatorRealloc: Invalid pointer %p for variable '%s' (in %s:%d)\n", ptr, var_name, file, line);
+        goto end_of_function;
+    }
+
+    payload = MEM_BLOCK_SIZE(block) - sizeof(block_header_t);
+    ret     = MEM_heapResize(allocator, block, aligned_size);
+
+    if (ret == 0u)
+    {
+        user_ptr = ptr;
+
+        MEM_statsAllocated(allocator, strategy, 0u);
+
+#if defined(_DEBUG_)
+        MEM_debugRecord(block, file, line, var_name, size);
+#endif
+
+        MEM_profileForget(block);
+        MEM_profileRecord(block, file, line, size);
+
+        MEM_traceRecord(MEM_TRACE_REALLOC, block, MEM_BLOCK_SIZE(block), 1u);
+        MEM_LOG_DEBUG("MEM_allocatorRealloc: Resized '%s' at %p in place to %zu bytes (in %s:%d)\n",
+                      var_name, ptr, size, file, line);
+    }
+
+    MEM_unlockHeap(allocator);
+
+    if (user_ptr != NULL)
+    {
+        MEM_recordOp(MEM_RECORD_FREE, ptr, 0u, file, line);
+        MEM_recordOp(MEM_RECORD_MALLOC, ptr, size, file, line);
+        goto end_of_function;
+    }
+
+    user_ptr = MEM_allocatorMalloc(allocator, size, file, line, var_name, strategy);
+    if (user_ptr == NULL)
+    {
+        goto end_of_function;
+    }
+
+    memcpy(user_ptr, ptr, payload);
+    MEM_allocatorFree(allocator, ptr, file, line, var_name);
+
+    block = (block_header_t *)((uint8_t *)user_ptr - sizeof(block_header_t));
+    MEM_traceRecord(MEM_TRACE_REALLOC, block, MEM_loadBlockSize(block) & ~MEM_BLOCK_FLAGS, 0u);
+
+    /* Function Return */
+end_of_function:
+    return user_ptr;
+}
 
 /**
- * @var     heap_memory
+ * @fn      MEM_allocatorSetGrowth
  * @package MEM_alloc
  * 
- * @brief   Heap memory aligned and placed in a specific memory section.
+ * @brief   Lets an allocator grow when its heap is exhausted.
  *
- * @details Ensures that the heap is properly aligned based on the architecture for optimal memory access and performance.
+ * @param   [in/out] allocator         Pointer to the memory allocator structure.
+ * @param   [in]     provider          Backing store, or NULL for anonymous mmap.
+ * @param   [in]     chunk_size        Minimum size of a chunk, 0 to disable growth.
+ * @param   [in]     release_threshold Bytes of empty chunks to keep for later reuse.
+ *
+ * @return  0 on success, EBUSY while grown chunks are live, other error code on failure.
  */
-static uint8_t heap_memory[HEAP_SIZE] __attribute__((section(".heap"), aligned(ARCH_ALIGNMENT)));
+int MEM_allocatorSetGrowth(mem_allocator_t *allocator, const mem_chunk_provider_t *provider, size_t chunk_size, size_t release_threshold)
+{
+    /* Definition of Function Variables */
+    int ret         = 0u;
+    size_t index    = 0u;
 
-/* =================================
- *   PRIVATE FUNCTION DECLARATION  *
- * ================================*/
+    /* Check deference/argument boundaries */
+    if (allocator == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    if (provider != NULL && (provider->acquire == NULL || provider->release == NULL))
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    MEM_lockHeap(allocator);
+
+    /* Live chunks must go back to the provider they came from */
+    for (index = 0u; index < allocator->chunk_count; ++index)
+    {
+        if (allocator->chunks[index].start != NULL)
+        {
+            ret = EBUSY;
+            goto unlock_heap;
+        }
+    }
+
+    if (provider)
+    {
+        allocator->provider = *provider;
+    }
+    else
+    {
+        allocator->provider.acquire = MEM_chunkMmapAcquire;
+        allocator->provider.release = MEM_chunkMmapRelease;
+        allocator->provider.context = NULL;
+    }
+
+    allocator->chunk_size           = chunk_size;
+    allocator->release_threshold    = release_threshold;
+
+unlock_heap:
+    MEM_unlockHeap(allocator);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
 
 /**
- * @fn      MEM_printd
+ * @fn      MEM_allocatorSetThreadSafe
  * @package MEM_alloc
  * 
- * @brief   Prints debug messages.
+ * @brief   Enables or disables the thread-safe mode of an allocator.
  *
- * @details Formats and prints debug messages to the standard output using variable arguments.
+ * @details Disabling flushes the calling thread's cache first; other threads must have
+ *          flushed theirs (or exited) beforehand.
  *
- * @param   [in] format Format string.
- * @param   [in] ...    Variable arguments corresponding to the format string.
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     enable    Non-zero to enable the thread-safe mode, 0 to disable it.
+ *
+ * @return  0 on success, error code on failure.
  */
-void MEM_printd(const char *format, ...) 
+int MEM_allocatorSetThreadSafe(mem_allocator_t *allocator, int enable)
 {
     /* Definition of Function Variables */
-    va_list args;
+    int ret = 0u;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
 
     /* Start Function Logic */
-    va_start(args, format);
-    vprintf(format, args);
-    va_end(args);
+    if (!enable && tcache.owner == allocator)
+    {
+        ret = MEM_tcacheFlush();
+    }
+
+    if (!enable)
+    {
+        MEM_lockHeap(allocator);
+        MEM_remoteDrain(allocator);
+        MEM_unlockHeap(allocator);
+    }
+
+    allocator->thread_safe = (enable != 0);
+
+    /* Function Return */
+end_of_function:
+    return ret;
 }
 
 /**
- * @fn      MEM_allocatorInit
+ * @fn      MEM_allocatorSetDeferredCoalescing
  * @package MEM_alloc
  * 
- * @brief   Initializes the memory allocator.
- *
- * @details Sets up the memory allocator by zero-initializing the heap and creating 
- *          the initial free block that spans the entire heap.    
+ * @brief   Enables or disables deferred coalescing of small blocks.
  *
- * @param   [in/out] allocator Pointer to the memory allocator structure to be initialized.
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     enable    Non-zero to enable deferred coalescing, 0 to disable it.
  *
  * @return  0 on success, error code on failure.
  */
-int MEM_allocatorInit(mem_allocator_t *allocator) 
+int MEM_allocatorSetDeferredCoalescing(mem_allocator_t *allocator, int enable)
 {
     /* Definition of Function Variables */
-    int ret                         = 0u;
+    int ret = 0u;
 
-    block_header_t *initial_block   = NULL;
-    
     /* Check deference/argument boundaries */
-    if (allocator == NULL) 
+    if (allocator == NULL)
     {
         ret = EINVAL;
         goto end_of_function;
     }
-    
-    /* Assigning Initial Values for Variables */
-    memset(heap_memory, 0, HEAP_SIZE);
-
-    initial_block               = (block_header_t *)(heap_memory);
 
     /* Start Function Logic */
-    initial_block->size         = HEAP_SIZE;
-    initial_block->free         = 1u;
-    initial_block->next         = NULL;
-    initial_block->prev         = NULL;
-    initial_block->file         = NULL;
-    initial_block->line         = 0u;
-    initial_block->var_name     = NULL;
+    MEM_lockHeap(allocator);
 
-    allocator->free_list        = initial_block;
-    allocator->heap             = heap_memory;
-    allocator->last_allocated   = initial_block;
+    if (!enable)
+    {
+        MEM_fastbinConsolidate(allocator, SIZE_MAX);
+    }
+
+    allocator->deferred_coalescing = (enable != 0);
+
+    MEM_unlockHeap(allocator);
 
     /* Function Return */
 end_of_function:
@@ -136,105 +6774,163 @@ end_of_function:
 }
 
 /**
- * @fn      MEM_findFirstFit
+ * @fn      MEM_allocatorTrim
  * @package MEM_alloc
  * 
- * @brief   Finds the first free block that can accommodate the requested size.
+ * @brief   Gives the free memory of a heap back to the operating system.
  *
- * @details Implements the First-Fit allocation strategy by searching the free list and returning
- *          the first block that is large enough to satisfy the allocation request.
+ * @details Uses the same physical walk over every heap segment as MEM_allocatorPrintAll, so
+ *          its cost is linear in the number of blocks; call it when the heap is idle.
  *
- * @param   [in]      allocator Pointer to the memory allocator structure.
- * @param   [in]      size      Requested memory size.
- * @param   [out]     fit_block Output parameter to store the found free block.
+ * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in]     pad       Bytes of each free block kept resident after its metadata.
  *
- * @return 0 on success, error code on failure.
+ * @return  Number of bytes given back, 0 with errno set to EINVAL for invalid arguments.
  */
-int MEM_findFirstFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block) 
+size_t MEM_allocatorTrim(mem_allocator_t *allocator, size_t pad)
 {
     /* Definition of Function Variables */
-    int ret = 0u;
+    size_t released         = 0u;
+    size_t index            = 0u;
+
+    block_header_t *block   = NULL;
+    uint8_t *start          = NULL;
+    uint8_t *end            = NULL;
 
-    block_header_t *current = NULL;
-    
     /* Check deference/argument boundaries */
-    if (allocator == NULL || fit_block == NULL) 
+    if (allocator == NULL || allocator->heap == NULL)
     {
-        ret = EINVAL;
+        errno = EINVAL;
         goto end_of_function;
     }
-    
-    /* Assigning Initial Values for Variables */
-    current = allocator->free_list;
 
     /* Start Function Logic */
-    while (current) 
+    MEM_lockHeap(allocator);
+
+    MEM_remoteDrain(allocator);
+    MEM_fastbinConsolidate(allocator, SIZE_MAX);
+
+    released = MEM_heapShrink(allocator, 0u);
+
+    for (index = 0u; index <= allocator->chunk_count; ++index)
     {
-        if (current->free && current->size >= size + sizeof(block_header_t)) {
-            *fit_block = current;
-            goto end_of_function;
+        if (!MEM_heapSegmentAt(allocator, index, &start, &end))
+        {
+            continue;
         }
 
-        current = current->next;
+        for (block = (block_header_t *)start; block != NULL; block = MEM_nextPhysBlock(block))
+        {
+            if (MEM_BLOCK_IS_FREE(block))
+            {
+                released += MEM_trimBlock(block, pad);
+            }
+        }
     }
 
-    ret = ENOMEM;
+    MEM_unlockHeap(allocator);
+
+    MEM_LOG_DEBUG("MEM_allocatorTrim: Gave %zu bytes back to the system.\n", released);
 
     /* Function Return */
 end_of_function:
-    return ret;
+    return released;
 }
 
 /**
- * @fn      MEM_findNextFit
+ * @fn      MEM_allocatorSetTrimThreshold
  * @package MEM_alloc
  * 
- * @brief   Finds the next suitable free block starting from the last allocated block.
- *
- * @details Implements the Next-Fit allocation strategy by continuing the search from where the last
- *          allocation occurred, potentially improving allocation distribution and reducing fragmentation.
+ * @brief   Makes frees give the pages of large free blocks back as they happen.
  *
  * @param   [in/out] allocator Pointer to the memory allocator structure.
- * @param   [in]     size      Requested memory size.
- * @param   [out]    fit_block Output parameter to store the found free block.
+ * @param   [in]     threshold Smallest free block size trimmed on free, 0 to disable.
  *
- * @return 0 on success, error code on failure.
+ * @return  0 on success, error code on failure.
  */
-int MEM_findNextFit(mem_allocator_t *allocator, size_t size, block_header_t **fit_block) 
+int MEM_allocatorSetTrimThreshold(mem_allocator_t *allocator, size_t threshold)
 {
     /* Definition of Function Variables */
-    int ret                     = 0u;
-
-    block_header_t *current     = NULL;
-    block_header_t *start       = NULL;
+    int ret = 0u;
 
     /* Check deference/argument boundaries */
-    if (allocator == NULL || fit_block == NULL)
+    if (allocator == NULL)
     {
         ret = EINVAL;
         goto end_of_function;
     }
-    
+
+    /* Start Function Logic */
+    MEM_lockHeap(allocator);
+    allocator->trim_threshold = threshold;
+    MEM_unlockHeap(allocator);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_tcacheFlush
+ * @package MEM_alloc
+ * 
+ * @brief   Returns every block cached by the calling thread to its allocator.
+ *
+ * @details Takes the owner's lock once for the whole cache, returns the blocks through the
+ *          regular free path along with the owner's remote-free list, merges the counters and
+ *          unbinds the cache.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_tcacheFlush(void)
+{
+    /* Definition of Function Variables */
+    int ret                     = 0u;
+    int err                     = 0u;
+
+    size_t bin                  = 0u;
+    mem_allocator_t *allocator  = NULL;
+    block_header_t *block       = NULL;
+
     /* Assigning Initial Values for Variables */
-    current     = allocator->last_allocated;
-    start       = current;
+    allocator = tcache.owner;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL)
+    {
+        goto end_of_function;
+    }
 
     /* Start Function Logic */
-    do 
+    tcache.stats.flushes++;
+
+    MEM_lockHeap(allocator);
+    MEM_remoteDrain(allocator);
+
+    for (bin = 0u; bin < MEM_TCACHE_BINS; ++bin)
     {
-        if (current->free && current->size >= size + sizeof(block_header_t)) 
+        while (tcache.bins[bin] != NULL)
         {
-            *fit_block                  = current;
-            allocator->last_allocated   = current;
+            block               = tcache.bins[bin];
+            tcache.bins[bin]    = MEM_FREE_LINKS(block)->next_free;
 
-            goto end_of_function;
+            err = MEM_heapFree(allocator, (uint8_t *)block + sizeof(block_header_t), __FILE__, __LINE__, "tcache");
+            if (err != 0u)
+            {
+                ret = err;
+            }
         }
+    }
 
-        current = current->next ? current->next : (block_header_t *)allocator->heap;
-    } while (current != start);
+    allocator->tcache_stats.hits            += tcache.stats.hits;
+    allocator->tcache_stats.misses          += tcache.stats.misses;
+    allocator->tcache_stats.cached_frees    += tcache.stats.cached_frees;
+    allocator->tcache_stats.spilled_frees   += tcache.stats.spilled_frees;
+    allocator->tcache_stats.flushes         += tcache.stats.flushes;
 
+    MEM_unlockHeap(allocator);
 
-    ret = ENOMEM;
+    memset(&tcache, 0, sizeof(mem_tcache_t));
 
     /* Function Return */
 end_of_function:
@@ -242,56 +6938,97 @@ end_of_function:
 }
 
 /**
- * @fn      MEM_findBestFit
+ * @fn      MEM_tcacheGetStats
  * @package MEM_alloc
  * 
- * @brief   Finds the best-fit free block for the requested size.
+ * @brief   Reads the thread cache counters of an allocator.
  *
- * @details Implements the Best-Fit allocation strategy by searching the free list and selecting
- *          the smallest block that is large enough to satisfy the allocation request, aiming to
- *          minimize fragmentation.
+ * @param   [in]  allocator Pointer to the memory allocator structure.
+ * @param   [out] stats     Output parameter receiving the counters.
  *
- * @param   [in]      allocator Pointer to the memory allocator structure.
- * @param   [in]      size      Requested memory size.
- * @param   [out]     best_fit  Output parameter to store the best-fit free block.
+ * @return  0 on success, error code on failure.
+ */
+int MEM_tcacheGetStats(mem_allocator_t *allocator, mem_tcache_stats_t *stats)
+{
+    /* Definition of Function Variables */
+    int ret = 0u;
+
+    /* Check deference/argument boundaries */
+    if (allocator == NULL || stats == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    MEM_lockHeap(allocator);
+    *stats = allocator->tcache_stats;
+    MEM_unlockHeap(allocator);
+
+    if (tcache.owner == allocator)
+    {
+        stats->hits             += tcache.stats.hits;
+        stats->misses           += tcache.stats.misses;
+        stats->cached_frees     += tcache.stats.cached_frees;
+        stats->spilled_frees    += tcache.stats.spilled_frees;
+        stats->flushes          += tcache.stats.flushes;
+    }
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_arenaSetInit
+ * @package MEM_alloc
+ * 
+ * @brief   Splits the static heap into independent arenas.
  *
- * @return 0 on success, error code on failure.
+ * @param   [out] set    Pointer to the arena set to initialize.
+ * @param   [in]  count  Number of arenas, between 1 and MEM_ARENAS_MAX.
+ * @param   [in]  policy Thread-to-arena assignment policy.
+ *
+ * @return  0 on success, error code on failure.
  */
-int MEM_findBestFit(mem_allocator_t *allocator, size_t size, block_header_t **best_fit) 
+int MEM_arenaSetInit(mem_arena_set_t *set, size_t count, mem_arena_policy_t policy)
 {
     /* Definition of Function Variables */
-    int ret                 = 0u;
+    int ret         = 0u;
 
-    block_header_t *current = NULL;
+    size_t index    = 0u;
+    size_t slice    = 0u;
 
     /* Check deference/argument boundaries */
-    if (allocator == NULL || best_fit == NULL) 
+    if (set == NULL || count == 0u || count > MEM_ARENAS_MAX)
     {
         ret = EINVAL;
         goto end_of_function;
     }
-    
+
     /* Assigning Initial Values for Variables */
-    *best_fit   = NULL;
-    current     = allocator->free_list;
+    slice = (HEAP_SIZE / count) & ~((size_t)ARCH_ALIGNMENT - 1u);
 
-    /* Start Function Logic */
-    while (current) 
+    if (slice < (2u * sizeof(block_header_t)) + MEM_MIN_PAYLOAD_SIZE)
     {
-        if (current->free && current->size >= size + sizeof(block_header_t)) 
-        {
-            if (*best_fit == NULL || current->size < (*best_fit)->size) 
-            {
-                *best_fit = current;
-            }
-        }
+        ret = EINVAL;
+        goto end_of_function;
+    }
 
-        current = current->next;
+    /* Start Function Logic */
+    for (index = 0u; index < count; ++index)
+    {
+        MEM_heapInit(&set->arenas[index], heap_memory + (index * slice), slice);
+        (void)MEM_allocatorSetThreadSafe(&set->arenas[index], 1);
     }
 
-    if (*best_fit == NULL) 
+    set->count      = count;
+    set->policy     = policy;
+    set->next_arena = 0u;
+
+    if (arena_affinity.set == set)
     {
-        ret = ENOMEM;
+        arena_affinity.set = NULL;
     }
 
     /* Function Return */
@@ -300,76 +7037,88 @@ end_of_function:
 }
 
 /**
- * @fn      MEM_splitBlock
+ * @fn      MEM_arenaSetInitNodes
  * @package MEM_alloc
  * 
- * @brief   Splits a free block into two if possible.
+ * @brief   Initializes one arena per NUMA node, each on memory bound to its node.
  *
- * @details Divides a larger free block into an allocated block and a smaller free b
- *          lock while maintaining alignment constraints. Updates the free list accordingly.
- *
- * @param   [in/out] allocator Pointer to the memory allocator structure.
- * @param   [in/out] block     Pointer to the block to be split.
- * @param   [in]     size      Size of memory to allocate.
+ * @param   [out] set        Pointer to the arena set to initialize.
+ * @param   [in]  arena_size Initial heap size and growth chunk size of each arena.
+ * @param   [in]  pages      Page size of every mapping.
  *
  * @return  0 on success, error code on failure.
  */
-int MEM_splitBlock(mem_allocator_t *allocator, block_header_t *block, size_t size) 
+int MEM_arenaSetInitNodes(mem_arena_set_t *set, size_t arena_size, mem_page_mode_t pages)
 {
     /* Definition of Function Variables */
-    int ret                     = 0u;
-
-    size_t aligned_size         = 0u;
+    int ret                         = 0u;
 
-    uint8_t *new_block_addr     = NULL;
-    block_header_t *new_block   = NULL;
+    size_t index                    = 0u;
+    size_t count                    = 0u;
+    mem_backing_t backing           = { 0 };
+    mem_chunk_provider_t provider   = { 0 };
 
     /* Check deference/argument boundaries */
-    if (allocator == NULL || block == NULL) 
+    if (set == NULL || arena_size == 0u)
     {
         ret = EINVAL;
         goto end_of_function;
     }
-    
+
     /* Assigning Initial Values for Variables */
-    aligned_size = ALIGN(size);
+    count = MEM_numaNodeCount();
+    if (count > MEM_ARENAS_MAX)
+    {
+        count = MEM_ARENAS_MAX;
+    }
+
+    backing.pages       = pages;
+    provider.acquire    = MEM_backingAcquire;
+    provider.release    = MEM_backingRelease;
 
     /* Start Function Logic */
-    if (block->size >= aligned_size + sizeof(block_header_t) + ARCH_ALIGNMENT) 
+    for (index = 0u; index < count; ++index)
     {
-        new_block_addr      = (uint8_t *)block + sizeof(block_header_t) + aligned_size;
-        new_block           = (block_header_t *)new_block_addr;
+        backing.node = (int)index;
 
-        new_block->size     = block->size - sizeof(block_header_t) - aligned_size;
-        new_block->free     = 1u;
-        new_block->file     = NULL;
-        new_block->line     = 0u;
-        new_block->var_name = NULL;
-        new_block->next     = block->next;
-        new_block->prev     = block;
+        ret = MEM_allocatorInitBacked(&set->arenas[index], arena_size, &backing);
+        if (ret != 0u)
+        {
+            goto destroy_arenas;
+        }
 
-        block->size         = aligned_size + sizeof(block_header_t);
-        block->free         = 0u;
+        /* Grown chunks follow the placement of the arena they belong to */
+        provider.context = &set->arenas[index].backing;
 
-        if (new_block->next) 
+        ret = MEM_allocatorSetGrowth(&set->arenas[index], &provider, arena_size, 0u);
+        if (ret == 0u)
         {
-            new_block->next->prev = new_block;
+            ret = MEM_allocatorSetThreadSafe(&set->arenas[index], 1);
         }
 
-        block->next = new_block;
-
-        if (allocator->free_list == block) 
+        if (ret != 0u)
         {
-            allocator->free_list = new_block;
+            (void)MEM_allocatorDestroy(&set->arenas[index]);
+            goto destroy_arenas;
         }
+    }
 
-        MEM_printd("MEM_splitBlock: Split block. New block at %p with size %zu bytes.\n",
-                   (void *)new_block, new_block->size);
-    } 
-    else 
+    set->count      = count;
+    set->policy     = MEM_ARENA_BY_NODE;
+    set->next_arena = 0u;
+
+    if (arena_affinity.set == set)
+    {
+        arena_affinity.set = NULL;
+    }
+
+    goto end_of_function;
+
+destroy_arenas:
+    while (index > 0u)
     {
-        block->free = 0u;
-        MEM_printd("MEM_splitBlock: Block at %p not split. Marked as allocated.\n", (void *)block);
+        --index;
+        (void)MEM_allocatorDestroy(&set->arenas[index]);
     }
 
     /* Function Return */
@@ -378,318 +7127,246 @@ end_of_function:
 }
 
 /**
- * @fn      MEM_allocatorMalloc
+ * @fn      MEM_arenaSetDestroy
  * @package MEM_alloc
  * 
- * @brief   Allocates memory using the custom allocator.
- *
- * @details Allocates a block of memory of the specified size from the allocator's heap. It aligns the size,
- *          selects the allocation strategy, finds the appropriate-fit block, splits it if necessary,
- *          and updates the block's metadata with the allocation source information.
+ * @brief   Tears every arena of a set down, see MEM_allocatorDestroy.
  *
- * @param   [in/out] allocator Pointer to the memory allocator structure.
- * @param   [in]     size      Size of memory to allocate.
- * @param   [in]     file      Name of the file requesting the allocation.
- * @param   [in]     line      Line number in the file requesting the allocation.
- * @param   [in]     var_name  Name of the variable being allocated.
- * @param   [in]     strategy  Allocation strategy to use (FIRST_FIT, NEXT_FIT, BEST_FIT).
+ * @param   [in/out] set Pointer to the arena set.
  *
- * @return Pointer to the allocated memory on success, or NULL on failure.
+ * @return  0 on success, the first error code met otherwise.
  */
-void *MEM_allocatorMalloc(mem_allocator_t *allocator, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy) 
+int MEM_arenaSetDestroy(mem_arena_set_t *set)
 {
     /* Definition of Function Variables */
-    int ret                 = 0u;
-
-    size_t aligned_size     = 0u
-
-    void *user_ptr          = NULL;
-    block_header_t *block   = NULL;
+    int ret         = 0u;
+    int status      = 0u;
+    size_t index    = 0u;
 
     /* Check deference/argument boundaries */
-    if (allocator == NULL) 
-    {
-        errno       = EINVAL;
-        user_ptr    = NULL;
-
-        goto end_of_function;
-    }
-
-    if (size == 0u) 
+    if (set == NULL)
     {
-        errno       = EINVAL;
-        user_ptr    = NULL;
-
+        ret = EINVAL;
         goto end_of_function;
     }
-    
-    /* Assigning Initial Values for Variables */
-    aligned_size = ALIGN(size);
 
     /* Start Function Logic */
-    switch (strategy) 
+    for (index = 0u; index < set->count; ++index)
     {
-        case FIRST_FIT:
-            ret = MEM_findFirstFit(allocator, aligned_size, &block);
-            break;
-        case NEXT_FIT:
-            ret = MEM_findNextFit(allocator, aligned_size, &block);
-            break;
-        case BEST_FIT:
-            ret = MEM_findBestFit(allocator, aligned_size, &block);
-            break;
-        default:
-            fprintf(stderr, "MEM_allocatorMalloc: Unknown allocation strategy.\n");
-            errno = EINVAL;
-            return NULL;
+        status = MEM_allocatorDestroy(&set->arenas[index]);
+        if (ret == 0u)
+        {
+            ret = status;
+        }
     }
 
-    if (ret != 0 || block == NULL) 
-    {
-        fprintf(stderr, "MEM_allocatorMalloc: No sufficient free block to allocate %zu bytes for variable '%s' (in %s:%d)\n", 
-                size, var_name, file, line);
-
-        errno       = EINVAL;
-        user_ptr    = NULL;
-
-        goto end_of_function;
-    }
+    set->count = 0u;
 
-    ret = MEM_splitBlock(allocator, block, aligned_size);
-    if (ret != 0u) 
+    if (arena_affinity.set == set)
     {
-        fprintf(stderr, "MEM_allocatorMalloc: Failed to split block for variable '%s' (in %s:%d)\n", 
-                var_name, file, line);
-
-        errno       = EINVAL;
-        user_ptr    = NULL;
-
-        goto end_of_function;
+        arena_affinity.set = NULL;
     }
 
-    user_ptr = (void *)((uint8_t *)block + sizeof(block_header_t));
-
-    block->file = file;
-    block->line = line;
-    block->var_name = var_name;
-
-    MEM_printd("MEM_allocatorMalloc: Allocated %zu bytes for variable '%s' at %p (in %s:%d) using strategy %d.\n", 
-               size, var_name, user_ptr, file, line, strategy);
-
     /* Function Return */
 end_of_function:
-    return user_ptr;
+    return ret;
 }
 
 /**
- * @fn      MEM_validPointerCheck
+ * @fn      MEM_arenaSetSelect
  * @package MEM_alloc
  * 
- * @brief   Validates if a pointer is within the allocator's heap.
+ * @brief   Returns the arena the calling thread allocates from.
  *
- * @details Checks whether a given pointer falls within the allocator's heap range, is properly aligned,
- *          has a valid block header, and is marked as allocated.
+ * @details MEM_ARENA_BY_CPU and MEM_ARENA_BY_NODE map the current CPU or its NUMA node onto
+ *          the arenas on every call and fall back to the round-robin assignment when neither
+ *          can be queried.
+ *          MEM_ARENA_ROUND_ROBIN hands out arenas in turn on each thread's first call and
+ *          then keeps returning the same one.
  *
- * @param   [in]  allocator Pointer to the memory allocator structure.
- * @param   [in]  ptr       Pointer to validate.
+ * @param   [in/out] set Pointer to the arena set.
  *
- * @return  0 on success, error code on failure.
+ * @return  Pointer to the arena, or NULL if set is NULL or empty.
  */
-int MEM_validPointerCheck(mem_allocator_t *allocator, void *ptr) 
+mem_allocator_t *MEM_arenaSetSelect(mem_arena_set_t *set)
 {
     /* Definition of Function Variables */
-    int ret                 = 0u;
-
-    block_header_t *block   = NULL;
+    mem_allocator_t *arena  = NULL;
+    int cpu                 = -1;
+    unsigned node           = 0u;
 
     /* Check deference/argument boundaries */
-    if (allocator == NULL) 
-    {
-        errno = EINVAL;
-        ret = EINVAL;
-        goto end_of_function;
-    }
-
-    if (ptr == NULL) 
+    if (set == NULL || set->count == 0u)
     {
-        errno = EINVAL;
-        ret = EINVAL;
         goto end_of_function;
     }
-    
-    /* Assigning Initial Values for Variables */
-    heap_start  = (uintptr_t)(allocator->heap);
-    heap_end    = (heap_start + HEAP_SIZE);
-    user_ptr    = (uintptr_t)ptr;
 
     /* Start Function Logic */
-    if (user_ptr < heap_start + sizeof(block_header_t) || user_ptr >= heap_end) 
-    {
-        errno = EINVAL;
-        ret = EINVAL;
-        goto end_of_function;
-    }
-
-    if (((user_ptr - heap_start) % ALIGNMENT) != 0u) 
+    if (set->policy == MEM_ARENA_BY_CPU)
     {
-        errno = EINVAL;
-        ret = EINVAL;
-        goto end_of_function;
+        cpu = sched_getcpu();
+        if (cpu >= 0)
+        {
+            arena = &set->arenas[(size_t)cpu % set->count];
+            goto end_of_function;
+        }
     }
 
-    block = (block_header_t *)(user_ptr - sizeof(block_header_t));
-    if ((uintptr_t)block < heap_start || (uintptr_t)block >= heap_end) 
+#if defined(SYS_getcpu)
+    if (set->policy == MEM_ARENA_BY_NODE && syscall(SYS_getcpu, NULL, &node, NULL) == 0)
     {
-        errno = EINVAL;
-        ret = EINVAL;
+        arena = &set->arenas[(size_t)node % set->count];
         goto end_of_function;
     }
+#endif
 
-    if (block->free) 
+    if (arena_affinity.set != set)
     {
-        errno = EINVAL;
-        ret = EINVAL;
-        goto end_of_function;
+        arena_affinity.set      = set;
+        arena_affinity.index    = __atomic_fetch_add(&set->next_arena, 1u, __ATOMIC_RELAXED) % set->count;
     }
 
-    ret = 0u;
+    arena = &set->arenas[arena_affinity.index];
 
     /* Function Return */
 end_of_function:
-    return ret;
+    return arena;
 }
 
 /**
- * @fn      MEM_mergeBlocks
+ * @fn      MEM_arenaSetOwner
  * @package MEM_alloc
  * 
- * @brief   Merges adjacent free blocks to reduce fragmentation.
+ * @brief   Finds the arena whose heap contains a pointer.
  *
- * @details Combines a free block with its neighboring free blocks (if any) to create a larger contiguous free block.
- *          Updates the free list accordingly.
+ * @details Arenas of MEM_arenaSetInit slice the static heap in equal parts, so a pointer into
+ *          it maps to its arena with one division. Pointers into grown chunks, and every
+ *          pointer of a set built by MEM_arenaSetInitNodes, are looked up arena by arena. The
+ *          owner's MEM_validPointerCheck then tells whether ptr is a live block.
  *
- * @param   [in/out] allocator Pointer to the memory allocator structure.
- * @param   [in/out] block     Pointer to the block to be merged.
+ * @param   [in] set Pointer to the arena set.
+ * @param   [in] ptr Pointer returned by MEM_arenaSetMalloc.
  *
- * @return  0 on success, error code on failure.
+ * @return  Pointer to the owning arena, or NULL when no arena contains ptr.
  */
-int MEM_mergeBlocks(mem_allocator_t *allocator, block_header_t *block) 
+mem_allocator_t *MEM_arenaSetOwner(mem_arena_set_t *set, const void *ptr)
 {
     /* Definition of Function Variables */
-    int ret = 0u;
+    size_t index            = 0u;
+    size_t slice            = 0u;
+    mem_allocator_t *arena  = NULL;
+
+    uint8_t *segment_start  = NULL;
+    uint8_t *segment_end    = NULL;
 
-    block_header_t *next_block = NULL;
-    
     /* Check deference/argument boundaries */
-    if (allocator == NULL || block == NULL) 
+    if (set == NULL || ptr == NULL || set->count == 0u)
     {
-        ret = EINVAL;
         goto end_of_function;
     }
 
+    /* Assigning Initial Values for Variables */
+    slice = set->arenas[0].heap_size;
+
     /* Start Function Logic */
-    next_block = (block_header_t *)((uint8_t *)block + block->size);
-    if ((uint8_t *)next_block < allocator->heap + HEAP_SIZE && next_block->free) 
+    if (set->arenas[0].heap == heap_memory && (const uint8_t *)ptr >= heap_memory && (const uint8_t *)ptr < heap_memory + (slice * set->count))
     {
-        block->size += next_block->size;
-        block->next = next_block->next;
+        index = (size_t)((const uint8_t *)ptr - heap_memory) / slice;
 
-        if (next_block->next) 
+        if (MEM_heapSegment(&set->arenas[index], ptr, &segment_start, &segment_end))
         {
-            next_block->next->prev = block;
+            arena = &set->arenas[index];
         }
 
-        MEM_printd("MEM_mergeBlocks: Merged with next block. New size: %zu bytes.\n", block->size);
+        goto end_of_function;
     }
 
-    if (block->prev && block->prev->free) 
+    for (index = 0u; index < set->count; ++index)
     {
-        block->prev->size += block->size;
-        block->prev->next = block->next;
-
-        if (block->next) 
+        if (MEM_heapSegment(&set->arenas[index], ptr, &segment_start, &segment_end))
         {
-            block->next->prev = block->prev;
+            arena = &set->arenas[index];
+            break;
         }
+    }
+
+    /* Function Return */
+end_of_function:
+    return arena;
+}
+
+/**
+ * @fn      MEM_arenaSetMalloc
+ * @package MEM_alloc
+ * 
+ * @brief   Allocates memory from the calling thread's arena.
+ *
+ * @param   [in/out] set       Pointer to the arena set.
+ * @param   [in]     size      Size of memory to allocate.
+ * @param   [in]     file      Name of the file requesting the allocation.
+ * @param   [in]     line      Line number in the file requesting the allocation.
+ * @param   [in]     var_name  Name of the variable being allocated.
+ * @param   [in]     strategy  Allocation strategy to use.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_arenaSetMalloc(mem_arena_set_t *set, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy)
+{
+    /* Definition of Function Variables */
+    void *user_ptr          = NULL;
+    mem_allocator_t *arena  = NULL;
 
-        block = block->prev;
+    /* Assigning Initial Values for Variables */
+    arena = MEM_arenaSetSelect(set);
 
-        MEM_printd("MEM_mergeBlocks: Merged with previous block. New size: %zu bytes.\n", block->size);
+    /* Check deference/argument boundaries */
+    if (arena == NULL)
+    {
+        errno = EINVAL;
+        goto end_of_function;
     }
 
-    block->file     = NULL;
-    block->line     = 0u;
-    block->var_name = NULL;
+    /* Start Function Logic */
+    user_ptr = MEM_allocatorMalloc(arena, size, file, line, var_name, strategy);
 
     /* Function Return */
 end_of_function:
-    return ret;
+    return user_ptr;
 }
 
 /**
- * @fn      MEM_allocatorFree
+ * @fn      MEM_arenaSetFree
  * @package MEM_alloc
  * 
- * @brief   Frees allocated memory using the custom allocator.
- *
- * @details Marks a previously allocated block as free, clears its metadata, and attempts to merge it with
- *          adjacent free blocks to minimize fragmentation.
+ * @brief   Frees memory into the arena that owns it, whichever thread calls.
  *
- * @param   [in/out] allocator Pointer to the memory allocator structure.
+ * @param   [in/out] set       Pointer to the arena set.
  * @param   [in]     ptr       Pointer to the memory to free.
  * @param   [in]     file      Name of the file requesting the free operation.
  * @param   [in]     line      Line number in the file requesting the free operation.
  * @param   [in]     var_name  Name of the variable being freed.
  *
- * @return 0 on success, error code on failure.
+ * @return  0 on success, error code on failure.
  */
-int MEM_allocatorFree(mem_allocator_t *allocator, void *ptr, const char *file, int line, const char *var_name) 
+int MEM_arenaSetFree(mem_arena_set_t *set, void *ptr, const char *file, int line, const char *var_name)
 {
     /* Definition of Function Variables */
     int ret                 = 0u;
+    mem_allocator_t *arena  = NULL;
+
+    /* Assigning Initial Values for Variables */
+    arena = MEM_arenaSetOwner(set, ptr);
 
-    block_header_t *block   = NULL;
-    
     /* Check deference/argument boundaries */
-    if (allocator == NULL) 
+    if (arena == NULL)
     {
+        MEM_LOG_ERROR("MEM_arenaSetFree: Invalid pointer %p for variable '%s' (in %s:%d)\n", ptr, var_name, file, line);
         ret = EINVAL;
         goto end_of_function;
     }
 
     /* Start Function Logic */
-    ret = MEM_validPointerCheck(allocator, ptr);
-    if (ret != 0u) 
-    {
-        fprintf(stderr, "MEM_allocatorFree: Invalid pointer %p for variable '%s' (in %s:%d)\n", ptr, var_name, file, line);
-        goto end_of_function;
-    }
-
-    block = (block_header_t *)((uint8_t *)ptr - sizeof(block_header_t));
-
-    if (block->free) 
-    {
-        fprintf(stderr, "MEM_allocatorFree: Double free detected for %p (variable '%s') (in %s:%d)\n", ptr, var_name, file, line);
-        ret = EINVAL;
-        goto end_of_function;
-    }
-
-    block->free     = 1u;
-    block->file     = NULL;
-    block->line     = 0u;
-    block->var_name = NULL;
-
-    MEM_printd("MEM_allocatorFree: Freed %zu bytes for variable '%s' from %p (in %s:%d)\n", 
-               block->size - sizeof(block_header_t), 
-               var_name ? var_name : "N/A", 
-               ptr, file, line);
-
-    ret = MEM_mergeBlocks(allocator, block);
-    if (ret != 0u) 
-    {
-        fprintf(stderr, "MEM_allocatorFree: Failed to merge blocks (in %s:%d)\n", file, line);
-        goto end_of_function;
-    }
+    ret = MEM_allocatorFree(arena, ptr, file, line, var_name);
 
     /* Function Return */
 end_of_function:
@@ -714,10 +7391,15 @@ int MEM_allocatorPrintAll(mem_allocator_t *allocator)
     /* Definition of Function Variables */
     int ret = 0u;
 
-    uint8_t *current = NULL;
-    uint8_t *heap_end = NULL;
     block_header_t *block = NULL;
 
+    const char *file = NULL;
+    int line = 0;
+
+#if defined(_DEBUG_)
+    debug_entry_t *entry = NULL;
+#endif
+
     /* Check deference/argument boundaries */
     if (allocator == NULL) 
     {
@@ -726,27 +7408,44 @@ int MEM_allocatorPrintAll(mem_allocator_t *allocator)
     }
     
     /* Assigning Initial Values for Variables */
-    current     = allocator->heap;
-    heap_end    = allocator->heap + HEAP_SIZE;
+    block = (block_header_t *)allocator->heap;
     
     /* Start Function Logic */
+    MEM_lockHeap(allocator);
+
     printf("Allocation Table:\n");
     printf("Address\t\tSize\t\tFree\t\tFile:Line\n");
 
-    while (current < heap_end) 
+    while (block) 
     {
-        block = (block_header_t *)current;
+        file    = MEM_BLOCK_IS_FREE(block) ? "N/A" : "Unknown";
+        line    = 0;
+
+#if defined(_DEBUG_)
+        pthread_mutex_lock(&debug_lock);
+
+        entry = MEM_BLOCK_IS_FREE(block) ? NULL : MEM_debugLookup(block);
+        if (entry)
+        {
+            file = entry->file;
+            line = entry->line;
+        }
+
+        pthread_mutex_unlock(&debug_lock);
+#endif
 
         printf("%p\t\t%zu\t\t%s\t\t%s:%d\n",
-               (void *)(current + sizeof(block_header_t)),
-               block->size - sizeof(block_header_t),
-               block->free ? "Yes" : "No",
-               block->free ? "N/A" : (block->file ? block->file : "Unknown"),
-               block->free ? 0     : block->line);
+               (void *)((uint8_t *)block + sizeof(block_header_t)),
+               MEM_BLOCK_SIZE(block) - sizeof(block_header_t),
+               MEM_BLOCK_IS_FREE(block) ? "Yes" : "No",
+               file ? file : "Unknown",
+               line);
 
-        current += block->size;
+        block = MEM_nextHeapBlock(allocator, block);
     }
 
+    MEM_unlockHeap(allocator);
+
     /* Function Return */
 end_of_function:
     return ret;
@@ -0,0 +1,217 @@
+/**
+ *  @ingroup    MemoryManagement
+ *  @addtogroup MemoryArena MEM_arena
+ *  @{
+ *
+ *  @package    MEM_arena
+ *  @brief      Scoped bump-pointer arena for short-lived objects, built on top of MEM_alloc.
+ *
+ *  @file       libmemarena.c
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              The arena is an offset into one block of its allocator. Allocation rounds the
+ *              request with ALIGN and moves the offset, a mark is the offset itself, and a reset
+ *              frees the block and clears the offset. None of these touch the objects, their
+ *              headers or the allocator's free lists, so request-scoped data costs neither a
+ *              header per object nor a merge per free.
+ *
+ *  @see        - libmemarena.h
+ *              - libmemalloc.h
+ **/
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <string.h>
+#include <errno.h>
+
+/* implements: */
+#include <libmemarena.h>
+
+/**
+ * @fn      MEM_arenaInit
+ * @package MEM_arena
+ *
+ * @brief   Prepares a scoped arena of capacity bytes over an allocator.
+ *
+ * @param   [out]    arena     Pointer to the arena to initialize.
+ * @param   [in/out] allocator Initialized allocator backing the arena.
+ * @param   [in]     capacity  Bytes the arena can hand out before it is reset.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_arenaInit(mem_scope_arena_t *arena, mem_allocator_t *allocator, size_t capacity)
+{
+    /* Definition of Function Variables */
+    int ret = 0u;
+
+    /* Check deference/argument boundaries */
+    if (arena == NULL || allocator == NULL || capacity == 0u || capacity > SIZE_MAX - ARCH_ALIGNMENT)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    memset(arena, 0, sizeof(mem_scope_arena_t));
+
+    arena->allocator    = allocator;
+    arena->capacity     = ALIGN(capacity);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_arenaAlloc
+ * @package MEM_arena
+ *
+ * @brief   Allocates size bytes from the arena.
+ *
+ * @details Takes the arena block from the allocator on the first allocation after an init or
+ *          a reset. The block comes from MEM_allocatorMalloc, so its start and every rounded
+ *          offset are ARCH_ALIGNMENT aligned.
+ *
+ * @param   [in/out] arena Pointer to the arena.
+ * @param   [in]     size  Size of memory to allocate.
+ *
+ * @return  Pointer to the allocated memory, or NULL on failure.
+ */
+void *MEM_arenaAlloc(mem_scope_arena_t *arena, size_t size)
+{
+    /* Definition of Function Variables */
+    void *user_ptr      = NULL;
+    size_t aligned_size = 0u;
+
+    /* Check deference/argument boundaries */
+    if (arena == NULL || arena->allocator == NULL || size == 0u)
+    {
+        errno = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    if (size > arena->capacity - arena->offset)
+    {
+        errno = ENOMEM;
+        goto end_of_function;
+    }
+
+    aligned_size = ALIGN(size);
+
+    /* Start Function Logic */
+    if (arena->base == NULL)
+    {
+        arena->base = MEM_allocatorMalloc(arena->allocator, arena->capacity, __FILE__, __LINE__, "arena_block", TLSF_FIT);
+        if (arena->base == NULL)
+        {
+            errno = ENOMEM;
+            goto end_of_function;
+        }
+    }
+
+    user_ptr        = arena->base + arena->offset;
+    arena->offset   += aligned_size;
+
+    if (arena->offset > arena->peak)
+    {
+        arena->peak = arena->offset;
+    }
+
+    /* Function Return */
+end_of_function:
+    return user_ptr;
+}
+
+/**
+ * @fn      MEM_arenaMark
+ * @package MEM_arena
+ *
+ * @brief   Takes a checkpoint of the arena.
+ *
+ * @param   [in] arena Pointer to the arena.
+ *
+ * @return  Mark to pass to MEM_arenaRewind, 0 for a NULL arena.
+ */
+size_t MEM_arenaMark(const mem_scope_arena_t *arena)
+{
+    /* Function Return */
+    return (arena != NULL) ? arena->offset : 0u;
+}
+
+/**
+ * @fn      MEM_arenaRewind
+ * @package MEM_arena
+ *
+ * @brief   Releases everything allocated since a checkpoint.
+ *
+ * @details Moves the offset back; the block stays with the arena.
+ *
+ * @param   [in/out] arena Pointer to the arena.
+ * @param   [in]     mark  Mark returned by MEM_arenaMark since the last reset.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_arenaRewind(mem_scope_arena_t *arena, size_t mark)
+{
+    /* Definition of Function Variables */
+    int ret = 0u;
+
+    /* Check deference/argument boundaries */
+    if (arena == NULL || mark > arena->offset)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    arena->offset = mark;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_arenaReset
+ * @package MEM_arena
+ *
+ * @brief   Releases every object of the arena and returns its block to the allocator.
+ *
+ * @param   [in/out] arena Pointer to the arena.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_arenaReset(mem_scope_arena_t *arena)
+{
+    /* Definition of Function Variables */
+    int ret = 0u;
+
+    /* Check deference/argument boundaries */
+    if (arena == NULL || arena->allocator == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    if (arena->base != NULL)
+    {
+        ret = MEM_allocatorFree(arena->allocator, arena->base, __FILE__, __LINE__, "arena_block");
+    }
+
+    arena->base     = NULL;
+    arena->offset   = 0u;
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/*** end of file ***/
@@ -0,0 +1,844 @@
+/**
+ *  @ingroup    MemoryManagement
+ *  @addtogroup MemoryPreload MEM_preload
+ *  @{
+ *
+ *  @package    MEM_preload
+ *  @brief      Drop-in replacement of the C allocation functions, for use through LD_PRELOAD.
+ *
+ *  @file       libmempreload.c
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              Exports malloc, free, calloc, realloc, posix_memalign, aligned_alloc, memalign
+ *              and malloc_usable_size on top of one process-wide, thread-safe mem_allocator_t,
+ *              so unmodified binaries can run on the library:
+ *
+ *                  LD_PRELOAD=bin/libmemalloc_preload.so ./program
+ *
+ *              The allocator is set up by the first call into any of these functions. Calls the
+ *              setting-up thread makes meanwhile, directly or from a library it uses, are served
+ *              from a small static bootstrap buffer instead of recursing, and other threads wait
+ *              for the setup to finish. Bootstrap blocks are never reused.
+ *
+ *              This file is built only into bin/libmemalloc_preload.so (make preload); the
+ *              regular libraries keep the C allocation functions of the host.
+ *
+ *  @see        - libmemalloc.h
+ **/
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <string.h>
+#include <errno.h>
+#include <stdio.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/* implements: */
+#include <libmemalloc.h>
+
+/* =================================
+ *         PRIVATE DEFINES         *
+ * ================================*/
+
+/**
+ * @def MEM_PRELOAD_HEAP_SIZE
+ * @package MEM_preload
+ *
+ * @brief Size of the anonymous mapping the process-wide heap starts with.
+ *
+ * @details Pages are only backed once touched, so a large reservation costs address space
+ *          rather than memory.
+ */
+#ifndef MEM_PRELOAD_HEAP_SIZE
+    #define MEM_PRELOAD_HEAP_SIZE (256UL * 1024UL * 1024UL)
+#endif
+
+/**
+ * @def MEM_PRELOAD_CHUNK_SIZE
+ * @package MEM_preload
+ *
+ * @brief Minimum size of each chunk the heap grows by once the initial mapping is full.
+ */
+#ifndef MEM_PRELOAD_CHUNK_SIZE
+    #define MEM_PRELOAD_CHUNK_SIZE (256UL * 1024UL * 1024UL)
+#endif
+
+/**
+ * @def MEM_PRELOAD_RELEASE_THRESHOLD
+ * @package MEM_preload
+ *
+ * @brief Bytes of empty grown chunks kept mapped for reuse before they are returned.
+ */
+#ifndef MEM_PRELOAD_RELEASE_THRESHOLD
+    #define MEM_PRELOAD_RELEASE_THRESHOLD MEM_PRELOAD_CHUNK_SIZE
+#endif
+
+/**
+ * @def MEM_PRELOAD_STRATEGY
+ * @package MEM_preload
+ *
+ * @brief Allocation strategy used for every request.
+ */
+#ifndef MEM_PRELOAD_STRATEGY
+    #define MEM_PRELOAD_STRATEGY TLSF_FIT
+#endif
+
+/**
+ * @def MEM_PRELOAD_BOOTSTRAP_SIZE
+ * @package MEM_preload
+ *
+ * @brief Size of the static buffer serving allocations made while the allocator is set up.
+ */
+#ifndef MEM_PRELOAD_BOOTSTRAP_SIZE
+    #define MEM_PRELOAD_BOOTSTRAP_SIZE (64U * 1024U)
+#endif
+
+/**
+ * @def MEM_PRELOAD_LOG_LEVEL
+ * @package MEM_preload
+ *
+ * @brief Most verbose level the preload log hook writes, MEM_LOG_LEVEL_NONE by default.
+ *
+ * @details A drop-in malloc reports failures through NULL and errno only, so the host program's
+ *          standard error stays quiet unless this or MEM_PRELOAD_LOG_ENV raises the level.
+ *          Levels above MEM_LOG_LEVEL_WARN are treated as MEM_LOG_LEVEL_WARN.
+ */
+#ifndef MEM_PRELOAD_LOG_LEVEL
+    #define MEM_PRELOAD_LOG_LEVEL MEM_LOG_LEVEL_NONE
+#endif
+
+/**
+ * @def MEM_PRELOAD_LOG_ENV
+ * @package MEM_preload
+ *
+ * @brief Environment variable holding a log level that overrides MEM_PRELOAD_LOG_LEVEL.
+ */
+#define MEM_PRELOAD_LOG_ENV "MEMALLOC_PRELOAD_LOG"
+
+/**
+ * @def MEM_PRELOAD_LOG_SIZE
+ * @package MEM_preload
+ *
+ * @brief Longest log line written by the preload log hook.
+ */
+#ifndef MEM_PRELOAD_LOG_SIZE
+    #define MEM_PRELOAD_LOG_SIZE (512U)
+#endif
+
+/**
+ * @def MEM_PRELOAD_EXPORT
+ * @package MEM_preload
+ *
+ * @brief Keeps the replacement functions visible under -fvisibility=hidden.
+ */
+#define MEM_PRELOAD_EXPORT __attribute__((visibility("default")))
+
+_Static_assert((MEM_PRELOAD_BOOTSTRAP_SIZE % ARCH_ALIGNMENT) == 0, "MEM_PRELOAD_BOOTSTRAP_SIZE must be a multiple of ARCH_ALIGNMENT");
+
+/* =================================
+ *     PRIVATE DATA STRUCTURES     *
+ * ================================*/
+
+/**
+ * @enum    mem_preload_state
+ * @package MEM_preload
+ *
+ * @typedef mem_preload_state_t
+ *
+ * @brief   Setup state of the process-wide allocator.
+ */
+typedef enum
+{
+    MEM_PRELOAD_UNINITIALIZED   = (uint8_t)(0u),        /**< No call has been made yet */
+    MEM_PRELOAD_INITIALIZING    = (uint8_t)(1u),        /**< One thread is setting the allocator up */
+    MEM_PRELOAD_READY           = (uint8_t)(2u),        /**< The allocator serves every request */
+    MEM_PRELOAD_FAILED          = (uint8_t)(3u)         /**< Setup failed, every request fails with ENOMEM */
+} mem_preload_state_t;
+
+/* =================================
+ *     PRIVATE GLOBAL VARIABLE     *
+ * ================================*/
+
+/**
+ * @var     preload_allocator
+ * @package MEM_preload
+ *
+ * @brief   Process-wide allocator behind the replacement functions.
+ */
+static mem_allocator_t preload_allocator;
+
+/**
+ * @var     preload_state
+ * @package MEM_preload
+ *
+ * @brief   Setup state of preload_allocator, a mem_preload_state_t.
+ */
+static int preload_state = MEM_PRELOAD_UNINITIALIZED;
+
+/**
+ * @var     preload_bootstrapping
+ * @package MEM_preload
+ *
+ * @brief   Set on the thread running the setup, so its nested calls use the bootstrap buffer.
+ */
+static _Thread_local int preload_bootstrapping;
+
+/**
+ * @var     preload_bootstrap
+ * @package MEM_preload
+ *
+ * @brief   Bootstrap buffer and the bytes of it handed out.
+ *
+ * @details Each bootstrap block is preceded by ARCH_ALIGNMENT bytes holding its size, for
+ *          realloc and malloc_usable_size.
+ */
+static uint8_t preload_bootstrap[MEM_PRELOAD_BOOTSTRAP_SIZE] __attribute__((aligned(ARCH_ALIGNMENT)));
+static size_t preload_bootstrap_used;
+
+/**
+ * @var     preload_log_level
+ * @package MEM_preload
+ *
+ * @brief   Most verbose level MEM_preloadLog writes, set once by MEM_preloadSetup.
+ */
+static int preload_log_level = MEM_PRELOAD_LOG_LEVEL;
+
+/* =================================
+ *   PRIVATE FUNCTION DECLARATION  *
+ * ================================*/
+
+/**
+ * @fn      MEM_preloadLog
+ * @package MEM_preload
+ *
+ * @brief   Log hook writing straight to standard error.
+ *
+ * @details Formats into a stack buffer and issues one write, so a message logged from inside
+ *          malloc never allocates a stdio buffer. Only messages up to preload_log_level, at most
+ *          errors and warnings, are written; the standard output of the host program is left
+ *          alone.
+ *
+ * @param   [in] level   Level of the message.
+ * @param   [in] format  Format string.
+ * @param   [in] args    Arguments corresponding to the format string.
+ * @param   [in] context Unused.
+ */
+static void MEM_preloadLog(int level, const char *format, va_list args, void *context)
+{
+    /* Definition of Function Variables */
+    char line[MEM_PRELOAD_LOG_SIZE];
+    int length = 0;
+
+    /* Check deference/argument boundaries */
+    if (level > preload_log_level || level > MEM_LOG_LEVEL_WARN)
+    {
+        return;
+    }
+
+    /* Start Function Logic */
+    (void)context;
+
+    length = vsnprintf(line, sizeof(line), format, args);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    if ((size_t)length >= sizeof(line))
+    {
+        length = (int)sizeof(line) - 1;
+    }
+
+    (void)!write(STDERR_FILENO, line, (size_t)length);
+}
+
+/**
+ * @fn      MEM_preloadForkPrepare
+ * @package MEM_preload
+ *
+ * @brief   Takes the heap lock before fork, so the child never inherits it held.
+ */
+static void MEM_preloadForkPrepare(void)
+{
+    /* Start Function Logic */
+    pthread_mutex_lock(&preload_allocator.lock);
+}
+
+/**
+ * @fn      MEM_preloadForkRelease
+ * @package MEM_preload
+ *
+ * @brief   Releases the heap lock in the parent and in the child after fork.
+ */
+static void MEM_preloadForkRelease(void)
+{
+    /* Start Function Logic */
+    pthread_mutex_unlock(&preload_allocator.lock);
+}
+
+/**
+ * @fn      MEM_preloadSetup
+ * @package MEM_preload
+ *
+ * @brief   Sets the process-wide allocator up.
+ *
+ * @details Runs once, on the thread that won the transition out of
+ *          MEM_PRELOAD_UNINITIALIZED. MEM_PRELOAD_LOG_ENV, when set to a level, overrides
+ *          MEM_PRELOAD_LOG_LEVEL; at MEM_LOG_LEVEL_NONE no hook is installed and messages are
+ *          dropped before they are formatted. The fork handlers are registered only once the
+ *          allocator is ready, since registering them may itself allocate.
+ */
+static void MEM_preloadSetup(void)
+{
+    /* Definition of Function Variables */
+    int ret             = 0u;
+    const char *level   = NULL;
+
+    /* Assigning Initial Values for Variables */
+    level = getenv(MEM_PRELOAD_LOG_ENV);
+
+    if (level != NULL && level[0] >= '0' && level[0] <= '9')
+    {
+        preload_log_level = level[0] - '0';
+    }
+
+    /* Start Function Logic */
+    preload_bootstrapping = 1;
+
+    MEM_logSetHook((preload_log_level > MEM_LOG_LEVEL_NONE) ? MEM_preloadLog : NULL, NULL);
+
+    ret = MEM_allocatorInitMmap(&preload_allocator, MEM_PRELOAD_HEAP_SIZE);
+    if (ret == 0u)
+    {
+        ret = MEM_allocatorSetGrowth(&preload_allocator, NULL, MEM_PRELOAD_CHUNK_SIZE, MEM_PRELOAD_RELEASE_THRESHOLD);
+    }
+
+    if (ret == 0u)
+    {
+        ret = MEM_allocatorSetThreadSafe(&preload_allocator, 1);
+    }
+
+    __atomic_store_n(&preload_state, (ret == 0u) ? MEM_PRELOAD_READY : MEM_PRELOAD_FAILED, __ATOMIC_RELEASE);
+
+    preload_bootstrapping = 0;
+
+    if (ret == 0u)
+    {
+        (void)pthread_atfork(MEM_preloadForkPrepare, MEM_preloadForkRelease, MEM_preloadForkRelease);
+    }
+}
+
+/**
+ * @fn      MEM_preloadAllocator
+ * @package MEM_preload
+ *
+ * @brief   Returns the process-wide allocator, setting it up on first use.
+ *
+ * @param   [out] bootstrap Set to non-zero when the call must be served from the bootstrap
+ *                          buffer instead.
+ *
+ * @return  Pointer to the allocator, or NULL when it is not available.
+ */
+static mem_allocator_t *MEM_preloadAllocator(int *bootstrap)
+{
+    /* Definition of Function Variables */
+    mem_allocator_t *allocator  = NULL;
+
+    int state                   = MEM_PRELOAD_UNINITIALIZED;
+
+    /* Assigning Initial Values for Variables */
+    *bootstrap  = 0;
+    state       = __atomic_load_n(&preload_state, __ATOMIC_ACQUIRE);
+
+    /* Start Function Logic */
+    if (state == MEM_PRELOAD_READY)
+    {
+        allocator = &preload_allocator;
+        goto end_of_function;
+    }
+
+    if (preload_bootstrapping)
+    {
+        *bootstrap = 1;
+        goto end_of_function;
+    }
+
+    if (state == MEM_PRELOAD_UNINITIALIZED
+        && __atomic_compare_exchange_n(&preload_state, &state, MEM_PRELOAD_INITIALIZING, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+        MEM_preloadSetup();
+    }
+
+    while ((state = __atomic_load_n(&preload_state, __ATOMIC_ACQUIRE)) == MEM_PRELOAD_INITIALIZING)
+    {
+        sched_yield();
+    }
+
+    if (state == MEM_PRELOAD_READY)
+    {
+        allocator = &preload_allocator;
+    }
+
+    /* Function Return */
+end_of_function:
+    return allocator;
+}
+
+/**
+ * @fn      MEM_preloadIsBootstrap
+ * @package MEM_preload
+ *
+ * @brief   Tells whether a pointer lies in the bootstrap buffer.
+ *
+ * @param   [in] ptr Pointer to check.
+ *
+ * @return  Non-zero for a bootstrap block.
+ */
+static int MEM_preloadIsBootstrap(const void *ptr)
+{
+    /* Function Return */
+    return (const uint8_t *)ptr >= preload_bootstrap
+        && (const uint8_t *)ptr < preload_bootstrap + MEM_PRELOAD_BOOTSTRAP_SIZE;
+}
+
+/**
+ * @fn      MEM_preloadBootstrapSize
+ * @package MEM_preload
+ *
+ * @brief   Returns the size recorded in front of a bootstrap block.
+ *
+ * @param   [in] ptr Bootstrap block.
+ *
+ * @return  Usable size of the block.
+ */
+static size_t MEM_preloadBootstrapSize(const void *ptr)
+{
+    /* Definition of Function Variables */
+    size_t size = 0u;
+
+    /* Start Function Logic */
+    memcpy(&size, (const uint8_t *)ptr - ARCH_ALIGNMENT, sizeof(size_t));
+
+    /* Function Return */
+    return size;
+}
+
+/**
+ * @fn      MEM_preloadBootstrapAlloc
+ * @package MEM_preload
+ *
+ * @brief   Serves an allocation from the bootstrap buffer.
+ *
+ * @details Blocks are aligned to alignment and never freed; a buffer running out fails with
+ *          ENOMEM.
+ *
+ * @param   [in] alignment Power-of-two alignment, at least ARCH_ALIGNMENT.
+ * @param   [in] size      Size of memory to allocate.
+ * @param   [in] zero      Non-zero to clear the block.
+ *
+ * @return  Pointer to the allocated memory, or NULL on failure.
+ */
+static void *MEM_preloadBootstrapAlloc(size_t alignment, size_t size, int zero)
+{
+    /* Definition of Function Variables */
+    void *user_ptr  = NULL;
+
+    size_t used     = 0u;
+    size_t start    = 0u;
+    size_t end      = 0u;
+
+    /* Check deference/argument boundaries */
+    if (size > MEM_PRELOAD_BOOTSTRAP_SIZE || alignment > MEM_PRELOAD_BOOTSTRAP_SIZE)
+    {
+        errno = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    used = __atomic_load_n(&preload_bootstrap_used, __ATOMIC_RELAXED);
+
+    /* Start Function Logic */
+    do
+    {
+        start   = (used + ARCH_ALIGNMENT + alignment - 1u) & ~(alignment - 1u);
+        end     = start + ALIGN(size);
+
+        if (end > MEM_PRELOAD_BOOTSTRAP_SIZE)
+        {
+            errno = ENOMEM;
+            goto end_of_function;
+        }
+    } while (!__atomic_compare_exchange_n(&preload_bootstrap_used, &used, end, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    user_ptr = preload_bootstrap + start;
+    memcpy((uint8_t *)user_ptr - ARCH_ALIGNMENT, &size, sizeof(size_t));
+
+    if (zero)
+    {
+        memset(user_ptr, 0, size);
+    }
+
+    /* Function Return */
+end_of_function:
+    return user_ptr;
+}
+
+/**
+ * @fn      MEM_preloadMemalign
+ * @package MEM_preload
+ *
+ * @brief   Shared body of the aligned allocation functions.
+ *
+ * @param   [in] alignment Power-of-two alignment.
+ * @param   [in] size      Size of memory to allocate, 0 for a minimum-size block.
+ *
+ * @return  Pointer to the allocated memory, or NULL with errno set on failure.
+ */
+static void *MEM_preloadMemalign(size_t alignment, size_t size)
+{
+    /* Definition of Function Variables */
+    void *user_ptr              = NULL;
+
+    int bootstrap               = 0;
+    mem_allocator_t *allocator  = NULL;
+
+    /* Assigning Initial Values for Variables */
+    allocator = MEM_preloadAllocator(&bootstrap);
+
+    if (size == 0u)
+    {
+        size = 1u;
+    }
+
+    if (alignment < ARCH_ALIGNMENT)
+    {
+        alignment = ARCH_ALIGNMENT;
+    }
+
+    /* Start Function Logic */
+    if (bootstrap)
+    {
+        user_ptr = MEM_preloadBootstrapAlloc(alignment, size, 0);
+    }
+    else if (allocator != NULL)
+    {
+        user_ptr = MEM_allocatorMemalign(allocator, alignment, size, __FILE__, __LINE__, "memalign", MEM_PRELOAD_STRATEGY);
+    }
+
+    if (user_ptr == NULL)
+    {
+        errno = ENOMEM;
+    }
+
+    /* Function Return */
+    return user_ptr;
+}
+
+/* =================================
+ *   EXPORTED FUNCTION DEFINITION  *
+ * ================================*/
+
+/**
+ * @fn      malloc
+ * @package MEM_preload
+ *
+ * @brief   Allocates size bytes; malloc(0) returns a unique, minimum-size block.
+ */
+MEM_PRELOAD_EXPORT void *malloc(size_t size)
+{
+    /* Definition of Function Variables */
+    void *user_ptr              = NULL;
+
+    int bootstrap               = 0;
+    mem_allocator_t *allocator  = NULL;
+
+    /* Assigning Initial Values for Variables */
+    allocator = MEM_preloadAllocator(&bootstrap);
+
+    if (size == 0u)
+    {
+        size = 1u;
+    }
+
+    /* Start Function Logic */
+    if (bootstrap)
+    {
+        user_ptr = MEM_preloadBootstrapAlloc(ARCH_ALIGNMENT, size, 0);
+    }
+    else if (allocator != NULL)
+    {
+        user_ptr = MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, "malloc", MEM_PRELOAD_STRATEGY);
+    }
+
+    if (user_ptr == NULL)
+    {
+        errno = ENOMEM;
+    }
+
+    /* Function Return */
+    return user_ptr;
+}
+
+/**
+ * @fn      free
+ * @package MEM_preload
+ *
+ * @brief   Frees a block; bootstrap blocks and NULL are ignored.
+ */
+MEM_PRELOAD_EXPORT void free(void *ptr)
+{
+    /* Definition of Function Variables */
+    int bootstrap               = 0;
+    mem_allocator_t *allocator  = NULL;
+
+    /* Check deference/argument boundaries */
+    if (ptr == NULL || MEM_preloadIsBootstrap(ptr))
+    {
+        return;
+    }
+
+    /* Assigning Initial Values for Variables */
+    allocator = MEM_preloadAllocator(&bootstrap);
+
+    /* Start Function Logic */
+    if (allocator != NULL)
+    {
+        (void)MEM_allocatorFree(allocator, ptr, __FILE__, __LINE__, "free");
+    }
+}
+
+/**
+ * @fn      calloc
+ * @package MEM_preload
+ *
+ * @brief   Allocates a cleared array of nmemb elements of size bytes.
+ */
+MEM_PRELOAD_EXPORT void *calloc(size_t nmemb, size_t size)
+{
+    /* Definition of Function Variables */
+    void *user_ptr              = NULL;
+
+    int bootstrap               = 0;
+    mem_allocator_t *allocator  = NULL;
+
+    /* Check deference/argument boundaries */
+    if (size != 0u && nmemb > SIZE_MAX / size)
+    {
+        errno = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    allocator = MEM_preloadAllocator(&bootstrap);
+
+    if (nmemb == 0u || size == 0u)
+    {
+        nmemb   = 1u;
+        size    = 1u;
+    }
+
+    /* Start Function Logic */
+    if (bootstrap)
+    {
+        user_ptr = MEM_preloadBootstrapAlloc(ARCH_ALIGNMENT, nmemb * size, 1);
+    }
+    else if (allocator != NULL)
+    {
+        user_ptr = MEM_allocatorCalloc(allocator, nmemb, size, __FILE__, __LINE__, "calloc", MEM_PRELOAD_STRATEGY);
+    }
+
+    if (user_ptr == NULL)
+    {
+        errno = ENOMEM;
+    }
+
+    /* Function Return */
+end_of_function:
+    return user_ptr;
+}
+
+/**
+ * @fn      realloc
+ * @package MEM_preload
+ *
+ * @brief   Resizes a block; realloc(NULL, size) allocates and realloc(ptr, 0) frees.
+ *
+ * @details Bootstrap blocks are moved to the allocator by copying them.
+ */
+MEM_PRELOAD_EXPORT void *realloc(void *ptr, size_t size)
+{
+    /* Definition of Function Variables */
+    void *user_ptr              = NULL;
+
+    int bootstrap               = 0;
+    size_t old_size             = 0u;
+    mem_allocator_t *allocator  = NULL;
+
+    /* Start Function Logic */
+    if (ptr == NULL)
+    {
+        user_ptr = malloc(size);
+        goto end_of_function;
+    }
+
+    if (MEM_preloadIsBootstrap(ptr))
+    {
+        old_size = MEM_preloadBootstrapSize(ptr);
+
+        if (size == 0u)
+        {
+            goto end_of_function;
+        }
+
+        user_ptr = malloc(size);
+        if (user_ptr != NULL)
+        {
+            memcpy(user_ptr, ptr, (old_size < size) ? old_size : size);
+        }
+
+        goto end_of_function;
+    }
+
+    allocator = MEM_preloadAllocator(&bootstrap);
+    if (allocator == NULL)
+    {
+        errno = ENOMEM;
+        goto end_of_function;
+    }
+
+    user_ptr = MEM_allocatorRealloc(allocator, ptr, size, __FILE__, __LINE__, "realloc", MEM_PRELOAD_STRATEGY);
+    if (user_ptr == NULL && size != 0u)
+    {
+        errno = ENOMEM;
+    }
+
+    /* Function Return */
+end_of_function:
+    return user_ptr;
+}
+
+/**
+ * @fn      posix_memalign
+ * @package MEM_preload
+ *
+ * @brief   Allocates size bytes aligned to alignment into *memptr.
+ *
+ * @return  0 on success, EINVAL for an alignment that is not a power of two multiple of
+ *          sizeof(void *), ENOMEM when out of memory.
+ */
+MEM_PRELOAD_EXPORT int posix_memalign(void **memptr, size_t alignment, size_t size)
+{
+    /* Definition of Function Variables */
+    int ret         = 0u;
+    int saved_errno = errno;
+
+    void *user_ptr  = NULL;
+
+    /* Check deference/argument boundaries */
+    if (alignment < sizeof(void *) || (alignment & (alignment - 1u)) != 0u)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    user_ptr = MEM_preloadMemalign(alignment, size);
+    if (user_ptr == NULL)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    *memptr = user_ptr;
+
+    /* Function Return */
+end_of_function:
+    errno = saved_errno;
+    return ret;
+}
+
+/**
+ * @fn      aligned_alloc
+ * @package MEM_preload
+ *
+ * @brief   Allocates size bytes aligned to a power-of-two alignment.
+ */
+MEM_PRELOAD_EXPORT void *aligned_alloc(size_t alignment, size_t size)
+{
+    /* Definition of Function Variables */
+    void *user_ptr = NULL;
+
+    /* Check deference/argument boundaries */
+    if (alignment == 0u || (alignment & (alignment - 1u)) != 0u)
+    {
+        errno = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    user_ptr = MEM_preloadMemalign(alignment, size);
+
+    /* Function Return */
+end_of_function:
+    return user_ptr;
+}
+
+/**
+ * @fn      memalign
+ * @package MEM_preload
+ *
+ * @brief   Obsolete spelling of aligned_alloc, still used by older binaries.
+ */
+MEM_PRELOAD_EXPORT void *memalign(size_t alignment, size_t size)
+{
+    /* Function Return */
+    return aligned_alloc(alignment, size);
+}
+
+/**
+ * @fn      malloc_usable_size
+ * @package MEM_preload
+ *
+ * @brief   Returns the number of bytes usable in a block, 0 for NULL or a foreign pointer.
+ */
+MEM_PRELOAD_EXPORT size_t malloc_usable_size(void *ptr)
+{
+    /* Definition of Function Variables */
+    size_t usable_size          = 0u;
+
+    int bootstrap               = 0;
+    mem_allocator_t *allocator  = NULL;
+
+    /* Check deference/argument boundaries */
+    if (ptr == NULL)
+    {
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    if (MEM_preloadIsBootstrap(ptr))
+    {
+        usable_size = MEM_preloadBootstrapSize(ptr);
+        goto end_of_function;
+    }
+
+    allocator = MEM_preloadAllocator(&bootstrap);
+    if (allocator != NULL)
+    {
+        usable_size = MEM_allocatorUsableSize(allocator, ptr);
+    }
+
+    /* Function Return */
+end_of_function:
+    return usable_size;
+}
+
+/*** end of file ***/
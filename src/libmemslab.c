@@ -0,0 +1,609 @@
+/**
+ *  @ingroup    MemoryManagement
+ *  @addtogroup MemorySlab MEM_slab
+ *  @{
+ *
+ *  @package    MEM_slab
+ *  @brief      Fixed-size slab sub-allocator for small objects, built on top of MEM_alloc.
+ *
+ *  @file       libmemslab.c
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              The cache region is split into MEM_SLAB_PAGE_SIZE pages. The page of a pointer is
+ *              found by dividing its offset in the region, and each page descriptor keeps a
+ *              bitmap of its free slots: allocation is a find-first-set over a few words, free
+ *              is a bit set, and neither touches the objects themselves. Pages are assigned to a
+ *              class on demand and handed back to the shared page pool once empty, unless they
+ *              are the last partial page of their class.
+ *
+ *  @see        - libmemslab.h
+ *              - libmemalloc.h
+ **/
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <string.h>
+#include <errno.h>
+
+/* implements: */
+#include <libmemslab.h>
+
+/* =================================
+ *         PRIVATE DEFINES         *
+ * ================================*/
+
+/**
+ * @def MEM_SLAB_MAP_WORDS
+ * @package MEM_slab
+ *
+ * @brief Number of 64-bit words in a page bitmap, enough for the smallest class.
+ */
+#define MEM_SLAB_MAP_WORDS (((MEM_SLAB_PAGE_SIZE >> MEM_SLAB_MIN_SHIFT) + 63U) / 64U)
+
+/**
+ * @def MEM_SLAB_NO_CLASS
+ * @package MEM_slab
+ *
+ * @brief Class index of a page that belongs to the free page pool.
+ */
+#define MEM_SLAB_NO_CLASS (MEM_SLAB_NUM_CLASSES)
+
+_Static_assert((MEM_SLAB_PAGE_SIZE & (MEM_SLAB_PAGE_SIZE - 1U)) == 0, "MEM_SLAB_PAGE_SIZE must be a power of two");
+_Static_assert(MEM_SLAB_MAX_SIZE <= MEM_SLAB_PAGE_SIZE, "The largest slab class must fit in a page");
+
+/* =================================
+ *     PRIVATE DATA STRUCTURES     *
+ * ================================*/
+
+/**
+ * @struct  mem_slab_page
+ * @package MEM_slab
+ *
+ * @typedef mem_slab_page_t
+ *
+ * @brief   Descriptor of one slab page, stored outside the page.
+ */
+typedef struct mem_slab_page
+{
+    struct mem_slab_page *next;                         /**< Next page in the partial list or the free page pool */
+    struct mem_slab_page *prev;                         /**< Previous page in the partial list */
+
+    uint64_t free_map[MEM_SLAB_MAP_WORDS];              /**< Bit i set while slot i is free */
+
+    uint32_t used;                                      /**< Number of allocated slots */
+    uint32_t size_class;                                /**< Class served by the page, MEM_SLAB_NO_CLASS when unassigned */
+} mem_slab_page_t;
+
+/* =================================
+ *   PRIVATE FUNCTION DECLARATION  *
+ * ================================*/
+
+/**
+ * @fn      MEM_slabClassOf
+ * @package MEM_slab
+ *
+ * @brief   Maps a request size to its slab class.
+ *
+ * @param   [in] size Requested size, at most MEM_SLAB_MAX_SIZE.
+ *
+ * @return  Class index in [0, MEM_SLAB_NUM_CLASSES).
+ */
+static uint32_t MEM_slabClassOf(size_t size)
+{
+    /* Function Return */
+    return (size <= ((size_t)1u << MEM_SLAB_MIN_SHIFT)) ? 0u :
+           (uint32_t)(64 - __builtin_clzll((unsigned long long)(size - 1u))) - MEM_SLAB_MIN_SHIFT;
+}
+
+/**
+ * @fn      MEM_slabSlotsPerPage
+ * @package MEM_slab
+ *
+ * @brief   Number of slots a page holds for a class.
+ *
+ * @param   [in] size_class Class index.
+ *
+ * @return  Slot count.
+ */
+static uint32_t MEM_slabSlotsPerPage(uint32_t size_class)
+{
+    /* Function Return */
+    return (uint32_t)(MEM_SLAB_PAGE_SIZE >> (MEM_SLAB_MIN_SHIFT + size_class));
+}
+
+/**
+ * @fn      MEM_slabPageBase
+ * @package MEM_slab
+ *
+ * @brief   Address of the memory described by a page descriptor.
+ *
+ * @param   [in] cache Pointer to the slab cache.
+ * @param   [in] page  Pointer to the page descriptor.
+ *
+ * @return  First byte of the page.
+ */
+static uint8_t *MEM_slabPageBase(const mem_slab_cache_t *cache, const mem_slab_page_t *page)
+{
+    /* Function Return */
+    return cache->region + ((size_t)(page - cache->pages) * MEM_SLAB_PAGE_SIZE);
+}
+
+/**
+ * @fn      MEM_slabLock
+ * @package MEM_slab
+ *
+ * @brief   Acquires the cache when its allocator is thread-safe.
+ *
+ * @param   [in/out] cache Pointer to the slab cache.
+ */
+static void MEM_slabLock(mem_slab_cache_t *cache)
+{
+    /* Start Function Logic */
+    if (cache->allocator->thread_safe)
+    {
+        pthread_mutex_lock(&cache->lock);
+    }
+}
+
+/**
+ * @fn      MEM_slabUnlock
+ * @package MEM_slab
+ *
+ * @brief   Releases the cache acquired by MEM_slabLock.
+ *
+ * @param   [in/out] cache Pointer to the slab cache.
+ */
+static void MEM_slabUnlock(mem_slab_cache_t *cache)
+{
+    /* Start Function Logic */
+    if (cache->allocator->thread_safe)
+    {
+        pthread_mutex_unlock(&cache->lock);
+    }
+}
+
+/**
+ * @fn      MEM_slabPartialPush
+ * @package MEM_slab
+ *
+ * @brief   Links a page at the head of the partial list of its class.
+ *
+ * @param   [in/out] cache Pointer to the slab cache.
+ * @param   [in/out] page  Pointer to the page descriptor.
+ */
+static void MEM_slabPartialPush(mem_slab_cache_t *cache, mem_slab_page_t *page)
+{
+    /* Definition of Function Variables */
+    mem_slab_page_t **head = NULL;
+
+    /* Assigning Initial Values for Variables */
+    head = &cache->partial[page->size_class];
+
+    /* Start Function Logic */
+    page->prev = NULL;
+    page->next = *head;
+
+    if (*head)
+    {
+        (*head)->prev = page;
+    }
+
+    *head = page;
+}
+
+/**
+ * @fn      MEM_slabPartialRemove
+ * @package MEM_slab
+ *
+ * @brief   Unlinks a page from the partial list of its class.
+ *
+ * @param   [in/out] cache Pointer to the slab cache.
+ * @param   [in/out] page  Pointer to the page descriptor.
+ */
+static void MEM_slabPartialRemove(mem_slab_cache_t *cache, mem_slab_page_t *page)
+{
+    /* Start Function Logic */
+    if (page->prev)
+    {
+        page->prev->next = page->next;
+    }
+    else
+    {
+        cache->partial[page->size_class] = page->next;
+    }
+
+    if (page->next)
+    {
+        page->next->prev = page->prev;
+    }
+
+    page->next = NULL;
+    page->prev = NULL;
+}
+
+/**
+ * @fn      MEM_slabPageAssign
+ * @package MEM_slab
+ *
+ * @brief   Takes a page from the free pool and dedicates it to a class.
+ *
+ * @details Only the bitmap is initialized; the slots themselves are never written.
+ *
+ * @param   [in/out] cache      Pointer to the slab cache.
+ * @param   [in]     size_class Class index.
+ *
+ * @return  Pointer to the page descriptor, or NULL when the pool is empty.
+ */
+static mem_slab_page_t *MEM_slabPageAssign(mem_slab_cache_t *cache, uint32_t size_class)
+{
+    /* Definition of Function Variables */
+    mem_slab_page_t *page   = NULL;
+    uint32_t slots          = 0u;
+    uint32_t word           = 0u;
+
+    /* Assigning Initial Values for Variables */
+    page    = cache->free_pages;
+    slots   = MEM_slabSlotsPerPage(size_class);
+
+    /* Check deference/argument boundaries */
+    if (page == NULL)
+    {
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    cache->free_pages = page->next;
+
+    for (word = 0u; word < MEM_SLAB_MAP_WORDS; ++word)
+    {
+        if (slots >= 64u * (word + 1u))
+        {
+            page->free_map[word] = ~(uint64_t)0u;
+        }
+        else if (slots > 64u * word)
+        {
+            page->free_map[word] = ((uint64_t)1u << (slots - (64u * word))) - 1u;
+        }
+        else
+        {
+            page->free_map[word] = 0u;
+        }
+    }
+
+    page->used          = 0u;
+    page->size_class    = size_class;
+
+    MEM_slabPartialPush(cache, page);
+
+    /* Function Return */
+end_of_function:
+    return page;
+}
+
+/**
+ * @fn      MEM_slabPageRetire
+ * @package MEM_slab
+ *
+ * @brief   Returns an empty page to the free pool.
+ *
+ * @param   [in/out] cache Pointer to the slab cache.
+ * @param   [in/out] page  Pointer to an empty page descriptor on a partial list.
+ */
+static void MEM_slabPageRetire(mem_slab_cache_t *cache, mem_slab_page_t *page)
+{
+    /* Start Function Logic */
+    MEM_slabPartialRemove(cache, page);
+
+    page->size_class    = MEM_SLAB_NO_CLASS;
+    page->next          = cache->free_pages;
+    cache->free_pages   = page;
+}
+
+/**
+ * @fn      MEM_slabAlloc
+ * @package MEM_slab
+ *
+ * @brief   Takes a slot of a class from the pages.
+ *
+ * @param   [in/out] cache      Pointer to the slab cache.
+ * @param   [in]     size_class Class index.
+ *
+ * @return  Pointer to the slot, or NULL when no page can serve the class.
+ */
+static void *MEM_slabAlloc(mem_slab_cache_t *cache, uint32_t size_class)
+{
+    /* Definition of Function Variables */
+    void *slot              = NULL;
+    mem_slab_page_t *page   = NULL;
+
+    uint32_t word           = 0u;
+    uint32_t index          = 0u;
+
+    /* Assigning Initial Values for Variables */
+    page = cache->partial[size_class];
+
+    /* Start Function Logic */
+    if (page == NULL)
+    {
+        page = MEM_slabPageAssign(cache, size_class);
+        if (page == NULL)
+        {
+            goto end_of_function;
+        }
+    }
+
+    while (page->free_map[word] == 0u)
+    {
+        ++word;
+    }
+
+    index                    = (64u * word) + (uint32_t)__builtin_ctzll(page->free_map[word]);
+    page->free_map[word]    &= page->free_map[word] - 1u;
+
+    if (++page->used == MEM_slabSlotsPerPage(size_class))
+    {
+        MEM_slabPartialRemove(cache, page);
+    }
+
+    slot = MEM_slabPageBase(cache, page) + ((size_t)index << (MEM_SLAB_MIN_SHIFT + size_class));
+
+    /* Function Return */
+end_of_function:
+    return slot;
+}
+
+/**
+ * @fn      MEM_slabInit
+ * @package MEM_slab
+ *
+ * @brief   Creates a slab cache over page_count pages taken from an allocator.
+ *
+ * @details The region is allocated aligned to MEM_SLAB_PAGE_SIZE, and the page descriptors
+ *          are a second allocation, so the pages hold nothing but objects.
+ *
+ * @param   [out]    cache      Pointer to the slab cache to initialize.
+ * @param   [in/out] allocator  Initialized allocator backing the cache.
+ * @param   [in]     page_count Number of MEM_SLAB_PAGE_SIZE pages to reserve.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_slabInit(mem_slab_cache_t *cache, mem_allocator_t *allocator, size_t page_count)
+{
+    /* Definition of Function Variables */
+    int ret             = 0u;
+
+    size_t index        = 0u;
+    uint32_t size_class = 0u;
+
+    /* Check deference/argument boundaries */
+    if (cache == NULL || allocator == NULL || page_count == 0u)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    if (page_count > SIZE_MAX / MEM_SLAB_PAGE_SIZE)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    memset(cache, 0, sizeof(mem_slab_cache_t));
+
+    cache->allocator    = allocator;
+    cache->page_count   = page_count;
+
+    /* Start Function Logic */
+    cache->region = MEM_allocatorMemalign(allocator, MEM_SLAB_PAGE_SIZE, page_count * MEM_SLAB_PAGE_SIZE,
+                                          __FILE__, __LINE__, "slab_region", TLSF_FIT);
+    if (cache->region == NULL)
+    {
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    cache->pages = MEM_allocatorCalloc(allocator, page_count, sizeof(mem_slab_page_t),
+                                       __FILE__, __LINE__, "slab_pages", TLSF_FIT);
+    if (cache->pages == NULL)
+    {
+        MEM_allocatorFree(allocator, cache->region, __FILE__, __LINE__, "slab_region");
+
+        ret = ENOMEM;
+        goto end_of_function;
+    }
+
+    for (index = page_count; index-- > 0u; )
+    {
+        cache->pages[index].size_class  = MEM_SLAB_NO_CLASS;
+        cache->pages[index].next        = cache->free_pages;
+        cache->free_pages               = &cache->pages[index];
+    }
+
+    for (size_class = 0u; size_class < MEM_SLAB_NUM_CLASSES; ++size_class)
+    {
+        cache->partial[size_class] = NULL;
+    }
+
+    pthread_mutex_init(&cache->lock, NULL);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_slabDestroy
+ * @package MEM_slab
+ *
+ * @brief   Returns the pages of a slab cache to its allocator.
+ *
+ * @param   [in/out] cache Pointer to the slab cache.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_slabDestroy(mem_slab_cache_t *cache)
+{
+    /* Definition of Function Variables */
+    int ret = 0u;
+
+    /* Check deference/argument boundaries */
+    if (cache == NULL || cache->allocator == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    MEM_allocatorFree(cache->allocator, cache->pages, __FILE__, __LINE__, "slab_pages");
+    ret = MEM_allocatorFree(cache->allocator, cache->region, __FILE__, __LINE__, "slab_region");
+
+    pthread_mutex_destroy(&cache->lock);
+    memset(cache, 0, sizeof(mem_slab_cache_t));
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/**
+ * @fn      MEM_slabMalloc
+ * @package MEM_slab
+ *
+ * @brief   Allocates memory from the slab class fitting size, or from the allocator.
+ *
+ * @param   [in/out] cache    Pointer to the slab cache.
+ * @param   [in]     size     Size of memory to allocate.
+ * @param   [in]     file     Name of the file requesting the allocation.
+ * @param   [in]     line     Line number in the file requesting the allocation.
+ * @param   [in]     var_name Name of the variable being allocated.
+ * @param   [in]     strategy Strategy used when the request falls through to the allocator.
+ *
+ * @return  Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *MEM_slabMalloc(mem_slab_cache_t *cache, size_t size, const char *file, int line, const char *var_name, allocation_strategy_t strategy)
+{
+    /* Definition of Function Variables */
+    void *user_ptr = NULL;
+
+    /* Check deference/argument boundaries */
+    if (cache == NULL || cache->allocator == NULL || size == 0u)
+    {
+        errno = EINVAL;
+        goto end_of_function;
+    }
+
+    /* Start Function Logic */
+    if (size <= MEM_SLAB_MAX_SIZE)
+    {
+        MEM_slabLock(cache);
+        user_ptr = MEM_slabAlloc(cache, MEM_slabClassOf(size));
+        MEM_slabUnlock(cache);
+    }
+
+    if (user_ptr == NULL)
+    {
+        user_ptr = MEM_allocatorMalloc(cache->allocator, size, file, line, var_name, strategy);
+    }
+
+    /* Function Return */
+end_of_function:
+    return user_ptr;
+}
+
+/**
+ * @fn      MEM_slabFree
+ * @package MEM_slab
+ *
+ * @brief   Frees memory returned by MEM_slabMalloc.
+ *
+ * @details Pointers outside the slab region are passed to MEM_allocatorFree. Pointers inside
+ *          it must be the start of an allocated slot; anything else is rejected.
+ *
+ * @param   [in/out] cache    Pointer to the slab cache.
+ * @param   [in]     ptr      Pointer to the memory to free.
+ * @param   [in]     file     Name of the file requesting the free operation.
+ * @param   [in]     line     Line number in the file requesting the free operation.
+ * @param   [in]     var_name Name of the variable being freed.
+ *
+ * @return  0 on success, error code on failure.
+ */
+int MEM_slabFree(mem_slab_cache_t *cache, void *ptr, const char *file, int line, const char *var_name)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0u;
+
+    size_t offset           = 0u;
+    uint32_t index          = 0u;
+    uint64_t bit            = 0u;
+    mem_slab_page_t *page   = NULL;
+
+    /* Check deference/argument boundaries */
+    if (cache == NULL || cache->allocator == NULL)
+    {
+        ret = EINVAL;
+        goto end_of_function;
+    }
+
+    if ((uint8_t *)ptr < cache->region || (uint8_t *)ptr >= cache->region + (cache->page_count * MEM_SLAB_PAGE_SIZE))
+    {
+        ret = MEM_allocatorFree(cache->allocator, ptr, file, line, var_name);
+        goto end_of_function;
+    }
+
+    /* Assigning Initial Values for Variables */
+    offset  = (size_t)((uint8_t *)ptr - cache->region);
+    page    = &cache->pages[offset / MEM_SLAB_PAGE_SIZE];
+    offset &= MEM_SLAB_PAGE_SIZE - 1u;
+
+    /* Start Function Logic */
+    MEM_slabLock(cache);
+
+    if (page->size_class == MEM_SLAB_NO_CLASS ||
+        (offset & (((size_t)1u << (MEM_SLAB_MIN_SHIFT + page->size_class)) - 1u)) != 0u)
+    {
+        MEM_LOG_ERROR("MEM_slabFree: Invalid pointer %p for variable '%s' (in %s:%d)\n", ptr, var_name, file, line);
+
+        ret = EINVAL;
+        goto unlock_cache;
+    }
+
+    index   = (uint32_t)(offset >> (MEM_SLAB_MIN_SHIFT + page->size_class));
+    bit     = (uint64_t)1u << (index % 64u);
+
+    if (page->free_map[index / 64u] & bit)
+    {
+        MEM_LOG_ERROR("MEM_slabFree: Double free detected for %p (variable '%s') (in %s:%d)\n", ptr, var_name, file, line);
+
+        ret = EINVAL;
+        goto unlock_cache;
+    }
+
+    page->free_map[index / 64u] |= bit;
+
+    if (page->used-- == MEM_slabSlotsPerPage(page->size_class))
+    {
+        MEM_slabPartialPush(cache, page);
+    }
+
+    /* Keep the last partial page of a class to avoid bouncing pages through the pool */
+    if (page->used == 0u && (cache->partial[page->size_class] != page || page->next != NULL))
+    {
+        MEM_slabPageRetire(cache, page);
+    }
+
+unlock_cache:
+    MEM_slabUnlock(cache);
+
+    /* Function Return */
+end_of_function:
+    return ret;
+}
+
+/*** end of file ***/
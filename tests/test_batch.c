@@ -0,0 +1,328 @@
+/**
+ *  @ingroup    MemoryManagement
+ *  @addtogroup MemoryTest MEM_test
+ *  @{
+ *
+ *  @package    MEM_test
+ *  @brief      Regression checks of the batch calls against cached and deferred blocks.
+ *
+ *  @file       test_batch.c
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              Built against the library sources. A block held by the calling thread's cache
+ *              or deferred in a fast bin is still marked allocated, so MEM_allocatorFreeBatch must
+ *              reject it rather than merge it while it is still linked, and the same address
+ *              must never be handed out twice. MEM_allocatorMallocBatch must coalesce the fast
+ *              bins before it gives up on a heap whose free memory sits in them.
+ *
+ *  @note
+ *              - Usage: test_batch
+ *              - Prints one line per failed check and exits with 1 when any failed.
+ *
+ *  @see        - libmemalloc.h
+ **/
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <libmemalloc.h>
+
+/* =================================
+ *          PRIVATE DEFINES        *
+ * ================================*/
+
+/**
+ * @def TEST_REGION_SIZE
+ * @package MEM_test
+ *
+ * @brief Size of the heap whose free memory is left in the fast bins (16 KiB).
+ */
+#define TEST_REGION_SIZE (16UL * 1024UL)
+
+/**
+ * @def TEST_MAX_BLOCKS
+ * @package MEM_test
+ *
+ * @brief Most small blocks the fast-bin fill may take out of TEST_REGION_SIZE.
+ */
+#define TEST_MAX_BLOCKS (1024U)
+
+/**
+ * @def TEST_BATCH_COUNT
+ * @package MEM_test
+ *
+ * @brief Blocks requested from MEM_allocatorMallocBatch after the fast-bin fill.
+ */
+#define TEST_BATCH_COUNT (8U)
+
+/**
+ * @def TEST_CHECK
+ * @package MEM_test
+ *
+ * @brief Reports a failed condition with its line and clears the result.
+ */
+#define TEST_CHECK(cond, result)                                                        \
+    do                                                                                  \
+    {                                                                                   \
+        if (!(cond))                                                                    \
+        {                                                                               \
+            printf("test_batch: %s:%d: check failed: %s\n", __func__, __LINE__, #cond); \
+            (result) = 1;                                                               \
+        }                                                                               \
+    } while (0)
+
+/* =================================
+ *   PRIVATE FUNCTION DEFINITION   *
+ * ================================*/
+
+/**
+ * @fn      TEST_heapEmpty
+ * @package MEM_test
+ *
+ * @brief   Tells whether every byte of an allocator is free again.
+ *
+ * @param   [in/out] allocator Pointer to the allocator to check.
+ *
+ * @return  Non-zero when no byte is in use.
+ */
+static int TEST_heapEmpty(mem_allocator_t *allocator)
+{
+    /* Definition of Function Variables */
+    mem_alloc_stats_t stats;
+
+    /* Assigning Initial Values for Variables */
+    memset(&stats, 0, sizeof(stats));
+
+    /* Function Return */
+    return MEM_allocatorGetStats(allocator, &stats) == 0 && stats.bytes_in_use == 0u;
+}
+
+/**
+ * @fn      TEST_freeBatchCached
+ * @package MEM_test
+ *
+ * @brief   Passes blocks held by the calling thread's cache to MEM_allocatorFreeBatch.
+ *
+ * @return  0 when every check passed, 1 otherwise.
+ */
+static int TEST_freeBatchCached(void)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0;
+
+    void *cached            = NULL;
+    void *first             = NULL;
+    void *second            = NULL;
+    void *run[3]            = { NULL, NULL, NULL };
+    void *batch[3]          = { NULL, NULL, NULL };
+
+    mem_allocator_t allocator;
+
+    /* Assigning Initial Values for Variables */
+    memset(&allocator, 0, sizeof(allocator));
+
+    /* Start Function Logic */
+    TEST_CHECK(MEM_allocatorInitMmap(&allocator, TEST_REGION_SIZE * 4u) == 0, ret);
+    TEST_CHECK(MEM_allocatorSetThreadSafe(&allocator, 1) == 0, ret);
+
+    /* A single cached block */
+    cached = MEM_allocatorMalloc(&allocator, 64u, __FILE__, __LINE__, "cached", FIRST_FIT);
+    TEST_CHECK(cached != NULL, ret);
+    TEST_CHECK(MEM_allocatorFree(&allocator, cached, __FILE__, __LINE__, "cached") == 0, ret);
+
+    batch[0] = cached;
+    TEST_CHECK(MEM_allocatorFreeBatch(&allocator, batch, 1u, __FILE__, __LINE__, "batch") == EINVAL, ret);
+
+    first   = MEM_allocatorMalloc(&allocator, 64u, __FILE__, __LINE__, "first", FIRST_FIT);
+    second  = MEM_allocatorMalloc(&allocator, 48u, __FILE__, __LINE__, "second", FIRST_FIT);
+    TEST_CHECK(first != NULL && second != NULL && first != second, ret);
+
+    /* A cached block in the middle of a run of adjacent blocks */
+    run[0] = MEM_allocatorMalloc(&allocator, 200u, __FILE__, __LINE__, "run", FIRST_FIT);
+    run[1] = MEM_allocatorMalloc(&allocator, 200u, __FILE__, __LINE__, "run", FIRST_FIT);
+    run[2] = MEM_allocatorMalloc(&allocator, 200u, __FILE__, __LINE__, "run", FIRST_FIT);
+    TEST_CHECK(run[0] != NULL && run[1] != NULL && run[2] != NULL, ret);
+    TEST_CHECK(MEM_allocatorFree(&allocator, run[1], __FILE__, __LINE__, "run") == 0, ret);
+
+    memcpy(batch, run, sizeof(run));
+    TEST_CHECK(MEM_allocatorFreeBatch(&allocator, batch, 3u, __FILE__, __LINE__, "batch") == EINVAL, ret);
+
+    run[0] = MEM_allocatorMalloc(&allocator, 200u, __FILE__, __LINE__, "run", FIRST_FIT);
+    run[2] = MEM_allocatorMalloc(&allocator, 200u, __FILE__, __LINE__, "run", FIRST_FIT);
+    TEST_CHECK(run[0] != NULL && run[2] != NULL && run[0] != run[2], ret);
+
+    TEST_CHECK(MEM_allocatorFree(&allocator, first, __FILE__, __LINE__, "first") == 0, ret);
+    TEST_CHECK(MEM_allocatorFree(&allocator, second, __FILE__, __LINE__, "second") == 0, ret);
+    TEST_CHECK(MEM_allocatorFree(&allocator, run[0], __FILE__, __LINE__, "run") == 0, ret);
+    TEST_CHECK(MEM_allocatorFree(&allocator, run[2], __FILE__, __LINE__, "run") == 0, ret);
+
+    TEST_CHECK(MEM_tcacheFlush() == 0, ret);
+    TEST_CHECK(TEST_heapEmpty(&allocator), ret);
+    TEST_CHECK(MEM_allocatorDestroy(&allocator) == 0, ret);
+
+    /* Function Return */
+    return ret;
+}
+
+/**
+ * @fn      TEST_freeBatchDeferred
+ * @package MEM_test
+ *
+ * @brief   Passes blocks deferred in a fast bin to MEM_allocatorFreeBatch.
+ *
+ * @return  0 when every check passed, 1 otherwise.
+ */
+static int TEST_freeBatchDeferred(void)
+{
+    /* Definition of Function Variables */
+    int ret                 = 0;
+    size_t index            = 0u;
+
+    void *blocks[4]         = { NULL, NULL, NULL, NULL };
+    void *batch[2]          = { NULL, NULL };
+    void *popped            = NULL;
+    void *larger            = NULL;
+
+    mem_allocator_t allocator;
+
+    /* Assigning Initial Values for Variables */
+    memset(&allocator, 0, sizeof(allocator));
+
+    /* Start Function Logic */
+    TEST_CHECK(MEM_allocatorInitMmap(&allocator, TEST_REGION_SIZE * 4u) == 0, ret);
+    TEST_CHECK(MEM_allocatorSetDeferredCoalescing(&allocator, 1) == 0, ret);
+
+    for (index = 0u; index < 4u; ++index)
+    {
+        blocks[index] = MEM_allocatorMalloc(&allocator, 48u, __FILE__, __LINE__, "block", FIRST_FIT);
+        TEST_CHECK(blocks[index] != NULL, ret);
+    }
+
+    TEST_CHECK(MEM_allocatorFree(&allocator, blocks[1], __FILE__, __LINE__, "block") == 0, ret);
+    TEST_CHECK(allocator.fastbin_count == 1u, ret);
+
+    batch[0] = blocks[1];
+    batch[1] = blocks[2];
+    TEST_CHECK(MEM_allocatorFreeBatch(&allocator, batch, 2u, __FILE__, __LINE__, "batch") == EINVAL, ret);
+
+    popped  = MEM_allocatorMalloc(&allocator, 48u, __FILE__, __LINE__, "popped", FIRST_FIT);
+    larger  = MEM_allocatorMalloc(&allocator, 120u, __FILE__, __LINE__, "larger", FIRST_FIT);
+    TEST_CHECK(popped != NULL && larger != NULL && popped != larger, ret);
+
+    TEST_CHECK(MEM_allocatorFree(&allocator, popped, __FILE__, __LINE__, "popped") == 0, ret);
+    TEST_CHECK(MEM_allocatorFree(&allocator, larger, __FILE__, __LINE__, "larger") == 0, ret);
+    TEST_CHECK(MEM_allocatorFree(&allocator, blocks[0], __FILE__, __LINE__, "block") == 0, ret);
+    TEST_CHECK(MEM_allocatorFree(&allocator, blocks[3], __FILE__, __LINE__, "block") == 0, ret);
+
+    TEST_CHECK(MEM_allocatorSetDeferredCoalescing(&allocator, 0) == 0, ret);
+    TEST_CHECK(TEST_heapEmpty(&allocator), ret);
+    TEST_CHECK(MEM_allocatorDestroy(&allocator) == 0, ret);
+
+    /* Function Return */
+    return ret;
+}
+
+/**
+ * @fn      TEST_mallocBatchDeferred
+ * @package MEM_test
+ *
+ * @brief   Runs MEM_allocatorMallocBatch on a heap whose free memory sits in the fast bins.
+ *
+ * @return  0 when every check passed, 1 otherwise.
+ */
+static int TEST_mallocBatchDeferred(void)
+{
+    /* Definition of Function Variables */
+    int ret                         = 0;
+    size_t index                    = 0u;
+    size_t count                    = 0u;
+    size_t served                   = 0u;
+
+    static void *blocks[TEST_MAX_BLOCKS];
+    void *batch[TEST_BATCH_COUNT];
+
+    mem_allocator_t allocator;
+
+    /* Assigning Initial Values for Variables */
+    memset(&allocator, 0, sizeof(allocator));
+    memset(batch, 0, sizeof(batch));
+
+    /* Start Function Logic */
+    TEST_CHECK(MEM_allocatorInitMmap(&allocator, TEST_REGION_SIZE) == 0, ret);
+    TEST_CHECK(MEM_allocatorSetDeferredCoalescing(&allocator, 1) == 0, ret);
+
+    while (count < TEST_MAX_BLOCKS)
+    {
+        blocks[count] = MEM_allocatorMalloc(&allocator, 64u, __FILE__, __LINE__, "fill", FIRST_FIT);
+        if (blocks[count] == NULL)
+        {
+            break;
+        }
+
+        ++count;
+    }
+
+    TEST_CHECK(count > 0u && count < TEST_MAX_BLOCKS, ret);
+
+    for (index = 0u; index < count; ++index)
+    {
+        TEST_CHECK(MEM_allocatorFree(&allocator, blocks[index], __FILE__, __LINE__, "fill") == 0, ret);
+    }
+
+    TEST_CHECK(allocator.fastbin_count != 0u, ret);
+
+    served = MEM_allocatorMallocBatch(&allocator, 1024u, TEST_BATCH_COUNT, batch, __FILE__, __LINE__, "batch", FIRST_FIT);
+    TEST_CHECK(served == TEST_BATCH_COUNT, ret);
+
+    TEST_CHECK(MEM_allocatorFreeBatch(&allocator, batch, served, __FILE__, __LINE__, "batch") == 0, ret);
+
+    TEST_CHECK(MEM_allocatorSetDeferredCoalescing(&allocator, 0) == 0, ret);
+    TEST_CHECK(TEST_heapEmpty(&allocator), ret);
+    TEST_CHECK(MEM_allocatorDestroy(&allocator) == 0, ret);
+
+    /* Function Return */
+    return ret;
+}
+
+/**
+ * @fn      main
+ * @package MEM_test
+ *
+ * @brief   Runs every check and reports the result.
+ *
+ * @return  0 when every check passed, 1 otherwise.
+ */
+int main(void)
+{
+    /* Definition of Function Variables */
+    int ret = 0;
+
+    /* Assigning Initial Values for Variables */
+    MEM_logSetHook(NULL, NULL);
+
+    /* Start Function Logic */
+    ret |= TEST_freeBatchCached();
+    ret |= TEST_freeBatchDeferred();
+    ret |= TEST_mallocBatchDeferred();
+
+    MEM_logSetHook(MEM_logStdio, NULL);
+
+    if (ret == 0)
+    {
+        printf("test_batch: all checks passed\n");
+    }
+
+    /* Function Return */
+    return ret;
+}
+
+/*** end of file ***/
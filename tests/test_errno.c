@@ -0,0 +1,223 @@
+/**
+ *  @ingroup    MemoryManagement
+ *  @addtogroup MemoryTest MEM_test
+ *  @{
+ *
+ *  @package    MEM_test
+ *  @brief      Regression check of the errno MEM_allocatorMalloc reports on failure.
+ *
+ *  @file       test_errno.c
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              Built against the library sources. For every strategy, a zero-sized request
+ *              must fail with EINVAL, while a request no free block fits must fail with ENOMEM,
+ *              both on a heap that cannot grow and on one whose chunk provider has nothing left.
+ *
+ *  @note
+ *              - Usage: test_errno
+ *              - Prints one line per failed check and exits with 1 when any failed.
+ *
+ *  @see        - libmemalloc.h
+ **/
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <libmemalloc.h>
+
+/* =================================
+ *          PRIVATE DEFINES        *
+ * ================================*/
+
+/**
+ * @def TEST_REGION_SIZE
+ * @package MEM_test
+ *
+ * @brief Size of the heap every strategy allocates from (16 KiB).
+ */
+#define TEST_REGION_SIZE (16UL * 1024UL)
+
+/**
+ * @def TEST_CHUNK_SIZE
+ * @package MEM_test
+ *
+ * @brief Chunk size asked of the exhausted provider (64 KiB).
+ */
+#define TEST_CHUNK_SIZE (64UL * 1024UL)
+
+/* =================================
+ *      PRIVATE GLOBAL VARIABLE    *
+ * ================================*/
+
+/**
+ * @var     test_strategies
+ * @package MEM_test
+ *
+ * @brief   Every allocation strategy, checked in turn.
+ */
+static const allocation_strategy_t test_strategies[] =
+{
+    FIRST_FIT,
+    NEXT_FIT,
+    BEST_FIT,
+    SEGREGATED_FIT,
+    TLSF_FIT,
+};
+
+/* =================================
+ *   PRIVATE FUNCTION DEFINITION   *
+ * ================================*/
+
+/**
+ * @fn      TEST_acquireNone
+ * @package MEM_test
+ *
+ * @brief   Chunk provider callback that never has memory left.
+ *
+ * @param   [in] size    Requested chunk size (unused).
+ * @param   [in] context Provider context (unused).
+ *
+ * @return  Always NULL.
+ */
+static void *TEST_acquireNone(size_t size, void *context)
+{
+    /* Function Return */
+    (void)size;
+    (void)context;
+    return NULL;
+}
+
+/**
+ * @fn      TEST_releaseNone
+ * @package MEM_test
+ *
+ * @brief   Chunk provider callback matching TEST_acquireNone, never called.
+ *
+ * @param   [in] base    Chunk base (unused).
+ * @param   [in] size    Chunk size (unused).
+ * @param   [in] context Provider context (unused).
+ */
+static void TEST_releaseNone(void *base, size_t size, void *context)
+{
+    /* Function Return */
+    (void)base;
+    (void)size;
+    (void)context;
+}
+
+/**
+ * @fn      TEST_expectErrno
+ * @package MEM_test
+ *
+ * @brief   Makes one request and reports it when it did not fail with the expected errno.
+ *
+ * @param   [in/out] allocator Pointer to the allocator to allocate from.
+ * @param   [in]     size      Size of the request.
+ * @param   [in]     strategy  Allocation strategy to use.
+ * @param   [in]     expected  errno the request must fail with.
+ * @param   [in]     label     Heap being checked, for the report.
+ *
+ * @return  0 when the request failed as expected, 1 otherwise.
+ */
+static int TEST_expectErrno(mem_allocator_t *allocator, size_t size, allocation_strategy_t strategy, int expected, const char *label)
+{
+    /* Definition of Function Variables */
+    int ret         = 0;
+    int error       = 0;
+    void *user_ptr  = NULL;
+
+    /* Start Function Logic */
+    errno       = 0;
+    user_ptr    = MEM_allocatorMalloc(allocator, size, __FILE__, __LINE__, "user_ptr", strategy);
+    error       = errno;
+
+    if (user_ptr != NULL || error != expected)
+    {
+        printf("test_errno: %s heap, strategy %d, size %zu returned %p with errno %d, expected NULL and %d\n",
+               label, (int)strategy, size, user_ptr, error, expected);
+        ret = 1;
+    }
+
+    if (user_ptr != NULL)
+    {
+        (void)MEM_allocatorFree(allocator, user_ptr, __FILE__, __LINE__, "user_ptr");
+    }
+
+    /* Function Return */
+    return ret;
+}
+
+/**
+ * @fn      main
+ * @package MEM_test
+ *
+ * @brief   Runs every check and reports the result.
+ *
+ * @return  0 when every check passed, 1 otherwise.
+ */
+int main(void)
+{
+    /* Definition of Function Variables */
+    int ret         = 0;
+    size_t index    = 0u;
+
+    mem_allocator_t allocator;
+    mem_chunk_provider_t provider;
+
+    /* Assigning Initial Values for Variables */
+    memset(&allocator, 0, sizeof(allocator));
+    memset(&provider, 0, sizeof(provider));
+
+    provider.acquire = TEST_acquireNone;
+    provider.release = TEST_releaseNone;
+
+    MEM_logSetHook(NULL, NULL);
+
+    /* Check deference/argument boundaries */
+    if (MEM_allocatorInitMmap(&allocator, TEST_REGION_SIZE) != 0)
+    {
+        printf("test_errno: MEM_allocatorInitMmap failed\n");
+        return 1;
+    }
+
+    /* Start Function Logic */
+    for (index = 0u; index < sizeof(test_strategies) / sizeof(test_strategies[0]); ++index)
+    {
+        ret |= TEST_expectErrno(&allocator, 0u, test_strategies[index], EINVAL, "fixed");
+        ret |= TEST_expectErrno(&allocator, TEST_REGION_SIZE * 2u, test_strategies[index], ENOMEM, "fixed");
+    }
+
+    if (MEM_allocatorSetGrowth(&allocator, &provider, TEST_CHUNK_SIZE, 0u) != 0)
+    {
+        printf("test_errno: MEM_allocatorSetGrowth failed\n");
+        ret = 1;
+    }
+
+    for (index = 0u; index < sizeof(test_strategies) / sizeof(test_strategies[0]); ++index)
+    {
+        ret |= TEST_expectErrno(&allocator, TEST_REGION_SIZE * 2u, test_strategies[index], ENOMEM, "exhausted growth");
+    }
+
+    (void)MEM_allocatorDestroy(&allocator);
+
+    MEM_logSetHook(MEM_logStdio, NULL);
+
+    if (ret == 0)
+    {
+        printf("test_errno: all checks passed\n");
+    }
+
+    /* Function Return */
+    return ret;
+}
+
+/*** end of file ***/
@@ -0,0 +1,261 @@
+/**
+ *  @ingroup    MemoryManagement
+ *  @addtogroup MemoryTest MEM_test
+ *  @{
+ *
+ *  @package    MEM_test
+ *  @brief      Checks the C allocation API exported by the preload library.
+ *
+ *  @file       test_preload.c
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              Built as a plain program that links nothing from the library, and run with
+ *              bin/libmemalloc_preload.so in LD_PRELOAD. It first makes sure malloc resolves to
+ *              the preload library, then checks that requests too large to be aligned fail with
+ *              ENOMEM instead of wrapping around to a small block, that a request no mapping can
+ *              serve fails the same way, that none of these failures writes to standard error,
+ *              and that an ordinary allocation still works afterwards.
+ *
+ *  @note
+ *              - Usage: LD_PRELOAD=bin/libmemalloc_preload.so test_preload
+ *              - Prints one line per failed check and exits with 1 when any failed.
+ *
+ *  @see        - libmempreload.c
+ **/
+
+#define _GNU_SOURCE
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dlfcn.h>
+
+/* =================================
+ *          PRIVATE DEFINES        *
+ * ================================*/
+
+/**
+ * @def TEST_PRELOAD_NAME
+ * @package MEM_test
+ *
+ * @brief Part of the file name of the library malloc must resolve to.
+ */
+#define TEST_PRELOAD_NAME "libmemalloc_preload"
+
+/**
+ * @def TEST_SMALL_SIZE
+ * @package MEM_test
+ *
+ * @brief Size of the ordinary allocation checked after the oversized ones.
+ */
+#define TEST_SMALL_SIZE (64UL)
+
+/**
+ * @def TEST_UNSERVABLE_SIZE
+ * @package MEM_test
+ *
+ * @brief Request that aligns fine but that no heap growth can map (64 TiB).
+ */
+#define TEST_UNSERVABLE_SIZE ((size_t)1u << 46)
+
+/**
+ * @def TEST_STDERR_SIZE
+ * @package MEM_test
+ *
+ * @brief Bytes of captured standard error shown when a failure was logged.
+ */
+#define TEST_STDERR_SIZE (512U)
+
+/* =================================
+ *      PRIVATE GLOBAL VARIABLE    *
+ * ================================*/
+
+/**
+ * @var     test_huge_sizes
+ * @package MEM_test
+ *
+ * @brief   Requests of which ALIGN() and the block header would wrap around.
+ *
+ * @details Volatile so the compiler neither folds the calls nor warns about their size.
+ */
+static volatile size_t test_huge_sizes[] =
+{
+    SIZE_MAX,
+    SIZE_MAX - 8u,
+    SIZE_MAX - 20u,
+    SIZE_MAX - 40u,
+};
+
+/* =================================
+ *   PRIVATE FUNCTION DEFINITION   *
+ * ================================*/
+
+/**
+ * @fn      TEST_expectNull
+ * @package MEM_test
+ *
+ * @brief   Reports an allocation that should have failed with ENOMEM.
+ *
+ * @param   [in] name     Name of the call being checked.
+ * @param   [in] size     Size passed to the call.
+ * @param   [in] user_ptr Pointer returned by the call.
+ * @param   [in] error    errno, or the returned error code, after the call.
+ *
+ * @return  0 when the call failed with ENOMEM, 1 otherwise.
+ */
+static int TEST_expectNull(const char *name, size_t size, const void *user_ptr, int error)
+{
+    /* Definition of Function Variables */
+    int ret = 0;
+
+    /* Start Function Logic */
+    if (user_ptr != NULL || error != ENOMEM)
+    {
+        printf("test_preload: %s(%zu) returned %p with error %d, expected NULL and ENOMEM\n", name, size, user_ptr, error);
+        ret = 1;
+    }
+
+    /* Function Return */
+    return ret;
+}
+
+/**
+ * @fn      main
+ * @package MEM_test
+ *
+ * @brief   Runs every check and reports the result.
+ *
+ * @return  0 when every check passed, 1 otherwise.
+ */
+int main(void)
+{
+    /* Definition of Function Variables */
+    int ret             = 0;
+    int error           = 0;
+    int saved_stderr    = -1;
+    int pipe_fds[2]     = { -1, -1 };
+    ssize_t logged      = 0;
+
+    size_t index        = 0u;
+    size_t size         = 0u;
+
+    void *user_ptr      = NULL;
+    void *resized       = NULL;
+    uint8_t *bytes      = NULL;
+
+    char captured[TEST_STDERR_SIZE];
+    Dl_info info;
+
+    /* Assigning Initial Values for Variables */
+    memset(&info, 0, sizeof(info));
+    memset(captured, 0, sizeof(captured));
+
+    /* Check deference/argument boundaries */
+    if (dladdr((void *)(uintptr_t)&malloc, &info) == 0 || info.dli_fname == NULL || strstr(info.dli_fname, TEST_PRELOAD_NAME) == NULL)
+    {
+        printf("test_preload: malloc does not resolve to %s, run with LD_PRELOAD set\n", TEST_PRELOAD_NAME);
+        return 1;
+    }
+
+    /* Start Function Logic */
+    bytes = malloc(TEST_SMALL_SIZE);
+    if (bytes == NULL)
+    {
+        printf("test_preload: malloc(%lu) failed before the oversized requests\n", TEST_SMALL_SIZE);
+        return 1;
+    }
+
+    memset(bytes, 0xA5, TEST_SMALL_SIZE);
+
+    /* Failures must reach the caller through NULL and errno only, standard error is captured */
+    if (pipe(pipe_fds) != 0 || fcntl(pipe_fds[0], F_SETFL, O_NONBLOCK) != 0 || (saved_stderr = dup(STDERR_FILENO)) < 0 || dup2(pipe_fds[1], STDERR_FILENO) < 0)
+    {
+        printf("test_preload: failed to capture standard error\n");
+        return 1;
+    }
+
+    errno       = 0;
+    user_ptr    = malloc(TEST_UNSERVABLE_SIZE);
+    ret        |= TEST_expectNull("malloc", TEST_UNSERVABLE_SIZE, user_ptr, errno);
+
+    for (index = 0u; index < sizeof(test_huge_sizes) / sizeof(test_huge_sizes[0]); ++index)
+    {
+        size = test_huge_sizes[index];
+
+        errno       = 0;
+        user_ptr    = malloc(size);
+        ret        |= TEST_expectNull("malloc", size, user_ptr, errno);
+
+        errno       = 0;
+        user_ptr    = calloc(1u, size);
+        ret        |= TEST_expectNull("calloc", size, user_ptr, errno);
+
+        errno       = 0;
+        resized     = realloc(bytes, size);
+        ret        |= TEST_expectNull("realloc", size, resized, errno);
+
+        user_ptr    = NULL;
+        error       = posix_memalign(&user_ptr, 64u, size);
+        ret        |= TEST_expectNull("posix_memalign", size, user_ptr, error);
+
+        errno       = 0;
+        user_ptr    = aligned_alloc(64u, size & ~(size_t)63u);
+        ret        |= TEST_expectNull("aligned_alloc", size & ~(size_t)63u, user_ptr, errno);
+    }
+
+    (void)dup2(saved_stderr, STDERR_FILENO);
+    (void)close(saved_stderr);
+    (void)close(pipe_fds[1]);
+
+    logged = read(pipe_fds[0], captured, sizeof(captured) - 1u);
+    (void)close(pipe_fds[0]);
+
+    if (logged > 0)
+    {
+        printf("test_preload: failed allocations wrote to standard error: %s\n", captured);
+        ret = 1;
+    }
+
+    for (index = 0u; index < TEST_SMALL_SIZE; ++index)
+    {
+        if (bytes[index] != 0xA5)
+        {
+            printf("test_preload: failed realloc changed byte %zu of the original block\n", index);
+            ret = 1;
+            break;
+        }
+    }
+
+    free(bytes);
+
+    bytes = malloc(TEST_SMALL_SIZE);
+    if (bytes == NULL)
+    {
+        printf("test_preload: malloc(%lu) failed after the oversized requests\n", TEST_SMALL_SIZE);
+        ret = 1;
+    }
+
+    free(bytes);
+
+    if (ret == 0)
+    {
+        printf("test_preload: all checks passed\n");
+    }
+
+    /* Function Return */
+    return ret;
+}
+
+/*** end of file ***/
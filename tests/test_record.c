@@ -0,0 +1,277 @@
+/**
+ *  @ingroup    MemoryManagement
+ *  @addtogroup MemoryTest MEM_test
+ *  @{
+ *
+ *  @package    MEM_test
+ *  @brief      Regression check of an allocation recording stopped while a thread still runs.
+ *
+ *  @file       test_record.c
+ *  @author     Rafael V. Volkmer (Rafael.v.volkmer@gmail.com)
+ *
+ *  @date       14.10.2024
+ *
+ *  @details
+ *              Built against the library sources. A worker thread records fewer allocations
+ *              than fill its buffer and then waits, so neither a full buffer nor its exit
+ *              writes them out. MEM_recordStop must still drain them into the file, which is
+ *              then read back and its allocation records counted.
+ *
+ *  @note
+ *              - Usage: test_record
+ *              - Prints one line per failed check and exits with 1 when any failed.
+ *
+ *  @see        - libmemalloc.h
+ **/
+
+/* =================================
+ *       PRIVATE INCLUDE FILES     *
+ * ================================*/
+
+/* dependencies: */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <libmemalloc.h>
+
+/* =================================
+ *          PRIVATE DEFINES        *
+ * ================================*/
+
+/**
+ * @def TEST_REGION_SIZE
+ * @package MEM_test
+ *
+ * @brief Size of the heap the worker thread allocates from (64 KiB).
+ */
+#define TEST_REGION_SIZE (64UL * 1024UL)
+
+/**
+ * @def TEST_RECORD_COUNT
+ * @package MEM_test
+ *
+ * @brief Allocations the worker records, well below MEM_RECORD_BUFFER.
+ */
+#define TEST_RECORD_COUNT (16U)
+
+/**
+ * @def TEST_PATH_TEMPLATE
+ * @package MEM_test
+ *
+ * @brief mkstemp template of the recording file.
+ */
+#define TEST_PATH_TEMPLATE "/tmp/test_record_XXXXXX"
+
+_Static_assert(TEST_RECORD_COUNT < MEM_RECORD_BUFFER, "TEST_RECORD_COUNT must not fill a record buffer");
+
+/* =================================
+ *      PRIVATE GLOBAL VARIABLE    *
+ * ================================*/
+
+/**
+ * @var     test_allocator
+ * @package MEM_test
+ *
+ * @brief   Thread-safe allocator shared by the main and the worker thread.
+ */
+static mem_allocator_t test_allocator;
+
+/**
+ * @var     test_barrier
+ * @package MEM_test
+ *
+ * @brief   Holds the worker between its allocations and its frees until the recording stops.
+ */
+static pthread_barrier_t test_barrier;
+
+/* =================================
+ *   PRIVATE FUNCTION DEFINITION   *
+ * ================================*/
+
+/**
+ * @fn      TEST_worker
+ * @package MEM_test
+ *
+ * @brief   Records TEST_RECORD_COUNT allocations, waits for MEM_recordStop, then frees them.
+ *
+ * @param   [in] arg Unused.
+ *
+ * @return  NULL when every allocation succeeded, arg otherwise.
+ */
+static void *TEST_worker(void *arg)
+{
+    /* Definition of Function Variables */
+    void *failed                        = NULL;
+    void *blocks[TEST_RECORD_COUNT];
+    size_t index                        = 0u;
+
+    /* Start Function Logic */
+    for (index = 0u; index < TEST_RECORD_COUNT; ++index)
+    {
+        blocks[index] = MEM_allocatorMalloc(&test_allocator, 32u + index, __FILE__, __LINE__, "blocks", FIRST_FIT);
+        if (blocks[index] == NULL)
+        {
+            failed = &test_barrier;
+        }
+    }
+
+    (void)pthread_barrier_wait(&test_barrier);
+    (void)pthread_barrier_wait(&test_barrier);
+
+    for (index = 0u; index < TEST_RECORD_COUNT; ++index)
+    {
+        (void)MEM_allocatorFree(&test_allocator, blocks[index], __FILE__, __LINE__, "blocks");
+    }
+
+    /* Function Return */
+    (void)arg;
+    return failed;
+}
+
+/**
+ * @fn      TEST_countMallocs
+ * @package MEM_test
+ *
+ * @brief   Reads a recording back and counts its allocation records.
+ *
+ * @param   [in]  path   Recording file.
+ * @param   [out] mallocs Number of MEM_RECORD_MALLOC records.
+ *
+ * @return  0 when the file has a valid header, 1 otherwise.
+ */
+static int TEST_countMallocs(const char *path, size_t *mallocs)
+{
+    /* Definition of Function Variables */
+    int ret = 0;
+    FILE *file = NULL;
+
+    mem_record_header_t header;
+    mem_record_t record;
+
+    /* Assigning Initial Values for Variables */
+    *mallocs = 0u;
+
+    /* Check deference/argument boundaries */
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        printf("test_record: cannot open %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    /* Start Function Logic */
+    if (fread(&header, sizeof(header), 1u, file) != 1u ||
+        memcmp(header.magic, MEM_RECORD_MAGIC, sizeof(MEM_RECORD_MAGIC)) != 0 ||
+        header.record_size != sizeof(mem_record_t))
+    {
+        printf("test_record: %s has no valid recording header\n", path);
+        ret = 1;
+        goto close_file;
+    }
+
+    while (fread(&record, sizeof(record), 1u, file) == 1u)
+    {
+        if (record.op == MEM_RECORD_FILE)
+        {
+            (void)fseek(file, (long)((record.size + sizeof(record) - 1u) / sizeof(record) * sizeof(record)), SEEK_CUR);
+        }
+        else if (record.op == MEM_RECORD_MALLOC)
+        {
+            ++(*mallocs);
+        }
+    }
+
+close_file:
+    (void)fclose(file);
+
+    /* Function Return */
+    return ret;
+}
+
+/**
+ * @fn      main
+ * @package MEM_test
+ *
+ * @brief   Runs the check and reports the result.
+ *
+ * @return  0 when the check passed, 1 otherwise.
+ */
+int main(void)
+{
+    /* Definition of Function Variables */
+    int ret                             = 0;
+    int fd                              = -1;
+    size_t mallocs                      = 0u;
+    void *failed                        = NULL;
+    pthread_t worker;
+
+    char path[sizeof(TEST_PATH_TEMPLATE)] = TEST_PATH_TEMPLATE;
+
+    /* Assigning Initial Values for Variables */
+    memset(&test_allocator, 0, sizeof(test_allocator));
+    MEM_logSetHook(NULL, NULL);
+
+    /* Check deference/argument boundaries */
+    fd = mkstemp(path);
+    if (fd < 0 || MEM_allocatorInitMmap(&test_allocator, TEST_REGION_SIZE) != 0 || MEM_allocatorSetThreadSafe(&test_allocator, 1) != 0)
+    {
+        printf("test_record: setup failed\n");
+        return 1;
+    }
+
+    (void)close(fd);
+    (void)pthread_barrier_init(&test_barrier, NULL, 2u);
+
+    /* Start Function Logic */
+    if (MEM_recordStart(path) != 0 || pthread_create(&worker, NULL, TEST_worker, NULL) != 0)
+    {
+        printf("test_record: failed to start the recording or the worker\n");
+        (void)unlink(path);
+        return 1;
+    }
+
+    (void)pthread_barrier_wait(&test_barrier);
+
+    if (MEM_recordStop() != 0)
+    {
+        printf("test_record: MEM_recordStop failed\n");
+        ret = 1;
+    }
+
+    (void)pthread_barrier_wait(&test_barrier);
+    (void)pthread_join(worker, &failed);
+
+    if (failed != NULL)
+    {
+        printf("test_record: the worker failed to allocate\n");
+        ret = 1;
+    }
+
+    ret |= TEST_countMallocs(path, &mallocs);
+
+    if (mallocs != TEST_RECORD_COUNT)
+    {
+        printf("test_record: the recording holds %zu allocations of the running worker, expected %u\n", mallocs, TEST_RECORD_COUNT);
+        ret = 1;
+    }
+
+    (void)unlink(path);
+    (void)pthread_barrier_destroy(&test_barrier);
+    (void)MEM_allocatorDestroy(&test_allocator);
+
+    MEM_logSetHook(MEM_logStdio, NULL);
+
+    if (ret == 0)
+    {
+        printf("test_record: all checks passed\n");
+    }
+
+    /* Function Return */
+    return ret;
+}
+
+/*** end of file ***/